@@ -0,0 +1,192 @@
+/*!
+ * \file
+ * \brief This module provides all-pairs shortest paths on small dense Graph,
+ * with a cache-blocked Floyd–Warshall algorithm.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <limits>
+
+#include "apsp.hpp"
+#include "parallel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define APSP_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/*!
+ * Min-plus update of a row of a tile: for each \c j,
+ * \c c[j] = min(c[j], a + b[j]), with \c n[j] set to \c hop where improved.
+ * \param c,n row of the tile updated (distances and next hops).
+ * \param b row of distances through the intermediate vertex.
+ * \param a distance to the intermediate vertex.
+ * \param hop next hop to the intermediate vertex.
+ */
+void relax_row_scalar(float *c, unsigned int *n, float const *b, float a,
+                      unsigned int hop) {
+  for (unsigned int j = 0; j < All_Pairs::tile_size; j++) {
+    float const candidate = a + b[j];
+    if (candidate < c[j]) {
+      c[j] = candidate;
+      n[j] = hop;
+    }
+  }
+}
+
+#ifdef APSP_AVX2
+/*! Same as relax_row_scalar, 8 columns at a time. */
+__attribute__((target("avx2"))) void
+relax_row_avx2(float *c, unsigned int *n, float const *b, float a,
+               unsigned int hop) {
+  __m256 const va = _mm256_set1_ps(a);
+  __m256i const vhop = _mm256_set1_epi32(hop);
+  for (unsigned int j = 0; j < All_Pairs::tile_size; j += 8) {
+    __m256 const vc = _mm256_loadu_ps(c + j);
+    __m256 const candidate = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+    __m256 const better = _mm256_cmp_ps(candidate, vc, _CMP_LT_OQ);
+    _mm256_storeu_ps(c + j, _mm256_blendv_ps(vc, candidate, better));
+    __m256i *const vn = reinterpret_cast<__m256i *>(n + j);
+    _mm256_storeu_si256(vn, _mm256_blendv_epi8(_mm256_loadu_si256(vn), vhop,
+                                               _mm256_castps_si256(better)));
+  }
+}
+#endif
+
+/*! Type of the row updates. */
+typedef void (*Relax_Row)(float *, unsigned int *, float const *, float,
+                          unsigned int);
+
+/*! \return the row update to use, according to the processor. */
+Relax_Row pick_relax_row() {
+#ifdef APSP_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return relax_row_avx2;
+  }
+#endif
+  return relax_row_scalar;
+}
+
+/*! Row update used, chosen once. */
+Relax_Row const relax_row = pick_relax_row();
+}
+
+All_Pairs::All_Pairs(Graph const &g, unsigned int _nbr_workers)
+    : nbr_vertices(g.nbr_vertices),
+      stride((g.nbr_vertices + tile_size - 1) / tile_size * tile_size),
+      distances(new float[size_t(stride) * stride]),
+      next_hops(new unsigned int[size_t(stride) * stride]),
+      nbr_workers(_nbr_workers), is_negative_cycle(false), round(0) {
+  assert(0 < nbr_workers);
+  // INITIAL MATRICES: the edges
+  float const infinity = numeric_limits<float>::infinity();
+  for (unsigned int i = 0; i < stride; i++) {
+    for (unsigned int j = 0; j < stride; j++) {
+      distances[size_t(i) * stride + j] = (i == j) ? 0 : infinity;
+      next_hops[size_t(i) * stride + j] = (i == j) ? i : j;
+    }
+  }
+  for (unsigned int i = 0; i < nbr_vertices; i++) {
+    Graph::VEdge const &edges = g.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      float &d = distances[size_t(i) * stride + edges[k].first];
+      if (edges[k].second < d) {
+        d = edges[k].second;
+      }
+    }
+  }
+
+  // FLOYD–WARSHALL BY TILES
+  unsigned int const nbr_tiles = stride / tile_size;
+  for (round = 0; round < nbr_tiles; round++) {
+    // the diagonal tile only depends on itself
+    update_tile(round, round, round);
+    // the tiles of row and column round depend on it
+    run_parallel(nbr_workers, update_cross, this);
+    // the others depend on row and column round
+    run_parallel(nbr_workers, update_others, this);
+  }
+
+  // NEGATIVE CYCLE: a vertex on it ends at a negative distance from itself
+  for (unsigned int i = 0; i < nbr_vertices; i++) {
+    if (distances[size_t(i) * stride + i] < 0) {
+      is_negative_cycle = true;
+      break;
+    }
+  }
+}
+
+void All_Pairs::update_cross(unsigned int worker, unsigned int nbr_workers,
+                             void *context) {
+  All_Pairs &ap = *static_cast<All_Pairs *>(context);
+  unsigned int const tk = ap.round;
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, ap.stride / tile_size, first, last);
+  for (unsigned int t = first; t < last; t++) {
+    if (t != tk) {
+      ap.update_tile(tk, t, tk);
+      ap.update_tile(t, tk, tk);
+    }
+  }
+}
+
+void All_Pairs::update_others(unsigned int worker, unsigned int nbr_workers,
+                              void *context) {
+  All_Pairs &ap = *static_cast<All_Pairs *>(context);
+  unsigned int const tk = ap.round;
+  unsigned int const nbr_tiles = ap.stride / tile_size;
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, nbr_tiles, first, last);
+  for (unsigned int ti = first; ti < last; ti++) {
+    for (unsigned int tj = 0; tj < nbr_tiles; tj++) {
+      if (ti != tk && tj != tk) {
+        ap.update_tile(ti, tj, tk);
+      }
+    }
+  }
+}
+
+All_Pairs::~All_Pairs() {
+  delete[] distances;
+  delete[] next_hops;
+}
+
+void All_Pairs::update_tile(unsigned int ti, unsigned int tj,
+                            unsigned int tk) {
+  unsigned int const i0 = ti * tile_size;
+  unsigned int const j0 = tj * tile_size;
+  unsigned int const k0 = tk * tile_size;
+  for (unsigned int k = k0; k < k0 + tile_size; k++) {
+    float const *const b = distances + size_t(k) * stride + j0;
+    for (unsigned int i = i0; i < i0 + tile_size; i++) {
+      size_t const row = size_t(i) * stride;
+      float const a = distances[row + k];
+      if (a == numeric_limits<float>::infinity()) {
+        continue;
+      }
+      relax_row(distances + row + j0, next_hops + row + j0, b, a,
+                next_hops[row + k]);
+    }
+  }
+}
+
+bool All_Pairs::get_path(unsigned int i, unsigned int j,
+                         vector<unsigned int> &path) const {
+  path.clear();
+  if (get_distance(i, j) == numeric_limits<float>::infinity()) {
+    return false;
+  }
+  path.push_back(i);
+  while (i != j) {
+    i = get_next_hop(i, j);
+    path.push_back(i);
+  }
+  return true;
+}
@@ -0,0 +1,158 @@
+#ifndef __APSP_HPP_
+#define __APSP_HPP_
+
+/*!
+ * \file
+ * \brief This module provides all-pairs shortest paths on small dense Graph,
+ * with a cache-blocked Floyd–Warshall algorithm.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+/*!
+ * \brief Distances and next hops between all the pairs of vertices of a
+ * Graph.
+ *
+ * Once computed, distances and next hops are read in constant time, and a
+ * path in time proportional to its number of edges.
+ *
+ * Implementation:
+ * \li square matrices, stored by row, with rows padded to a multiple of the
+ * tile size (padding cells are at infinite distance);
+ * \li Floyd–Warshall by tiles, so that the three tiles being combined stay in
+ * the cache; the innermost loop (a min-plus update of a tile row) uses AVX2
+ * when the processor has it;
+ * \li for each tile row/column \c tk, the tiles of row and column \c tk,
+ * then all the other tiles, only depend on tiles already done: each of these
+ * two phases is split across workers (see run_parallel).
+ *
+ * Memory is quadratic in the number of vertices: this is meant for graphs of
+ * at most a few thousand vertices.
+ *
+ * On a directed graph with negative lengths, a cycle of negative length is
+ * detected after the sweep (a vertex at negative distance from itself): the
+ * distances are then meaningless.
+ */
+class All_Pairs {
+
+public:
+  /*! Number of vertices. */
+  unsigned int const nbr_vertices;
+
+  /*! Size of the (square) tiles. */
+  static unsigned int const tile_size = 64;
+
+  /*! Length of the rows of the matrices: \c nbr_vertices rounded up to a
+   * multiple of \c tile_size. */
+  unsigned int const stride;
+
+private:
+  /*! Matrix of the distances. */
+  float *const distances;
+
+  /*! Matrix of the next hops: vertex following \c i on a shortest path from
+   * \c i to \c j (\c j itself for an edge, \c i for itself). */
+  unsigned int *const next_hops;
+
+  /*! Number of workers of the computation. */
+  unsigned int const nbr_workers;
+
+  /*! Whether there is a cycle of negative length. */
+  bool is_negative_cycle;
+
+  /*! Tile row/column of the current Floyd–Warshall round. */
+  unsigned int round;
+
+  /*!
+   * Update the tile at (\c ti, \c tj) with the paths going through the
+   * vertices of tile row/column \c tk.
+   */
+  void update_tile(unsigned int ti, unsigned int tj, unsigned int tk);
+
+  /*!
+   * Update a slice of the tiles of row and column \c round.
+   * \param worker worker number.
+   * \param nbr_workers number of workers.
+   * \param context the All_Pairs.
+   */
+  static void update_cross(unsigned int worker, unsigned int nbr_workers,
+                           void *context);
+
+  /*!
+   * Update the tiles of a slice of the tile rows, but those of row and
+   * column \c round.
+   * \param worker worker number.
+   * \param nbr_workers number of workers.
+   * \param context the All_Pairs.
+   */
+  static void update_others(unsigned int worker, unsigned int nbr_workers,
+                            void *context);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Compute all the shortest paths of a graph.
+   * \param g graph.
+   * \param _nbr_workers number of workers (1 runs in the calling thread).
+   * \pre \c _nbr_workers is at least 1.
+   */
+  All_Pairs(Graph const &g, unsigned int _nbr_workers = 1);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the matrices. */
+  ~All_Pairs();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*! \return true iff the graph has a cycle of negative length (then there
+   * is no shortest path). */
+  bool has_negative_cycle() const { return is_negative_cycle; }
+
+  /*!
+   * \param i,j vertices.
+   * \pre \c i and \c j are legal vertex numbers.
+   * \return the distance from \c i to \c j (infinity if unreachable).
+   */
+  float get_distance(unsigned int i, unsigned int j) const {
+    assert(i < nbr_vertices);
+    assert(j < nbr_vertices);
+    return distances[size_t(i) * stride + j];
+  }
+
+  /*!
+   * \param i,j vertices.
+   * \pre \c i and \c j are legal vertex numbers, \c j is reachable from \c i.
+   * \return the vertex following \c i on a shortest path to \c j.
+   */
+  unsigned int get_next_hop(unsigned int i, unsigned int j) const {
+    assert(i < nbr_vertices);
+    assert(j < nbr_vertices);
+    return next_hops[size_t(i) * stride + j];
+  }
+
+  /*!
+   * \param i,j endpoints of the path.
+   * \param path filled with the vertices of a shortest path from \c i to
+   * \c j.
+   * \pre \c i and \c j are legal vertex numbers, there is no negative
+   * cycle.
+   * \return false (and leave \c path empty) iff \c j is not reachable.
+   */
+  bool get_path(unsigned int i, unsigned int j,
+                std::vector<unsigned int> &path) const;
+};
+
+#endif
@@ -0,0 +1,357 @@
+/*!
+ * \file
+ * \brief Batch query driver: computes the shortest distance of every pair of
+ * vertices of a query file, using every core.
+ *
+ * Usage:
+ * \verbatim ./batch_query <graph file> <query file> <output file> [<nbr workers>] \endverbatim
+ * The graph file is in the format of Graph::read.
+ *
+ * The query file is either:
+ * \li text, if its name ends with \c .csv : one \c from,to pair per line;
+ * \li binary, otherwise: pairs of \c uint32 (from, to) in host byte order.
+ *
+ * The output file is made of fixed-width records (host byte order), one per
+ * query and in the order of the queries:
+ * \li \c uint32 from, \c uint32 to,
+ * \li \c float distance (infinity if unreachable),
+ * \li \c uint32 number of edges of the path (0 if unreachable).
+ *
+ * A text query file is parsed into an array of queries before any search
+ * starts: the array takes 8 bytes per query, on top of the mapped text
+ * until it is parsed. Convert large batches to the binary format, which is
+ * searched in place.
+ *
+ * The output file is memory-mapped and shared by the workers, which are
+ * processes forked after loading the graph, each one with its own search
+ * workspace. The queries are dealt to the workers by blocks. If all the edges
+ * have the same length, a breadth-first search (Bfs) replaces Dijkstra's
+ * algorithm.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bfs.hpp"
+#include "dijkstra.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! A query, as in the binary query file. */
+struct Query {
+  uint32_t from;
+  uint32_t to;
+};
+
+/*! A result, as in the output file. */
+struct Record {
+  uint32_t from;
+  uint32_t to;
+  float distance;
+  uint32_t nbr_edges;
+};
+
+/*! Number of consecutive queries dealt to a worker at once. */
+size_t const block_size = 1024;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*!
+ * Map a whole file in memory, read only.
+ * \param path file name.
+ * \param data filled with the mapping (to be unmapped by the caller), or
+ * \c NULL if the file is empty.
+ * \param size filled with the size of the file.
+ * \return false iff the file cannot be mapped.
+ */
+bool map_file(char const *path, char const *&data, size_t &size) {
+  int const fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  bool success = false;
+  data = NULL;
+  size = 0;
+  if (fstat(fd, &st) == 0) {
+    size = st.st_size;
+    success = true;
+    if (0 < size) {
+      void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      success = mapping != MAP_FAILED;
+      data = success ? static_cast<char const *>(mapping) : NULL;
+    }
+  }
+  close(fd);
+  return success;
+}
+
+/*!
+ * Parse an unsigned decimal number.
+ * \param p first character, updated to the one following the number.
+ * \param end end of the text (the mapping may not be followed by a '\0').
+ * \param value filled with the number.
+ * \return false iff there is no digit at \c p or the number does not fit in
+ * a \c uint32.
+ */
+bool parse_uint(char const *&p, char const *end, uint32_t &value) {
+  if (end <= p || *p < '0' || '9' < *p) {
+    return false;
+  }
+  uint64_t number = 0;
+  while (p < end && '0' <= *p && *p <= '9') {
+    number = 10 * number + (*p - '0');
+    if (numeric_limits<uint32_t>::max() < number) {
+      return false;
+    }
+    p++;
+  }
+  value = number;
+  return true;
+}
+
+/*!
+ * Parse a text query file.
+ * \param text content of the file.
+ * \param size size of the content.
+ * \param queries filled with the queries.
+ * \return false iff the text is not made of \c from,to lines.
+ */
+bool parse_csv(char const *text, size_t size, vector<Query> &queries) {
+  char const *const end = text + size;
+  char const *p = text;
+  while (p < end) {
+    if (*p == '\n' || *p == '\r' || *p == ' ') {
+      p++;
+      continue;
+    }
+    Query q;
+    if (!parse_uint(p, end, q.from) || end <= p || *p != ',' ||
+        !parse_uint(++p, end, q.to)) {
+      return false;
+    }
+    queries.push_back(q);
+  }
+  return true;
+}
+
+/*!
+ * Answer the queries of the blocks dealt to a worker.
+ * \param graph graph to search.
+ * \param queries all the queries.
+ * \param nbr_queries number of queries.
+ * \param records output records, one per query.
+ * \param worker worker number.
+ * \param nbr_workers number of workers.
+ */
+void run_worker(Graph const &graph, Query const *queries, size_t nbr_queries,
+                Record *records, unsigned int worker,
+                unsigned int nbr_workers) {
+  Dijkstra search(graph);
+  // Fewest edges are shortest when all the edges have the same length
+  bool const is_bfs = graph.has_common_length();
+  Bfs bfs(graph);
+  vector<unsigned int> path;
+  for (size_t b = worker * block_size; b < nbr_queries;
+       b += nbr_workers * block_size) {
+    size_t const b_end = min(b + block_size, nbr_queries);
+    for (size_t k = b; k < b_end; k++) {
+      Record &r = records[k];
+      r.from = queries[k].from;
+      r.to = queries[k].to;
+      if (is_bfs) {
+        bfs.run(r.from, r.to);
+        unsigned int const hops = bfs.get_hops(r.to);
+        r.distance = (hops == Bfs::unreached)
+                         ? numeric_limits<float>::infinity()
+                         : hops * graph.get_common_length();
+        r.nbr_edges = (hops == Bfs::unreached) ? 0 : hops;
+      } else {
+        r.distance = search.shortest_distance(r.from, r.to);
+        r.nbr_edges = search.get_path(r.to, path) ? path.size() - 1 : 0;
+      }
+    }
+  }
+}
+
+/*! What a run holds, released by release() whatever the outcome. */
+struct Resources {
+  Graph *graph;
+  char const *input;
+  size_t input_size;
+  int output_fd;
+  Record *records;
+  size_t output_size;
+};
+
+/*! Release what a run holds. */
+void release(Resources &r) {
+  if (r.records != NULL) {
+    munmap(r.records, r.output_size);
+  }
+  if (0 <= r.output_fd) {
+    close(r.output_fd);
+  }
+  if (r.input != NULL) {
+    munmap(const_cast<char *>(r.input), r.input_size);
+  }
+  delete r.graph;
+}
+
+/*!
+ * Load the graph and the queries, then answer the queries with forked
+ * workers.
+ * \param argv arguments of the program.
+ * \param nbr_workers number of workers.
+ * \param r filled with what the run holds, to be released by the caller.
+ * \return the exit status of the program.
+ */
+int run(char **argv, int nbr_workers, Resources &r) {
+  // LOAD THE GRAPH
+  ifstream file(argv[1]);
+  r.graph = Graph::read(file);
+  if (r.graph == NULL) {
+    cerr << "cannot read a graph from " << argv[1] << endl;
+    return 1;
+  }
+  Graph const &graph = *r.graph;
+
+  // LOAD THE QUERIES
+  if (!map_file(argv[2], r.input, r.input_size)) {
+    cerr << "cannot map " << argv[2] << endl;
+    return 1;
+  }
+  size_t const name_length = strlen(argv[2]);
+  bool const is_csv =
+      4 <= name_length && strcmp(argv[2] + name_length - 4, ".csv") == 0;
+  vector<Query> parsed;
+  Query const *queries;
+  size_t nbr_queries;
+  if (is_csv) {
+    if (!parse_csv(r.input, r.input_size, parsed)) {
+      cerr << argv[2] << " is not made of from,to lines" << endl;
+      return 1;
+    }
+    // The text is not needed any more
+    if (r.input != NULL) {
+      munmap(const_cast<char *>(r.input), r.input_size);
+      r.input = NULL;
+    }
+    queries = parsed.empty() ? NULL : &parsed[0];
+    nbr_queries = parsed.size();
+  } else {
+    if (r.input_size % sizeof(Query) != 0) {
+      cerr << argv[2] << " is not made of pairs of uint32" << endl;
+      return 1;
+    }
+    // The mapping is page aligned, so suitably aligned for Query
+    queries = reinterpret_cast<Query const *>(r.input);
+    nbr_queries = r.input_size / sizeof(Query);
+  }
+  for (size_t k = 0; k < nbr_queries; k++) {
+    if (graph.nbr_vertices <= queries[k].from ||
+        graph.nbr_vertices <= queries[k].to) {
+      cerr << "query " << k << " is not on legal vertices" << endl;
+      return 1;
+    }
+  }
+
+  // OUTPUT FILE
+  r.output_size = nbr_queries * sizeof(Record);
+  r.output_fd = open(argv[3], O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (r.output_fd < 0 || ftruncate(r.output_fd, r.output_size) < 0) {
+    perror(argv[3]);
+    return 1;
+  }
+  if (0 < r.output_size) {
+    void *data = mmap(NULL, r.output_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, r.output_fd, 0);
+    if (data == MAP_FAILED) {
+      perror(argv[3]);
+      return 1;
+    }
+    r.records = static_cast<Record *>(data);
+  }
+
+  // WORKERS
+  double const start = now_s();
+  vector<pid_t> workers;
+  bool success = true;
+  for (int k = 0; success && k < nbr_workers; k++) {
+    pid_t const pid = fork();
+    if (pid == 0) {
+      run_worker(graph, queries, nbr_queries, r.records, k, nbr_workers);
+      _exit(0);
+    }
+    if (pid < 0) {
+      perror("fork");
+      success = false;
+    } else {
+      workers.push_back(pid);
+    }
+  }
+  // A partial run is useless: stop the workers started, but wait for them
+  // all so that none writes in the output once the program is over
+  for (size_t k = 0; !success && k < workers.size(); k++) {
+    kill(workers[k], SIGTERM);
+  }
+  for (size_t k = 0; k < workers.size(); k++) {
+    int status;
+    waitpid(workers[k], &status, 0);
+    success = success && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+  double const duration = now_s() - start;
+  if (!success) {
+    cerr << "a worker failed" << endl;
+    return 1;
+  }
+  cerr << nbr_queries << " queries in " << duration << " s with "
+       << nbr_workers << " workers (" << nbr_queries / duration << " QPS)"
+       << endl;
+  return 0;
+}
+}
+
+int main(int argc, char **argv) {
+  if (argc < 4 || 5 < argc) {
+    cerr << "usage: " << argv[0]
+         << " <graph file> <query file> <output file> [<nbr workers>]"
+         << endl;
+    return 1;
+  }
+  long const nbr_cores = sysconf(_SC_NPROCESSORS_ONLN);
+  int const nbr_workers =
+      (argc == 5) ? atoi(argv[4]) : (0 < nbr_cores ? nbr_cores : 1);
+  if (nbr_workers < 1) {
+    cerr << "the number of workers must be positive" << endl;
+    return 1;
+  }
+  Resources r = {NULL, NULL, 0, -1, NULL, 0};
+  int const status = run(argv, nbr_workers, r);
+  release(r);
+  return status;
+}
@@ -0,0 +1,121 @@
+/*!
+ * \file
+ * \brief Benchmark: Dijkstra's algorithm, one-to-all and point-to-point
+ * queries on random graphs.
+ *
+ * The graphs are grids with random lengths plus random long range edges,
+ * with vertex numbers shuffled so that neighbours are far apart in memory
+ * (as in graphs read from files).
+ *
+ * The last graphs have vertices of high degree: hubs added to a grid, and a
+ * dense random graph.
+ *
+ * To see the effect of the prefetching of the relaxation, or of the batch
+ * relaxation of the hubs, compare with a build defining DIJKSTRA_NO_PREFETCH
+ * or DIJKSTRA_NO_BATCH_RELAX, and read the cache misses with
+ * \verbatim perf stat -e cycles,cache-misses,L1-dcache-load-misses ./bench_dijkstra \endverbatim
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // random_shuffle
+#include <iostream>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "dijkstra.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Number of queries timed per graph and kind. */
+unsigned int const nbr_queries = 16;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*! \return a random length in ]0, 100]. */
+float random_length() { return 1 + rand() % 10000 / 100.0f; }
+
+/*! \return a random number in [0, n[ (for random_shuffle). */
+ptrdiff_t random_below(ptrdiff_t n) { return rand() % n; }
+
+/*!
+ * Build a random graph: a \c side x \c side grid plus \c nbr_extra random
+ * edges, with shuffled vertex numbers. The extra edges have one end among the
+ * \c nbr_hubs first vertices, if not 0.
+ * \return the graph, to be deleted by the caller.
+ */
+Graph *random_graph(unsigned int side, unsigned int nbr_extra,
+                    unsigned int nbr_hubs) {
+  unsigned int const n = side * side;
+  vector<unsigned int> number(n);
+  for (unsigned int i = 0; i < n; i++) {
+    number[i] = i;
+  }
+  random_shuffle(number.begin(), number.end(), random_below);
+  Graph *g = new Graph(n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % side + 1 < side) {
+      g->add_edge(number[i], number[i + 1], random_length());
+    }
+    if (i + side < n) {
+      g->add_edge(number[i], number[i + side], random_length());
+    }
+  }
+  for (unsigned int k = 0; k < nbr_extra; k++) {
+    g->add_edge(rand() % (nbr_hubs == 0 ? n : nbr_hubs), rand() % n,
+                random_length());
+  }
+  return g;
+}
+
+/*!
+ * Time queries on \c g.
+ * \param g graph.
+ * \param title printed before the times.
+ */
+void run(Graph const &g, char const *title) {
+  Dijkstra search(g);
+  double start = now_s();
+  for (unsigned int k = 0; k < nbr_queries; k++) {
+    search.one_to_all(rand() % g.nbr_vertices);
+  }
+  double const one_to_all_s = (now_s() - start) / nbr_queries;
+
+  start = now_s();
+  for (unsigned int k = 0; k < nbr_queries; k++) {
+    search.shortest_distance(rand() % g.nbr_vertices,
+                             rand() % g.nbr_vertices);
+  }
+  double const point_to_point_s = (now_s() - start) / nbr_queries;
+
+  cout << g.nbr_vertices << " vertices" << title << ": one to all "
+       << one_to_all_s << " s, point to point " << point_to_point_s << " s"
+       << endl;
+}
+}
+
+int main() {
+  srand(2016);
+  unsigned int const sides[] = {100, 300, 1000};
+  for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+    Graph *g = random_graph(sides[s], sides[s] * sides[s] / 10, 0);
+    run(*g, "");
+    delete g;
+  }
+  Graph *g = random_graph(300, 300 * 300, 100);
+  run(*g, " with 100 hubs");
+  delete g;
+  g = random_graph(100, 100 * 100 * 50, 0);
+  run(*g, " of degree 100");
+  delete g;
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*!
+ * \file
+ * \brief Benchmark: Prim's against Borůvka's algorithm (on one thread and on
+ * every core) on random graphs.
+ *
+ * The graphs are grids with random lengths plus random long range edges.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <iostream>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "mst.hpp"
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*! \return a random length in ]0, 100]. */
+float random_length() { return 1 + rand() % 10000 / 100.0f; }
+
+/*!
+ * Build a random graph: a \c side x \c side grid plus \c nbr_extra random
+ * edges.
+ * \return the graph, to be deleted by the caller.
+ */
+Graph *random_graph(unsigned int side, unsigned int nbr_extra) {
+  unsigned int const n = side * side;
+  Graph *g = new Graph(n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % side + 1 < side) {
+      g->add_edge(i, i + 1, random_length());
+    }
+    if (i + side < n) {
+      g->add_edge(i, i + side, random_length());
+    }
+  }
+  for (unsigned int k = 0; k < nbr_extra; k++) {
+    g->add_edge(rand() % n, rand() % n, random_length());
+  }
+  return g;
+}
+}
+
+int main() {
+  srand(2016);
+  unsigned int const sides[] = {100, 300, 1000};
+  for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+    Graph *g = random_graph(sides[s], sides[s] * sides[s]);
+    Spanning_Tree tree;
+
+    double start = now_s();
+    prim(*g, tree);
+    double const prim_s = now_s() - start;
+    double const prim_total = tree.total_length;
+
+    start = now_s();
+    boruvka(*g, tree);
+    double const boruvka_s = now_s() - start;
+
+    unsigned int const nbr_cores = get_nbr_cores();
+    start = now_s();
+    boruvka(*g, tree, nbr_cores);
+    double const parallel_s = now_s() - start;
+
+    cout << g->nbr_vertices << " vertices: prim " << prim_s << " s, boruvka "
+         << boruvka_s << " s, boruvka on " << nbr_cores << " threads "
+         << parallel_s << " s, total " << prim_total << " / "
+         << tree.total_length << endl;
+    delete g;
+  }
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*!
+ * \file
+ * \brief Benchmark: one-to-all searches one source at a time against
+ * several sources at once (Lane_Dijkstra, Bit_Parallel_Bfs).
+ *
+ * The graph is a grid with random lengths plus random long range edges. The
+ * sources are either spread at random or close to one another (the vertices
+ * of a small square, as for the origins of an accessibility study): the
+ * searches share more work when the sources are close.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <iostream>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "bfs.hpp"
+#include "multi_source.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Number of one-to-all queries timed. */
+unsigned int const nbr_sources = 64;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*! \return a random length in ]0, 100]. */
+float random_length() { return 1 + rand() % 10000 / 100.0f; }
+
+/*!
+ * Build a random graph: a \c side x \c side grid plus \c nbr_extra random
+ * edges.
+ * \return the graph, to be deleted by the caller.
+ */
+Graph *random_graph(unsigned int side, unsigned int nbr_extra) {
+  unsigned int const n = side * side;
+  Graph *g = new Graph(n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % side + 1 < side) {
+      g->add_edge(i, i + 1, random_length());
+    }
+    if (i + side < n) {
+      g->add_edge(i, i + side, random_length());
+    }
+  }
+  for (unsigned int k = 0; k < nbr_extra; k++) {
+    g->add_edge(rand() % n, rand() % n, random_length());
+  }
+  return g;
+}
+
+/*!
+ * Time the searches from \c sources.
+ * \param g graph.
+ * \param sources nbr_sources sources.
+ * \param title printed before the times.
+ */
+void run(Graph const &g, vector<unsigned int> const &sources,
+         char const *title) {
+  Dijkstra search(g);
+  double start = now_s();
+  for (unsigned int k = 0; k < nbr_sources; k++) {
+    search.one_to_all(sources[k]);
+  }
+  double const dijkstra_s = (now_s() - start) / nbr_sources;
+
+  Lane_Dijkstra lanes(g);
+  unsigned long nbr_treated = 0;
+  start = now_s();
+  for (unsigned int k = 0; k < nbr_sources; k += Lane_Dijkstra::nbr_lanes) {
+    lanes.run(vector<unsigned int>(sources.begin() + k,
+                                   sources.begin() + k +
+                                       Lane_Dijkstra::nbr_lanes));
+    nbr_treated += lanes.get_nbr_treated();
+  }
+  double const lanes_s = (now_s() - start) / nbr_sources;
+
+  Bfs bfs(g);
+  start = now_s();
+  for (unsigned int k = 0; k < nbr_sources; k++) {
+    bfs.run(sources[k], g.nbr_vertices);
+  }
+  double const bfs_s = (now_s() - start) / nbr_sources;
+
+  Bit_Parallel_Bfs bits(g);
+  start = now_s();
+  for (unsigned int k = 0; k < nbr_sources; k += Bit_Parallel_Bfs::nbr_lanes) {
+    bits.run(vector<unsigned int>(sources.begin() + k,
+                                  sources.begin() + k +
+                                      Bit_Parallel_Bfs::nbr_lanes));
+  }
+  double const bits_s = (now_s() - start) / nbr_sources;
+
+  cout << title << ", per source: dijkstra " << dijkstra_s << " s, "
+       << Lane_Dijkstra::nbr_lanes << " lanes " << lanes_s << " s ("
+       << double(nbr_treated) / nbr_sources / g.nbr_vertices
+       << " treatments per vertex), bfs " << bfs_s << " s, "
+       << Bit_Parallel_Bfs::nbr_lanes << " bits " << bits_s << " s" << endl;
+}
+}
+
+int main() {
+  srand(2016);
+  unsigned int const side = 300;
+  Graph *g = random_graph(side, side * side / 100);
+  vector<unsigned int> spread;
+  for (unsigned int k = 0; k < nbr_sources; k++) {
+    spread.push_back(rand() % g->nbr_vertices);
+  }
+  run(*g, spread, "spread sources");
+
+  // squares of 8 x 4 vertices, one per 32 sources
+  vector<unsigned int> close;
+  while (close.size() < nbr_sources) {
+    unsigned int const corner =
+        rand() % (side - 8) + side * (rand() % (side - 4));
+    for (unsigned int k = 0; k < 32; k++) {
+      close.push_back(corner + k % 8 + side * (k / 8));
+    }
+  }
+  run(*g, close, "close sources");
+  delete g;
+  return 0;
+}
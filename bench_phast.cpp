@@ -0,0 +1,98 @@
+/*!
+ * \file
+ * \brief Benchmark: one-to-all distances with Dijkstra's algorithm against
+ * PHAST, one source or nbr_lanes sources at a time.
+ *
+ * The graphs are grids with random lengths.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <iostream>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "dijkstra.hpp"
+#include "phast.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Number of one-to-all queries timed per graph. */
+unsigned int const nbr_sources = 64;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*! \return a random length in ]0, 100]. */
+float random_length() { return 1 + rand() % 10000 / 100.0f; }
+
+/*!
+ * Build a random \c side x \c side grid.
+ * \return the graph, to be deleted by the caller.
+ */
+Graph *random_grid(unsigned int side) {
+  unsigned int const n = side * side;
+  Graph *g = new Graph(n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % side + 1 < side) {
+      g->add_edge(i, i + 1, random_length());
+    }
+    if (i + side < n) {
+      g->add_edge(i, i + side, random_length());
+    }
+  }
+  return g;
+}
+}
+
+int main() {
+  srand(2016);
+  unsigned int const sides[] = {100, 300};
+  for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+    Graph *g = random_grid(sides[s]);
+    vector<unsigned int> sources;
+    for (unsigned int k = 0; k < nbr_sources; k++) {
+      sources.push_back(rand() % g->nbr_vertices);
+    }
+
+    double start = now_s();
+    Contraction_Hierarchy ch(*g);
+    double const ch_s = now_s() - start;
+
+    Dijkstra search(*g);
+    start = now_s();
+    for (unsigned int k = 0; k < nbr_sources; k++) {
+      search.one_to_all(sources[k]);
+    }
+    double const dijkstra_s = (now_s() - start) / nbr_sources;
+
+    Phast phast(ch);
+    start = now_s();
+    for (unsigned int k = 0; k < nbr_sources; k++) {
+      phast.one_to_all(sources[k]);
+    }
+    double const phast_s = (now_s() - start) / nbr_sources;
+
+    start = now_s();
+    for (unsigned int k = 0; k < nbr_sources; k += Phast::nbr_lanes) {
+      phast.many_to_all(vector<unsigned int>(
+          sources.begin() + k, sources.begin() + k + Phast::nbr_lanes));
+    }
+    double const lanes_s = (now_s() - start) / nbr_sources;
+
+    cout << g->nbr_vertices << " vertices: hierarchy " << ch_s << " s ("
+         << ch.get_nbr_shortcuts() << " shortcuts), per tree: dijkstra "
+         << dijkstra_s << " s, phast " << phast_s << " s, phast "
+         << Phast::nbr_lanes << " lanes " << lanes_s << " s" << endl;
+    delete g;
+  }
+  return 0;
+}
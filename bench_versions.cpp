@@ -0,0 +1,171 @@
+/*!
+ * \file
+ * \brief Benchmark: versions of a graph, the cost of an update and the
+ * throughput of the readers while a writer updates.
+ *
+ * An update copies the whole graph (see Graph_Versions), so its cost grows
+ * with the graph while the number of edges changed stays one. The readers
+ * run point-to-point queries on the pinned version, first alone, then while
+ * a writer publishes an update every \c update_period_us microseconds.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <iostream>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dijkstra.hpp"
+#include "versions.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Number of updates timed per graph. */
+unsigned int const nbr_updates = 16;
+
+/*! Time the readers run, in seconds. */
+double const read_s = 1.0;
+
+/*! Time between two updates of the writer, in microseconds. */
+unsigned int const update_period_us = 10000;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*! \return a random length in ]0, 100]. */
+float random_length() { return 1 + rand() % 10000 / 100.0f; }
+
+/*!
+ * Build a \c side x \c side grid with random lengths.
+ * \return the graph, to be deleted by the caller.
+ */
+Graph *random_grid(unsigned int side) {
+  unsigned int const n = side * side;
+  Graph *g = new Graph(n);
+  for (unsigned int i = 0; i < n; i++) {
+    if (i % side + 1 < side) {
+      g->add_edge(i, i + 1, random_length());
+    }
+    if (i + side < n) {
+      g->add_edge(i, i + side, random_length());
+    }
+  }
+  return g;
+}
+
+/*! Shared state of the reader and the writer. */
+struct Run_State {
+  Graph_Versions *versions;
+  /*! Set when the run is over. */
+  int volatile is_done;
+  unsigned long nbr_queries;
+  unsigned long nbr_updates;
+};
+
+/*! Query the pinned versions till the run is over. */
+void *read_versions(void *context) {
+  Run_State &state = *static_cast<Run_State *>(context);
+  unsigned int const reader = state.versions->add_reader();
+  unsigned int seed = 2016;
+  Dijkstra *search = NULL;
+  unsigned long number = 0;
+  while (!__atomic_load_n(&state.is_done, __ATOMIC_SEQ_CST)) {
+    Graph_Versions::Version const &v = state.versions->pin(reader);
+    if (v.number != number) {
+      delete search;
+      search = new Dijkstra(*v.graph);
+      number = v.number;
+    }
+    search->shortest_distance(rand_r(&seed) % v.graph->nbr_vertices,
+                              rand_r(&seed) % v.graph->nbr_vertices);
+    state.versions->unpin(reader);
+    state.nbr_queries++;
+  }
+  delete search;
+  state.versions->remove_reader(reader);
+  return NULL;
+}
+
+/*! Publish an update every period till the run is over. */
+void *write_versions(void *context) {
+  Run_State &state = *static_cast<Run_State *>(context);
+  while (!__atomic_load_n(&state.is_done, __ATOMIC_SEQ_CST)) {
+    Graph *const g = state.versions->begin_update();
+    g->add_edge(rand() % g->nbr_vertices, rand() % g->nbr_vertices,
+                random_length());
+    state.versions->publish(g);
+    state.nbr_updates++;
+    usleep(update_period_us);
+  }
+  return NULL;
+}
+
+/*!
+ * Run a reader, and a writer if asked, for \c read_s seconds.
+ * \return the number of queries per second of the reader.
+ */
+double read_throughput(Graph_Versions &versions, bool with_writer,
+                       unsigned long &nbr_updates) {
+  Run_State state;
+  state.versions = &versions;
+  state.is_done = 0;
+  state.nbr_queries = 0;
+  state.nbr_updates = 0;
+  pthread_t reader, writer;
+  double const start = now_s();
+  pthread_create(&reader, NULL, read_versions, &state);
+  if (with_writer) {
+    pthread_create(&writer, NULL, write_versions, &state);
+  }
+  usleep(static_cast<useconds_t>(read_s * 1e6));
+  __atomic_store_n(&state.is_done, 1, __ATOMIC_SEQ_CST);
+  pthread_join(reader, NULL);
+  if (with_writer) {
+    pthread_join(writer, NULL);
+  }
+  nbr_updates = state.nbr_updates;
+  return state.nbr_queries / (now_s() - start);
+}
+
+/*!
+ * Time the updates of a grid, then the readers with and without a writer.
+ * \param side side of the grid.
+ */
+void run(unsigned int side) {
+  Graph_Versions versions(random_grid(side));
+  double const start = now_s();
+  for (unsigned int k = 0; k < nbr_updates; k++) {
+    Graph *const g = versions.begin_update();
+    g->add_edge(rand() % g->nbr_vertices, rand() % g->nbr_vertices,
+                random_length());
+    versions.publish(g);
+  }
+  double const update_s = (now_s() - start) / nbr_updates;
+
+  unsigned long nbr_published;
+  double const alone = read_throughput(versions, false, nbr_published);
+  double const shared = read_throughput(versions, true, nbr_published);
+  cout << side * side << " vertices: update " << update_s
+       << " s, reader alone " << alone << " queries/s, with "
+       << nbr_published << " updates " << shared << " queries/s" << endl;
+}
+}
+
+int main() {
+  srand(2016);
+  unsigned int const sides[] = {100, 300, 1000};
+  for (size_t s = 0; s < sizeof(sides) / sizeof(sides[0]); s++) {
+    run(sides[s]);
+  }
+  return 0;
+}
@@ -0,0 +1,229 @@
+/*!
+ * \file
+ * \brief This module provides the betweenness centrality of the vertices and
+ * edges of a Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "betweenness.hpp"
+#include "parallel.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! State shared by the workers accumulating sources. */
+struct Sources_State {
+  vector<unsigned int> const &sources;
+  /*! Accumulator of each worker. */
+  vector<Betweenness *> accumulators;
+
+  Sources_State(vector<unsigned int> const &_sources,
+                unsigned int nbr_workers)
+      : sources(_sources), accumulators(nbr_workers, NULL) {}
+};
+
+/*! Accumulate a slice of the sources in the accumulator of the worker. */
+void add_slice(unsigned int worker, unsigned int nbr_workers, void *context) {
+  Sources_State &state = *static_cast<Sources_State *>(context);
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, state.sources.size(), first, last);
+  for (unsigned int k = first; k < last; k++) {
+    state.accumulators[worker]->add_source(state.sources[k]);
+  }
+}
+}
+
+Betweenness::Betweenness(Graph const &_graph)
+    : graph(_graph), search(_graph),
+      sigmas(new double[_graph.nbr_vertices]),
+      deltas(new double[_graph.nbr_vertices]),
+      offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      vertex_sums(new double[_graph.nbr_vertices]),
+      arc_sums(new double[_graph.get_nbr_arcs()]), nbr_sources(0),
+      view(NULL) {
+  assert(!graph.has_negative_length());
+  unsigned int position = 0;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    offsets[i] = position;
+    position += graph.get_edges(i).size();
+    sigmas[i] = 0;
+    deltas[i] = 0;
+    vertex_sums[i] = 0;
+  }
+  offsets[graph.nbr_vertices] = position;
+  for (unsigned int a = 0; a < position; a++) {
+    arc_sums[a] = 0;
+  }
+}
+
+Betweenness::~Betweenness() {
+  delete[] sigmas;
+  delete[] deltas;
+  delete[] offsets;
+  delete[] vertex_sums;
+  delete[] arc_sums;
+}
+
+void Betweenness::set_view(Graph_View const *_view) {
+  assert(nbr_sources == 0);
+  assert(_view == NULL || &_view->graph == &graph);
+  view = _view;
+  search.set_view(view);
+}
+
+void Betweenness::add_source(unsigned int s) {
+  assert(s < graph.nbr_vertices);
+  search.one_to_all(s);
+  vector<unsigned int> const &order = search.get_treated();
+
+  // NUMBERS OF SHORTEST PATHS, in the order of treatment: the vertices
+  // before v on a shortest path are all treated before it
+  for (size_t k = 0; k < order.size(); k++) {
+    sigmas[order[k]] = 0;
+    deltas[order[k]] = 0;
+  }
+  sigmas[s] = 1;
+  for (size_t k = 0; k < order.size(); k++) {
+    unsigned int const u = order[k];
+    float const du = search.get_distance(u);
+    Graph::VEdge const &edges = graph.get_edges(u);
+    for (size_t e = 0; e < edges.size(); e++) {
+      unsigned int const v = edges[e].first;
+      // The vertices treated are in the view, but not all their edges
+      if (search.is_treated(v) && v != u &&
+          du + edges[e].second == search.get_distance(v) &&
+          (view == NULL || view->has_edge(u, e))) {
+        sigmas[v] += sigmas[u];
+      }
+    }
+  }
+
+  // DEPENDENCIES, in the reverse order
+  for (size_t k = order.size(); 0 < k; k--) {
+    unsigned int const u = order[k - 1];
+    float const du = search.get_distance(u);
+    Graph::VEdge const &edges = graph.get_edges(u);
+    for (size_t e = 0; e < edges.size(); e++) {
+      unsigned int const v = edges[e].first;
+      if (search.is_treated(v) && v != u &&
+          du + edges[e].second == search.get_distance(v) &&
+          (view == NULL || view->has_edge(u, e))) {
+        double const share = sigmas[u] / sigmas[v] * (1 + deltas[v]);
+        deltas[u] += share;
+        arc_sums[offsets[u] + e] += share;
+      }
+    }
+    if (u != s) {
+      vertex_sums[u] += deltas[u];
+    }
+  }
+  nbr_sources++;
+}
+
+void Betweenness::add_sources(vector<unsigned int> const &sources,
+                              unsigned int nbr_workers) {
+  assert(0 < nbr_workers);
+  // worker 0 accumulates here, the others in accumulators merged after
+  Sources_State state(sources, nbr_workers);
+  state.accumulators[0] = this;
+  for (unsigned int w = 1; w < nbr_workers; w++) {
+    state.accumulators[w] = new Betweenness(graph);
+    state.accumulators[w]->set_view(view);
+  }
+  run_parallel(nbr_workers, add_slice, &state);
+  for (unsigned int w = 1; w < nbr_workers; w++) {
+    merge(*state.accumulators[w]);
+    delete state.accumulators[w];
+  }
+}
+
+void Betweenness::add_all_sources(unsigned int nbr_workers) {
+  assert(nbr_sources == 0);
+  vector<unsigned int> sources;
+  for (unsigned int s = 0; s < graph.nbr_vertices; s++) {
+    if (view == NULL || view->has_vertex(s)) {
+      sources.push_back(s);
+    }
+  }
+  add_sources(sources, nbr_workers);
+}
+
+void Betweenness::add_sampled_sources(unsigned int k, unsigned int seed,
+                                      unsigned int nbr_workers) {
+  assert(nbr_sources == 0);
+  unsigned int const n = get_nbr_vertices();
+  assert(k <= n);
+  // Partial Fisher–Yates shuffle of the vertices
+  vector<unsigned int> vertices;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    if (view == NULL || view->has_vertex(i)) {
+      vertices.push_back(i);
+    }
+  }
+  for (unsigned int c = 0; c < k; c++) {
+    unsigned int const pick = c + rand_r(&seed) % (n - c);
+    unsigned int const buffer = vertices[c];
+    vertices[c] = vertices[pick];
+    vertices[pick] = buffer;
+  }
+  vertices.resize(k);
+  add_sources(vertices, nbr_workers);
+}
+
+void Betweenness::merge(Betweenness const &other) {
+  assert(&other.graph == &graph);
+  assert(other.view == view);
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    vertex_sums[i] += other.vertex_sums[i];
+  }
+  for (unsigned int a = 0; a < offsets[graph.nbr_vertices]; a++) {
+    arc_sums[a] += other.arc_sums[a];
+  }
+  nbr_sources += other.nbr_sources;
+}
+
+unsigned int Betweenness::get_nbr_vertices() const {
+  return (view == NULL) ? graph.nbr_vertices : view->get_nbr_vertices();
+}
+
+double Betweenness::get_scale() const {
+  assert(0 < nbr_sources);
+  // Each pair is seen from both ends in an undirected graph
+  return double(get_nbr_vertices()) / nbr_sources *
+         (graph.is_directed ? 1 : 0.5);
+}
+
+double Betweenness::get_vertex_centrality(unsigned int i) const {
+  assert(i < graph.nbr_vertices);
+  return vertex_sums[i] * get_scale();
+}
+
+double Betweenness::get_edge_centrality(unsigned int i, size_t k) const {
+  assert(i < graph.nbr_vertices);
+  assert(offsets[i] + k < offsets[i + 1]);
+  double sum = arc_sums[offsets[i] + k];
+  if (!graph.is_directed) {
+    unsigned int const j = graph.get_edges(i)[k].first;
+    sum += arc_sums[offsets[j] + graph.get_back(i, k)];
+  }
+  return sum * get_scale();
+}
+
+double Betweenness::get_error_bound(double confidence) const {
+  assert(0 < confidence && confidence < 1);
+  assert(0 < nbr_sources);
+  if (nbr_sources == get_nbr_vertices()) {
+    return 0;
+  }
+  double const n = get_nbr_vertices();
+  double const range = (2 < n) ? n - 2 : 0;
+  return get_scale() * nbr_sources * range *
+         sqrt(log(2 / (1 - confidence)) / (2 * nbr_sources));
+}
@@ -0,0 +1,201 @@
+#ifndef __BETWEENNESS_HPP_
+#define __BETWEENNESS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides the betweenness centrality of the vertices and
+ * edges of a Graph (Brandes' algorithm), exact or estimated on a sample of
+ * sources.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "dijkstra.hpp"
+
+/*!
+ * \brief Accumulator of the betweenness centrality of the vertices and arcs
+ * of a Graph, source by source.
+ *
+ * The centrality of a vertex (resp. arc) is the sum, over the pairs of other
+ * vertices (s, t), of the share of the shortest paths from s to t through it.
+ * For an undirected graph, each pair is only counted once and an edge gets
+ * the centrality of its two arcs.
+ *
+ * For each source, a Dijkstra search gives the distances and the order of
+ * treatment. The numbers of shortest paths are then counted in that order,
+ * and the dependencies accumulated in the reverse order, along the arcs
+ * (u, v) such that d(u) + len = d(v). Lengths are compared exactly: they
+ * should be integers (or sums of them should be exact).
+ *
+ * With all the sources, the centralities are exact. With a uniform sample of
+ * k sources, they are estimated by scaling by n / k; get_error_bound gives
+ * the precision. Accumulators of separate sources can be merged: this is how
+ * the sources are split across workers (see run_parallel), each with its
+ * own accumulator.
+ *
+ * With a view (set_view), the centralities are those of the subgraph of the
+ * view: the sources, the paths and the scale are taken in it.
+ */
+class Betweenness {
+
+public:
+  /*! The graph. */
+  Graph const &graph;
+
+private:
+  /*! Search workspace. */
+  Dijkstra search;
+
+  /*! Array of the numbers of shortest paths from the current source. */
+  double *const sigmas;
+
+  /*! Array of the dependencies of the current source on the vertices. */
+  double *const deltas;
+
+  /*! Array of the position of the arcs of each vertex, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Array of the sums of the dependencies on the vertices. */
+  double *const vertex_sums;
+
+  /*! Array of the sums of the dependencies on the arcs, vertex by vertex. */
+  double *const arc_sums;
+
+  /*! Number of sources accumulated. */
+  unsigned int nbr_sources;
+
+  /*! View of the sources accumulated (NULL if none). */
+  Graph_View const *view;
+
+  /*! \return the number of vertices of the graph, or of the view. */
+  unsigned int get_nbr_vertices() const;
+
+  /*! \return the factor from the sums to the centralities. */
+  double get_scale() const;
+
+  /*! Not copyable. */
+  Betweenness(Betweenness const &);
+
+  /*! Not assignable. */
+  Betweenness &operator=(Betweenness const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build an accumulator with no source.
+   * \param _graph graph, it must not be destroyed before the accumulator,
+   * nor get new edges.
+   * \pre \c _graph has positive lengths only.
+   */
+  Betweenness(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Betweenness();
+
+  //
+  //  SOURCES
+  //
+
+  /*!
+   * Set the view of the sources accumulated next: only the edges of the
+   * view whose head is in the view are followed (see Graph_View).
+   * \param _view view of the graph, which must outlive its use, or \c NULL
+   * for none.
+   * \pre no source is accumulated yet.
+   */
+  void set_view(Graph_View const *_view);
+
+  /*!
+   * Accumulate the dependencies of a source.
+   * \param s source vertex.
+   * \pre \c s is a legal vertex number, in the view if any, not accumulated
+   * yet.
+   */
+  void add_source(unsigned int s);
+
+  /*!
+   * Accumulate sources split across workers: each worker accumulates a
+   * slice of them in an accumulator of its own, merged at the end.
+   * \param sources distinct source vertices.
+   * \param nbr_workers number of workers (1 runs in the calling thread).
+   * \pre the sources are legal vertex numbers, in the view if any, not
+   * accumulated yet, and \c nbr_workers is at least 1.
+   */
+  void add_sources(std::vector<unsigned int> const &sources,
+                   unsigned int nbr_workers);
+
+  /*!
+   * Accumulate all the sources, those of the view if any (for exact
+   * values).
+   * \param nbr_workers number of workers.
+   * \pre no source is accumulated yet.
+   */
+  void add_all_sources(unsigned int nbr_workers = 1);
+
+  /*!
+   * Accumulate a uniform sample of distinct sources (in the view if any).
+   * \param k number of sources.
+   * \param seed seed of the sample.
+   * \param nbr_workers number of workers.
+   * \pre no source is accumulated yet and \c k is at most the number of
+   * vertices (of the view if any).
+   */
+  void add_sampled_sources(unsigned int k, unsigned int seed,
+                           unsigned int nbr_workers = 1);
+
+  /*!
+   * Add the sources accumulated by another accumulator.
+   * \param other accumulator of the same graph and view, with other
+   * sources.
+   */
+  void merge(Betweenness const &other);
+
+  /*! \return the number of sources accumulated. */
+  unsigned int get_nbr_sources() const { return nbr_sources; }
+
+  //
+  //  CENTRALITIES
+  //
+
+  /*!
+   * Centrality of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number and a source was accumulated.
+   * \return the centrality of \c i, estimated from the sources accumulated.
+   */
+  double get_vertex_centrality(unsigned int i) const;
+
+  /*!
+   * Centrality of an edge (both arcs for an undirected graph).
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number, \c k a legal position, and a source
+   * was accumulated.
+   * \return the centrality of the edge, estimated from the sources
+   * accumulated.
+   */
+  double get_edge_centrality(unsigned int i, size_t k) const;
+
+  /*!
+   * Precision of the centralities of the vertices estimated from a sample
+   * (Hoeffding's inequality: the dependency of a source on a vertex is
+   * between 0 and n - 2).
+   * \param confidence probability that the bound holds, for each vertex.
+   * \pre 0 < \c confidence < 1 and a source was accumulated.
+   * \return a bound of the error on a vertex centrality, 0 if all the
+   * sources are accumulated.
+   */
+  double get_error_bound(double confidence) const;
+};
+
+#endif
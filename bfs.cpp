@@ -0,0 +1,194 @@
+/*!
+ * \file
+ * \brief This module provides a direction-optimizing breadth-first search on
+ * Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // reverse
+#include <limits>
+
+#include "bfs.hpp"
+#include "parallel.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Number of bits in a word of the bitmaps. */
+unsigned int const word_bits = numeric_limits<unsigned int>::digits;
+
+/*! Go bottom-up when the frontier has more than 1/alpha of the unexplored
+ * edges. */
+unsigned long const alpha = 14;
+
+/*! Go back top-down when the frontier has less than 1/beta of the vertices. */
+unsigned long const beta = 24;
+}
+
+unsigned int const Bfs::unreached = numeric_limits<unsigned int>::max();
+
+Bfs::Bfs(Graph const &_graph)
+    : graph(_graph), hops(new unsigned int[_graph.nbr_vertices]),
+      parents(new unsigned int[_graph.nbr_vertices]),
+      frontier_bits((_graph.nbr_vertices + word_bits - 1) / word_bits, 0),
+      source(0), unexplored_degree(0), view(NULL), nbr_workers(1), level(0),
+      worker_next(1), worker_degree(1, 0) {
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    hops[i] = unreached;
+    parents[i] = i;
+  }
+}
+
+Bfs::~Bfs() {
+  delete[] hops;
+  delete[] parents;
+}
+
+void Bfs::set_nbr_workers(unsigned int _nbr_workers) {
+  assert(0 < _nbr_workers);
+  nbr_workers = _nbr_workers;
+  worker_next.resize(nbr_workers);
+  worker_degree.resize(nbr_workers);
+}
+
+void Bfs::step_top_down(unsigned int worker, unsigned int nbr_workers,
+                        void *context) {
+  Bfs &bfs = *static_cast<Bfs *>(context);
+  vector<unsigned int> &found = bfs.worker_next[worker];
+  unsigned long &degree = bfs.worker_degree[worker];
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, bfs.frontier.size(), first, last);
+  for (unsigned int k = first; k < last; k++) {
+    unsigned int const u = bfs.frontier[k];
+    Graph::VEdge const &edges = bfs.graph.get_edges(u);
+    for (size_t e = 0; e < edges.size(); e++) {
+      unsigned int const v = edges[e].first;
+      unsigned int expected = unreached;
+      // The worker whose swap succeeds owns v (its parent and its edges)
+      if (__atomic_load_n(&bfs.hops[v], __ATOMIC_RELAXED) == unreached &&
+          !Graph::is_removed(edges[e]) &&
+          (bfs.view == NULL || bfs.view->has_arc(u, e, v)) &&
+          __atomic_compare_exchange_n(&bfs.hops[v], &expected, bfs.level,
+                                      false, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        bfs.parents[v] = u;
+        found.push_back(v);
+        degree += bfs.graph.get_edges(v).size();
+      }
+    }
+  }
+}
+
+void Bfs::step_bottom_up(unsigned int worker, unsigned int nbr_workers,
+                         void *context) {
+  Bfs &bfs = *static_cast<Bfs *>(context);
+  vector<unsigned int> &found = bfs.worker_next[worker];
+  unsigned long &degree = bfs.worker_degree[worker];
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, bfs.graph.nbr_vertices, first, last);
+  for (unsigned int v = first; v < last; v++) {
+    if (bfs.hops[v] != unreached ||
+        (bfs.view != NULL && !bfs.view->has_vertex(v))) {
+      continue;
+    }
+    Graph::VEdge const &edges = bfs.graph.get_edges(v);
+    for (size_t e = 0; e < edges.size(); e++) {
+      unsigned int const u = edges[e].first;
+      // The edges of an undirected view are in both ways
+      if ((bfs.frontier_bits[u / word_bits] & (1u << (u % word_bits))) &&
+          !Graph::is_removed(edges[e]) &&
+          (bfs.view == NULL || bfs.view->has_edge(v, e))) {
+        bfs.hops[v] = bfs.level;
+        bfs.parents[v] = u;
+        found.push_back(v);
+        degree += edges.size();
+        break;
+      }
+    }
+  }
+}
+
+void Bfs::merge_workers() {
+  for (unsigned int w = 0; w < nbr_workers; w++) {
+    next.insert(next.end(), worker_next[w].begin(), worker_next[w].end());
+    reached.insert(reached.end(), worker_next[w].begin(),
+                   worker_next[w].end());
+    unexplored_degree -= worker_degree[w];
+    worker_next[w].clear();
+    worker_degree[w] = 0;
+  }
+}
+
+void Bfs::run(unsigned int from, unsigned int to) {
+  assert(from < graph.nbr_vertices);
+  assert(to <= graph.nbr_vertices);
+  assert(view == NULL || (&view->graph == &graph && view->has_vertex(from)));
+  for (size_t k = 0; k < reached.size(); k++) {
+    hops[reached[k]] = unreached;
+    parents[reached[k]] = reached[k];
+  }
+  reached.clear();
+  source = from;
+
+  unexplored_degree = graph.get_nbr_arcs();
+  next.clear();
+  reach(from, from, 0);
+  if (to < graph.nbr_vertices && !graph.is_connected(from, to)) {
+    return;
+  }
+
+  bool is_bottom_up = false;
+  for (level = 1; !next.empty(); level++) {
+    frontier.swap(next);
+    next.clear();
+    if (to < graph.nbr_vertices && hops[to] != unreached) {
+      break;
+    }
+    // Beamer's heuristic, on the edges (resp. vertices) of the frontier.
+    // Bottom-up needs the arcs coming in, so it is only for undirected.
+    if (graph.is_directed) {
+      is_bottom_up = false;
+    } else if (is_bottom_up) {
+      is_bottom_up = graph.nbr_vertices < beta * frontier.size();
+    } else {
+      unsigned long frontier_degree = 0;
+      for (size_t k = 0; k < frontier.size(); k++) {
+        frontier_degree += graph.get_edges(frontier[k]).size();
+      }
+      is_bottom_up = unexplored_degree < alpha * frontier_degree;
+    }
+    if (is_bottom_up) {
+      for (size_t k = 0; k < frontier.size(); k++) {
+        frontier_bits[frontier[k] / word_bits] |= 1u
+                                                  << (frontier[k] % word_bits);
+      }
+      run_parallel(nbr_workers, step_bottom_up, this);
+      for (size_t k = 0; k < frontier.size(); k++) {
+        frontier_bits[frontier[k] / word_bits] = 0;
+      }
+    } else {
+      // Most levels of a sparse graph are small: not worth the workers
+      run_parallel(get_nbr_useful_workers(nbr_workers, frontier.size()),
+                   step_top_down, this);
+    }
+    merge_workers();
+  }
+}
+
+bool Bfs::get_path(unsigned int to, vector<unsigned int> &path) const {
+  assert(to < graph.nbr_vertices);
+  path.clear();
+  if (hops[to] == unreached) {
+    return false;
+  }
+  for (unsigned int i = to; i != source; i = parents[i]) {
+    path.push_back(i);
+  }
+  path.push_back(source);
+  reverse(path.begin(), path.end());
+  return true;
+}
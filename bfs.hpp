@@ -0,0 +1,197 @@
+#ifndef __BFS_HPP_
+#define __BFS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides a direction-optimizing breadth-first search on
+ * Graph, to compute hop distances.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+class Graph_View;
+
+/*!
+ * \brief Search workspace for a breadth-first search on a Graph.
+ *
+ * The search is level-synchronous and chooses for each level between
+ * (Beamer's heuristic):
+ * \li top-down: the edges of the frontier are scanned to find new vertices,
+ * cheap while the frontier is small;
+ * \li bottom-up: each unvisited vertex scans its edges for a frontier vertex
+ * (held in a bitmap) and stops at the first one found, cheap when the
+ * frontier is a large part of the graph.
+ *
+ * Bottom-up steps are only used for undirected graphs.
+ *
+ * Each level can be split across workers (see run_parallel): top-down steps
+ * split the frontier, and a vertex goes to the worker that first claims its
+ * hop distance (compare-and-swap); bottom-up steps split the vertices, each
+ * written by its owner only. The hop distances do not depend on the number
+ * of workers, the parents may (any vertex of the previous level).
+ *
+ * When all the edges have the same length, hop distances give the shortest
+ * distances: this is the case for which Graph::print_dijkstra uses it.
+ */
+class Bfs {
+
+public:
+  /*! The graph searched. */
+  Graph const &graph;
+
+  /*! Hop distance of the vertices not reached. */
+  static unsigned int const unreached;
+
+private:
+  /*! Array of the hop distances, indexed by vertex number. */
+  unsigned int *const hops;
+
+  /*! Array of the vertices to come from (at one hop less). */
+  unsigned int *const parents;
+
+  /*! Vertices of the current level. */
+  std::vector<unsigned int> frontier;
+
+  /*! Vertices of the next level. */
+  std::vector<unsigned int> next;
+
+  /*! Bitmap of the current level (bottom-up steps only). */
+  std::vector<unsigned int> frontier_bits;
+
+  /*! Vertices reached by the last search (to reset them). */
+  std::vector<unsigned int> reached;
+
+  /*! Source of the last search. */
+  unsigned int source;
+
+  /*! Sum of the degrees of the vertices not reached yet. */
+  unsigned long unexplored_degree;
+
+  /*! View of the searches (NULL if none). */
+  Graph_View const *view;
+
+  /*! Number of workers of the steps. */
+  unsigned int nbr_workers;
+
+  /*! Hop distance of the level being built. */
+  unsigned int level;
+
+  /*! Vertices of the next level found by each worker. */
+  std::vector<std::vector<unsigned int> > worker_next;
+
+  /*! Sum of the degrees of the vertices reached by each worker. */
+  std::vector<unsigned long> worker_degree;
+
+  /*!
+   * Scan the edges of a slice of the frontier for the next level.
+   * \param worker worker number.
+   * \param nbr_workers number of workers.
+   * \param context the Bfs.
+   */
+  static void step_top_down(unsigned int worker, unsigned int nbr_workers,
+                            void *context);
+
+  /*!
+   * Look, for every vertex of a slice not reached, for a neighbour in the
+   * frontier.
+   * \param worker worker number.
+   * \param nbr_workers number of workers.
+   * \param context the Bfs.
+   */
+  static void step_bottom_up(unsigned int worker, unsigned int nbr_workers,
+                             void *context);
+
+  /*! Append the vertices found by the workers to the next level. */
+  void merge_workers();
+
+  /*! Mark a vertex as reached. */
+  void reach(unsigned int v, unsigned int u, unsigned int level) {
+    hops[v] = level;
+    parents[v] = u;
+    next.push_back(v);
+    reached.push_back(v);
+    unexplored_degree -= graph.get_edges(v).size();
+  }
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _graph.
+   * \param _graph graph to search, it must not be destroyed before the
+   * workspace.
+   */
+  Bfs(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Bfs();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Compute the hop distances from \c from. If \c to is a legal vertex, the
+   * search stops at the end of the level reaching it.
+   * \param from source vertex.
+   * \param to target vertex, or \c graph.nbr_vertices for all.
+   * \pre \c from is a legal vertex number.
+   */
+  void run(unsigned int from, unsigned int to);
+
+  /*!
+   * Set the view used by the next searches: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the searches are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+
+  /*!
+   * Set the number of workers of the next searches.
+   * \param _nbr_workers number of workers (1 runs in the calling thread).
+   * \pre \c _nbr_workers is at least 1.
+   */
+  void set_nbr_workers(unsigned int _nbr_workers);
+
+  /*!
+   * Hop distance found by the last search.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the number of edges of a shortest path to \c i, or \c unreached.
+   */
+  unsigned int get_hops(unsigned int i) const {
+    assert(i < graph.nbr_vertices);
+    return hops[i];
+  }
+
+  /*!
+   * Vertices reached by the last search.
+   * \return the vertices, by increasing hop distance.
+   */
+  std::vector<unsigned int> const &get_reached() const { return reached; }
+
+  /*!
+   * Path found by the last search.
+   * \param to last vertex of the path.
+   * \param path filled with the vertices of the path, from the source to
+   * \c to.
+   * \pre \c to is a legal vertex number.
+   * \return false (and leave \c path empty) iff \c to was not reached.
+   */
+  bool get_path(unsigned int to, std::vector<unsigned int> &path) const;
+};
+
+#endif
@@ -0,0 +1,243 @@
+/*!
+ * \file
+ * \brief This module provides contraction hierarchies on Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <limits>
+
+#include "ch.hpp"
+#include "dijkstra.hpp"
+#include "heap_id.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Constant to indicate that the node is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the node was treated. */
+int const id_treated = -2;
+
+/*! Distance of the vertices not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! Maximal number of vertices treated by a witness search. */
+unsigned int const max_witness_treated = 500;
+
+/*! A shortcut to add between two neighbours of a contracted vertex. */
+struct Shortcut {
+  unsigned int i;
+  unsigned int j;
+  float length;
+};
+
+/*!
+ * Add an edge to an adjacency list, or lower its length if already there.
+ * \return true iff the edge is new.
+ */
+bool add_or_lower(Graph::VEdge &edges, unsigned int j, float len) {
+  for (size_t k = 0; k < edges.size(); k++) {
+    if (edges[k].first == j) {
+      edges[k].second = (len < edges[k].second) ? len : edges[k].second;
+      return false;
+    }
+  }
+  edges.push_back(Graph::Edge(j, len));
+  return true;
+}
+
+/*! Remove an edge from an adjacency list. */
+void remove(Graph::VEdge &edges, unsigned int j) {
+  for (size_t k = 0; k < edges.size(); k++) {
+    if (edges[k].first == j) {
+      edges[k] = edges.back();
+      edges.pop_back();
+      return;
+    }
+  }
+}
+
+/*!
+ * Bounded Dijkstra search on the graph being contracted, to look for paths
+ * that make a shortcut useless.
+ */
+class Witness_Search {
+  Heap_Id<Dijkstra::Vertex_Key> heap;
+  vector<Dijkstra::Vertex_Key> keys;
+  vector<int> heap_ids;
+  vector<unsigned int> touched;
+
+public:
+  Witness_Search(unsigned int n)
+      : heap(n), keys(n), heap_ids(n, id_undefined) {
+    for (unsigned int i = 0; i < n; i++) {
+      keys[i].distance = infinity;
+      keys[i].i = i;
+    }
+  }
+
+  /*!
+   * Search from \c from without going through \c avoid, up to \c radius or
+   * max_witness_treated vertices.
+   */
+  void run(vector<Graph::VEdge> const &adjacency, unsigned int from,
+           unsigned int avoid, float radius) {
+    for (size_t k = 0; k < touched.size(); k++) {
+      keys[touched[k]].distance = infinity;
+      heap_ids[touched[k]] = id_undefined;
+    }
+    touched.clear();
+    heap.clear();
+
+    keys[from].distance = 0;
+    heap_ids[from] = heap.push(keys[from]);
+    touched.push_back(from);
+    for (unsigned int nbr_treated = 0;
+         !heap.is_empty() && nbr_treated < max_witness_treated;
+         nbr_treated++) {
+      unsigned int const u = heap.pop().i;
+      heap_ids[u] = id_treated;
+      float const du = keys[u].distance;
+      if (radius < du) {
+        break;
+      }
+      Graph::VEdge const &edges = adjacency[u];
+      for (size_t k = 0; k < edges.size(); k++) {
+        unsigned int const v = edges[k].first;
+        float const dv = du + edges[k].second;
+        if (v == avoid) {
+          continue;
+        }
+        if (heap_ids[v] == id_undefined) {
+          keys[v].distance = dv;
+          heap_ids[v] = heap.push(keys[v]);
+          touched.push_back(v);
+        } else if (heap_ids[v] != id_treated && dv < keys[v].distance) {
+          keys[v].distance = dv;
+          heap.reposition(heap_ids[v]);
+        }
+      }
+    }
+  }
+
+  /*! \return the length of a path found to \c i (infinity if none). */
+  float get_distance(unsigned int i) const { return keys[i].distance; }
+};
+
+/*!
+ * Compute the shortcuts needed to contract a vertex.
+ * \param adjacency graph being contracted.
+ * \param v vertex.
+ * \param witness search workspace.
+ * \param shortcuts filled with the shortcuts.
+ */
+void find_shortcuts(vector<Graph::VEdge> const &adjacency, unsigned int v,
+                    Witness_Search &witness, vector<Shortcut> &shortcuts) {
+  shortcuts.clear();
+  Graph::VEdge const &edges = adjacency[v];
+  for (size_t a = 0; a + 1 < edges.size(); a++) {
+    float radius = 0;
+    for (size_t b = a + 1; b < edges.size(); b++) {
+      radius = (radius < edges[b].second) ? edges[b].second : radius;
+    }
+    witness.run(adjacency, edges[a].first, v, edges[a].second + radius);
+    for (size_t b = a + 1; b < edges.size(); b++) {
+      float const via = edges[a].second + edges[b].second;
+      if (via < witness.get_distance(edges[b].first)) {
+        Shortcut const s = {edges[a].first, edges[b].first, via};
+        shortcuts.push_back(s);
+      }
+    }
+  }
+}
+}
+
+Contraction_Hierarchy::Contraction_Hierarchy(Graph const &g)
+    : nbr_vertices(g.nbr_vertices), ranks(new unsigned int[g.nbr_vertices]),
+      vertices(new unsigned int[g.nbr_vertices]),
+      offsets(new unsigned int[g.nbr_vertices + 1]), nbr_shortcuts(0) {
+  assert(!g.is_directed);
+  assert(!g.has_negative_length());
+  unsigned int const n = nbr_vertices;
+
+  // Simple graph (no loop, shortest of parallel edges) being contracted
+  vector<Graph::VEdge> adjacency(n);
+  for (unsigned int i = 0; i < n; i++) {
+    Graph::VEdge const &edges = g.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (edges[k].first != i && !Graph::is_removed(edges[k])) {
+        add_or_lower(adjacency[i], edges[k].first, edges[k].second);
+      }
+    }
+  }
+
+  // Priority of a vertex: edge difference plus contracted neighbours, kept
+  // in a heap and updated lazily (when on top)
+  Witness_Search witness(n);
+  vector<Shortcut> shortcuts;
+  vector<unsigned int> nbr_contracted_neighbours(n, 0);
+  Heap_Id<Dijkstra::Vertex_Key> heap(n);
+  vector<Dijkstra::Vertex_Key> priorities(n);
+  vector<int> heap_ids(n);
+  for (unsigned int i = 0; i < n; i++) {
+    find_shortcuts(adjacency, i, witness, shortcuts);
+    priorities[i].distance =
+        float(shortcuts.size()) - float(adjacency[i].size());
+    priorities[i].i = i;
+    heap_ids[i] = heap.push(priorities[i]);
+  }
+
+  // CONTRACTION
+  vector<Graph::VEdge> upward(n);
+  unsigned int rank = 0;
+  while (!heap.is_empty()) {
+    unsigned int const v = heap.top().i;
+    find_shortcuts(adjacency, v, witness, shortcuts);
+    float const priority = float(shortcuts.size()) -
+                           float(adjacency[v].size()) +
+                           float(nbr_contracted_neighbours[v]);
+    if (priorities[v].distance < priority) {
+      priorities[v].distance = priority;
+      heap.reposition(heap_ids[v]);
+      continue;
+    }
+    heap.pop();
+    ranks[v] = rank;
+    vertices[rank] = v;
+    rank++;
+    upward[v].swap(adjacency[v]);
+    for (size_t k = 0; k < upward[v].size(); k++) {
+      unsigned int const u = upward[v][k].first;
+      remove(adjacency[u], v);
+      nbr_contracted_neighbours[u]++;
+    }
+    for (size_t k = 0; k < shortcuts.size(); k++) {
+      Shortcut const &s = shortcuts[k];
+      if (add_or_lower(adjacency[s.i], s.j, s.length)) {
+        nbr_shortcuts++;
+      }
+      add_or_lower(adjacency[s.j], s.i, s.length);
+    }
+  }
+
+  // UPWARD ARCS, by rank
+  for (unsigned int r = 0; r < n; r++) {
+    offsets[r] = arcs.size();
+    Graph::VEdge const &edges = upward[vertices[r]];
+    for (size_t k = 0; k < edges.size(); k++) {
+      Arc const a = {ranks[edges[k].first], edges[k].second};
+      arcs.push_back(a);
+    }
+  }
+  offsets[n] = arcs.size();
+}
+
+Contraction_Hierarchy::~Contraction_Hierarchy() {
+  delete[] ranks;
+  delete[] vertices;
+  delete[] offsets;
+}
@@ -0,0 +1,135 @@
+#ifndef __CH_HPP_
+#define __CH_HPP_
+
+/*!
+ * \file
+ * \brief This module provides contraction hierarchies on Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+/*!
+ * \brief Contraction hierarchy of an undirected Graph.
+ *
+ * The vertices are contracted one by one, least important first: the
+ * contraction of a vertex removes it and adds a shortcut between two of its
+ * neighbours whenever the path through it is the only shortest one (as far as
+ * a bounded witness search can tell). The rank of a vertex is its position in
+ * the contraction order.
+ *
+ * Any shortest path then has a counterpart that goes up the ranks then down,
+ * so that searches need only follow the upward arcs: the edges and shortcuts
+ * from each vertex to the neighbours of higher rank it had when contracted.
+ *
+ * Implementation: the vertices are renumbered by rank and the upward arcs
+ * are stored contiguously, rank by rank, so that a sweep over the ranks reads
+ * them linearly (see Phast).
+ */
+class Contraction_Hierarchy {
+
+public:
+  /*! An upward arc: rank of its head and length. */
+  class Arc {
+  public:
+    /*! Rank of the head, higher than the rank of the tail. */
+    unsigned int head;
+
+    /*! Length of the edge or shortcut. */
+    float length;
+  };
+
+  /*! Number of vertices. */
+  unsigned int const nbr_vertices;
+
+private:
+  /*! Array of the rank of each vertex. */
+  unsigned int *const ranks;
+
+  /*! Array of the vertex of each rank. */
+  unsigned int *const vertices;
+
+  /*! Array of the position of the upward arcs of each rank, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Upward arcs, rank by rank. */
+  std::vector<Arc> arcs;
+
+  /*! Number of shortcuts added. */
+  unsigned int nbr_shortcuts;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Contract a graph.
+   * \param g graph.
+   * \pre \c g is not directed and has no negative length.
+   */
+  Contraction_Hierarchy(Graph const &g);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Contraction_Hierarchy();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the rank of \c i.
+   */
+  unsigned int get_rank(unsigned int i) const {
+    assert(i < nbr_vertices);
+    return ranks[i];
+  }
+
+  /*!
+   * \param r rank.
+   * \pre \c r is less than nbr_vertices.
+   * \return the vertex of rank \c r.
+   */
+  unsigned int get_vertex(unsigned int r) const {
+    assert(r < nbr_vertices);
+    return vertices[r];
+  }
+
+  /*!
+   * \param r rank.
+   * \pre \c r is less than nbr_vertices.
+   * \return the first upward arc of rank \c r.
+   */
+  Arc const *get_arcs_begin(unsigned int r) const {
+    assert(r < nbr_vertices);
+    return arcs.empty() ? NULL : &arcs[0] + offsets[r];
+  }
+
+  /*!
+   * \param r rank.
+   * \pre \c r is less than nbr_vertices.
+   * \return the end of the upward arcs of rank \c r.
+   */
+  Arc const *get_arcs_end(unsigned int r) const {
+    assert(r < nbr_vertices);
+    return arcs.empty() ? NULL : &arcs[0] + offsets[r + 1];
+  }
+
+  /*! \return the number of upward arcs. */
+  unsigned int get_nbr_arcs() const { return arcs.size(); }
+
+  /*! \return the number of shortcuts added by the contraction. */
+  unsigned int get_nbr_shortcuts() const { return nbr_shortcuts; }
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*!
+ * \file
+ * \brief This module provides the closeness and harmonic centralities of the
+ * vertices of a Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // min
+#include <limits>
+
+#include <pthread.h>
+
+#include "ch.hpp"
+#include "closeness.hpp"
+#include "dijkstra.hpp"
+#include "multi_source.hpp"
+#include "parallel.hpp"
+#include "phast.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Distance of the vertices not reached. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! Largest number of sources at once, among the engines. */
+unsigned int const max_lanes = Bit_Parallel_Bfs::nbr_lanes;
+}
+
+struct Closeness::Run_State {
+  Closeness &centralities;
+  /*! Range of the sources. */
+  unsigned int first;
+  unsigned int last;
+  /*! Number of sources of a batch. */
+  unsigned int nbr_lanes;
+  Progress progress;
+  void *context;
+  /*! Number of sources done by all the workers, and its lock (which also
+   * serializes the progress calls). */
+  unsigned int nbr_done;
+  pthread_mutex_t lock;
+};
+
+Closeness::Closeness(Graph const &_graph)
+    : graph(_graph), closeness(new float[_graph.nbr_vertices]),
+      harmonic(new float[_graph.nbr_vertices]), view(NULL), ch(NULL) {
+  assert(!graph.has_negative_length());
+  Workspace const none = {NULL, NULL, NULL, NULL};
+  workspaces.assign(1, none);
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    closeness[i] = 0;
+    harmonic[i] = 0;
+  }
+  if (graph.has_common_length()) {
+    engine = engine_bit_parallel_bfs;
+  } else if (!graph.is_directed && phast_min_vertices <= graph.nbr_vertices) {
+    engine = engine_phast;
+  } else {
+    engine = engine_lane_dijkstra;
+  }
+}
+
+Closeness::~Closeness() {
+  delete[] closeness;
+  delete[] harmonic;
+  clear_engines();
+}
+
+void Closeness::clear_engines() {
+  for (size_t k = 0; k < workspaces.size(); k++) {
+    Workspace &w = workspaces[k];
+    delete w.search;
+    delete w.lanes;
+    delete w.phast;
+    delete w.bfs;
+    w.search = NULL;
+    w.lanes = NULL;
+    w.phast = NULL;
+    w.bfs = NULL;
+  }
+  delete ch;
+  ch = NULL;
+}
+
+void Closeness::set_engine(Engine _engine) {
+  assert(_engine != engine_phast || (!graph.is_directed && view == NULL));
+  assert(_engine != engine_bit_parallel_bfs || graph.has_common_length());
+  if (_engine != engine) {
+    clear_engines();
+    engine = _engine;
+  }
+}
+
+void Closeness::set_view(Graph_View const *_view) {
+  assert(_view == NULL || &_view->graph == &graph);
+  view = _view;
+  if (view != NULL && engine == engine_phast) {
+    set_engine(engine_lane_dijkstra);
+  }
+}
+
+void Closeness::set_nbr_workers(unsigned int nbr_workers) {
+  assert(0 < nbr_workers);
+  for (size_t k = nbr_workers; k < workspaces.size(); k++) {
+    delete workspaces[k].search;
+    delete workspaces[k].lanes;
+    delete workspaces[k].phast;
+    delete workspaces[k].bfs;
+  }
+  Workspace const none = {NULL, NULL, NULL, NULL};
+  workspaces.resize(nbr_workers, none);
+}
+
+unsigned int Closeness::prepare(Workspace &w) {
+  switch (engine) {
+  case engine_dijkstra:
+    w.search = (w.search == NULL) ? new Dijkstra(graph) : w.search;
+    w.search->set_view(view);
+    return 1;
+  case engine_lane_dijkstra:
+    w.lanes = (w.lanes == NULL) ? new Lane_Dijkstra(graph) : w.lanes;
+    w.lanes->set_view(view);
+    return Lane_Dijkstra::nbr_lanes;
+  case engine_phast:
+    ch = (ch == NULL) ? new Contraction_Hierarchy(graph) : ch;
+    w.phast = (w.phast == NULL) ? new Phast(*ch) : w.phast;
+    return Phast::nbr_lanes;
+  case engine_bit_parallel_bfs:
+    w.bfs = (w.bfs == NULL) ? new Bit_Parallel_Bfs(graph) : w.bfs;
+    w.bfs->set_view(view);
+    return Bit_Parallel_Bfs::nbr_lanes;
+  }
+  return 1;
+}
+
+void Closeness::run(unsigned int first, unsigned int last, Progress progress,
+                    void *context) {
+  assert(first <= last);
+  assert(last <= graph.nbr_vertices);
+  // the workspaces (and the shared hierarchy) are built before the workers
+  unsigned int nbr_lanes = 1;
+  for (size_t k = 0; k < workspaces.size(); k++) {
+    nbr_lanes = prepare(workspaces[k]);
+  }
+  Run_State state = {*this, first, last, nbr_lanes, progress, context, 0,
+                     pthread_mutex_t()};
+  pthread_mutex_init(&state.lock, NULL);
+  run_parallel(workspaces.size(), run_slice, &state);
+  pthread_mutex_destroy(&state.lock);
+}
+
+void Closeness::run_slice(unsigned int worker, unsigned int nbr_workers,
+                          void *context) {
+  Run_State &state = *static_cast<Run_State *>(context);
+  Closeness &c = state.centralities;
+  Graph const &graph = c.graph;
+  Workspace &w = c.workspaces[worker];
+  unsigned int const nbr_lanes = state.nbr_lanes;
+  // slices of whole batches, so that the lanes stay full
+  unsigned int const size = state.last - state.first;
+  unsigned int first_batch, last_batch;
+  get_slice(worker, nbr_workers, (size + nbr_lanes - 1) / nbr_lanes,
+            first_batch, last_batch);
+  unsigned int const first = state.first + first_batch * nbr_lanes;
+  unsigned int const last = state.first + min(size, last_batch * nbr_lanes);
+
+  vector<unsigned int> sources;
+  double sums[max_lanes];
+  double inverse_sums[max_lanes];
+  unsigned int nbr_reached[max_lanes];
+  for (unsigned int s = first; s < last; s += nbr_lanes) {
+    // ONE-TO-ALL SEARCHES of a batch of sources, those in the view
+    unsigned int const batch_end = min(last, s + nbr_lanes);
+    sources.clear();
+    for (unsigned int k = s; k < batch_end; k++) {
+      if (c.view == NULL || c.view->has_vertex(k)) {
+        sources.push_back(k);
+      } else {
+        c.closeness[k] = 0;
+        c.harmonic[k] = 0;
+      }
+    }
+    unsigned int const nbr_sources = sources.size();
+    // A batch out of the view has nothing to search
+    if (0 < nbr_sources) {
+      switch (c.engine) {
+      case engine_dijkstra:
+        w.search->one_to_all(sources[0]);
+        break;
+      case engine_lane_dijkstra:
+        w.lanes->run(sources);
+        break;
+      case engine_phast:
+        w.phast->many_to_all(sources);
+        break;
+      case engine_bit_parallel_bfs:
+        w.bfs->run(sources);
+        break;
+      }
+
+      // STREAMED SUMS, vertex by vertex (the lanes of a vertex are together)
+      for (unsigned int lane = 0; lane < nbr_sources; lane++) {
+        sums[lane] = 0;
+        inverse_sums[lane] = 0;
+        nbr_reached[lane] = 0;
+      }
+      for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+        for (unsigned int lane = 0; lane < nbr_sources; lane++) {
+          float d = infinity;
+          switch (c.engine) {
+          case engine_dijkstra:
+            d = w.search->get_distance(i);
+            break;
+          case engine_lane_dijkstra:
+            d = w.lanes->get_distance(lane, i);
+            break;
+          case engine_phast:
+            d = w.phast->get_distance(lane, i);
+            break;
+          case engine_bit_parallel_bfs:
+            unsigned int const hops = w.bfs->get_hops(lane, i);
+            if (hops != Bit_Parallel_Bfs::unreached) {
+              d = hops * graph.get_common_length();
+            }
+            break;
+          }
+          if (d < infinity && i != sources[lane]) {
+            sums[lane] += d;
+            // Arcs of length 0 (directed graphs) add no finite harmonic term
+            inverse_sums[lane] += (0 < d) ? 1 / double(d) : 0;
+            nbr_reached[lane]++;
+          }
+        }
+      }
+      // each worker writes its own sources only
+      for (unsigned int lane = 0; lane < nbr_sources; lane++) {
+        unsigned int const v = sources[lane];
+        c.closeness[v] = (0 < sums[lane]) ? nbr_reached[lane] / sums[lane] : 0;
+        c.harmonic[v] = inverse_sums[lane];
+      }
+    }
+    pthread_mutex_lock(&state.lock);
+    state.nbr_done += batch_end - s;
+    if (state.progress != NULL) {
+      state.progress(state.nbr_done, size, state.context);
+    }
+    pthread_mutex_unlock(&state.lock);
+  }
+}
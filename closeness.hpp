@@ -0,0 +1,208 @@
+#ifndef __CLOSENESS_HPP_
+#define __CLOSENESS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides the closeness and harmonic centralities of the
+ * vertices of a Graph, from one-to-all searches streamed source by source.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+class Bit_Parallel_Bfs;
+class Contraction_Hierarchy;
+class Dijkstra;
+class Graph_View;
+class Lane_Dijkstra;
+class Phast;
+
+/*!
+ * \brief Closeness and harmonic centralities of the vertices of a Graph.
+ *
+ * For a vertex \c v reaching \c r vertices (itself included) at distances
+ * summing to \c s:
+ * \li its closeness is (r - 1) / s (0 if it reaches no other vertex);
+ * \li its harmonic centrality is the sum of 1 / d(v, u) over the vertices
+ * \c u reached, other than \c v.
+ *
+ * The distances of each source are summed as soon as they are computed, with
+ * the fastest one-to-all engine for the graph, several sources at once:
+ * \li Bit_Parallel_Bfs if all the edges have the same length;
+ * \li Phast (on a Contraction_Hierarchy built first) for a large undirected
+ * graph;
+ * \li Lane_Dijkstra otherwise.
+ *
+ * The sources can be computed by ranges, a callback telling the progress.
+ * A range is split across workers (see run_parallel): each worker has its
+ * own engine workspace (the Contraction_Hierarchy is shared) and writes the
+ * centralities of its own slice of the sources only.
+ *
+ * With a view (set_view), the centralities are those of the subgraph of the
+ * view, the vertices out of it getting 0. Phast, whose hierarchy is built
+ * on the whole graph, is then replaced by Lane_Dijkstra.
+ */
+class Closeness {
+
+public:
+  /*! One-to-all engines. */
+  enum Engine {
+    /*! Plain Dijkstra, one source at a time. */
+    engine_dijkstra,
+    /*! Lane_Dijkstra, 8 sources at a time. */
+    engine_lane_dijkstra,
+    /*! Phast, 8 sources at a time. */
+    engine_phast,
+    /*! Bit_Parallel_Bfs, 32 sources at a time. */
+    engine_bit_parallel_bfs
+  };
+
+  /*!
+   * Progress callback, called by one worker at a time.
+   * \param nbr_done number of sources computed in the range, by all the
+   * workers.
+   * \param nbr_sources number of sources of the range.
+   * \param context context given to run.
+   */
+  typedef void (*Progress)(unsigned int nbr_done, unsigned int nbr_sources,
+                           void *context);
+
+  /*! The graph. */
+  Graph const &graph;
+
+private:
+  /*! Array of the closeness of the vertices. */
+  float *const closeness;
+
+  /*! Array of the harmonic centralities of the vertices. */
+  float *const harmonic;
+
+  /*! Engine used. */
+  Engine engine;
+
+  /*! View of the searches (NULL if none). */
+  Graph_View const *view;
+
+  /*! Workspace of a worker (only the one of the engine used is built). */
+  struct Workspace {
+    Dijkstra *search;
+    Lane_Dijkstra *lanes;
+    Phast *phast;
+    Bit_Parallel_Bfs *bfs;
+  };
+
+  /*! Hierarchy of the Phast workspaces (NULL if not built). */
+  Contraction_Hierarchy *ch;
+
+  /*! Workspaces, one per worker. */
+  std::vector<Workspace> workspaces;
+
+  /*! State of a run, shared by the workers. */
+  struct Run_State;
+
+  /*! Release the workspaces. */
+  void clear_engines();
+
+  /*!
+   * Build the workspace of a worker for the engine used, if needed, and set
+   * its view.
+   * \param w the workspace.
+   * \return the number of sources of a batch of the engine.
+   */
+  unsigned int prepare(Workspace &w);
+
+  /*!
+   * Compute the centralities of the sources of a worker.
+   * \param worker worker number.
+   * \param nbr_workers number of workers.
+   * \param context the Run_State.
+   */
+  static void run_slice(unsigned int worker, unsigned int nbr_workers,
+                        void *context);
+
+  /*! Not copyable. */
+  Closeness(Closeness const &);
+
+  /*! Not assignable. */
+  Closeness &operator=(Closeness const &);
+
+public:
+  /*! Number of vertices from which Phast is used for undirected graphs
+   * (below, building the hierarchy costs more than it saves). */
+  static unsigned int const phast_min_vertices = 1000;
+
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build the centralities of a graph, all at 0, and choose the engine.
+   * \param _graph graph, it must not be destroyed before the centralities.
+   * \pre \c _graph has no negative length.
+   */
+  Closeness(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays and the workspaces. */
+  ~Closeness();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*! \return the engine used. */
+  Engine get_engine() const { return engine; }
+
+  /*!
+   * Change the engine used.
+   * \param _engine engine.
+   * \pre Phast is only for undirected graphs without a view,
+   * Bit_Parallel_Bfs for graphs whose edges all have the same length.
+   */
+  void set_engine(Engine _engine);
+
+  /*!
+   * Set the view used by the next runs: only the edges of the view whose
+   * head is in the view are followed (see Graph_View), by every worker.
+   * \param _view view of the graph, which must outlive its use, or \c NULL
+   * for none.
+   */
+  void set_view(Graph_View const *_view);
+
+  /*!
+   * Set the number of workers of the next runs.
+   * \param nbr_workers number of workers (1 runs in the calling thread).
+   * \pre \c nbr_workers is at least 1.
+   */
+  void set_nbr_workers(unsigned int nbr_workers);
+
+  /*!
+   * Compute the centralities of a range of sources.
+   * \param first,last range of sources [first, last).
+   * \param progress callback after each batch of sources, or \c NULL.
+   * \param context given to \c progress.
+   * \pre \c first <= \c last <= number of vertices.
+   */
+  void run(unsigned int first, unsigned int last, Progress progress = NULL,
+           void *context = NULL);
+
+  /*! Compute the centralities of all the vertices. */
+  void run_all(Progress progress = NULL, void *context = NULL) {
+    run(0, graph.nbr_vertices, progress, context);
+  }
+
+  /*! \return the closeness of the vertices, by vertex number. */
+  float const *get_closeness() const { return closeness; }
+
+  /*! \return the harmonic centralities of the vertices, by vertex number. */
+  float const *get_harmonic() const { return harmonic; }
+};
+
+#endif
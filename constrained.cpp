@@ -0,0 +1,226 @@
+/*!
+ * \file
+ * \brief This module provides resource constrained shortest paths on Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // push_heap, pop_heap, reverse
+#include <functional> // greater
+#include <limits>
+#include <utility>
+
+#include "constrained.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Infinity (unreached). */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! End of a list of labels. */
+unsigned int const label_none = numeric_limits<unsigned int>::max();
+}
+
+Constrained_Search::Constrained_Search(Graph const &_graph)
+    : graph(_graph), offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      resources(new float[_graph.get_nbr_arcs()]),
+      in_offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      in_tails(new unsigned int[_graph.get_nbr_arcs()]),
+      in_positions(new unsigned int[_graph.get_nbr_arcs()]),
+      length_bounds(new float[_graph.nbr_vertices]),
+      resource_bounds(new float[_graph.nbr_vertices]),
+      heads(new unsigned int[_graph.nbr_vertices]), target(0),
+      max_resource(0), best(label_none), view(NULL) {
+  assert(!graph.has_negative_length());
+  // Resources, and number of arcs into each vertex
+  unsigned int position = 0;
+  for (unsigned int i = 0; i <= graph.nbr_vertices; i++) {
+    in_offsets[i] = 0;
+  }
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    offsets[i] = position;
+    Graph::VEdge const &edges = graph.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      resources[position++] = 0;
+      in_offsets[edges[k].first + 1]++;
+    }
+    heads[i] = label_none;
+  }
+  offsets[graph.nbr_vertices] = position;
+
+  // Arcs into each vertex
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    in_offsets[i + 1] += in_offsets[i];
+  }
+  vector<unsigned int> filled(in_offsets, in_offsets + graph.nbr_vertices);
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    Graph::VEdge const &edges = graph.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      unsigned int const p = filled[edges[k].first]++;
+      in_tails[p] = i;
+      in_positions[p] = k;
+    }
+  }
+}
+
+Constrained_Search::~Constrained_Search() {
+  delete[] offsets;
+  delete[] resources;
+  delete[] in_offsets;
+  delete[] in_tails;
+  delete[] in_positions;
+  delete[] length_bounds;
+  delete[] resource_bounds;
+  delete[] heads;
+}
+
+void Constrained_Search::bound(unsigned int to, bool is_resource,
+                               float *bounds) const {
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    bounds[i] = infinity;
+  }
+  // Heap of the smallest bound on top, the stale entries being skipped
+  vector<pair<float, unsigned int> > heap;
+  bounds[to] = 0;
+  heap.push_back(make_pair(0.0f, to));
+  while (!heap.empty()) {
+    pop_heap(heap.begin(), heap.end(), greater<pair<float, unsigned int> >());
+    float const d = heap.back().first;
+    unsigned int const v = heap.back().second;
+    heap.pop_back();
+    if (bounds[v] < d) {
+      continue;
+    }
+    for (unsigned int p = in_offsets[v]; p < in_offsets[v + 1]; p++) {
+      unsigned int const u = in_tails[p];
+      Graph::Edge const &e = graph.get_edges(u)[in_positions[p]];
+      // the arcs of the view from a tail in the view
+      if (Graph::is_removed(e) ||
+          (view != NULL && !(view->has_vertex(u) &&
+                             view->has_arc(u, in_positions[p], v)))) {
+        continue;
+      }
+      float const du = d + (is_resource
+                                ? resources[offsets[u] + in_positions[p]]
+                                : e.second);
+      if (du < bounds[u]) {
+        bounds[u] = du;
+        heap.push_back(make_pair(du, u));
+        push_heap(heap.begin(), heap.end(),
+                  greater<pair<float, unsigned int> >());
+      }
+    }
+  }
+}
+
+void Constrained_Search::add_label(unsigned int i, float length,
+                                   float resource, unsigned int parent) {
+  float const best_length =
+      (best == label_none) ? infinity : labels[best].length;
+  if (max_resource < resource + resource_bounds[i] ||
+      !(length + length_bounds[i] < best_length)) {
+    return;
+  }
+  // The labels at the target are not extended: only the best one is kept
+  if (i != target) {
+    // Walk the list of the vertex, taking out the dominated labels
+    unsigned int *link = &heads[i];
+    while (*link != label_none) {
+      Label &other = labels[*link];
+      if (other.length <= length && other.resource <= resource) {
+        return;
+      }
+      if (length <= other.length && resource <= other.resource) {
+        other.is_dead = true;
+        *link = other.next;
+      } else {
+        link = &other.next;
+      }
+    }
+  }
+  Label label;
+  label.length = length;
+  label.resource = resource;
+  label.vertex = i;
+  label.parent = parent;
+  label.next = heads[i];
+  label.is_dead = false;
+  if (i == target) {
+    best = labels.size();
+  } else {
+    if (heads[i] == label_none) {
+      touched.push_back(i);
+    }
+    heads[i] = labels.size();
+  }
+  labels.push_back(label);
+}
+
+float Constrained_Search::run(unsigned int from, unsigned int to,
+                              float _max_resource) {
+  assert(from < graph.nbr_vertices);
+  assert(to < graph.nbr_vertices);
+  assert(view == NULL || (&view->graph == &graph && view->has_vertex(from)));
+  for (size_t k = 0; k < touched.size(); k++) {
+    heads[touched[k]] = label_none;
+  }
+  touched.clear();
+  labels.clear();
+  target = to;
+  max_resource = _max_resource;
+  best = label_none;
+  if (!graph.is_connected(from, to)) {
+    return infinity;
+  }
+  bound(to, true, resource_bounds);
+  bound(to, false, length_bounds);
+
+  // The labels are treated in the order of their creation (first in, first
+  // out), the pool being the queue; the labels that cannot beat the best
+  // path found since their creation are not treated
+  add_label(from, 0, 0, 0);
+  for (unsigned int l = 0; l < labels.size(); l++) {
+    unsigned int const u = labels[l].vertex;
+    float const length = labels[l].length;
+    if (labels[l].is_dead || u == target ||
+        (best != label_none &&
+         !(length + length_bounds[u] < labels[best].length))) {
+      continue;
+    }
+    float const resource = labels[l].resource;
+    Graph::VEdge const &edges = graph.get_edges(u);
+    float const *const edge_resources = resources + offsets[u];
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (Graph::is_removed(edges[k]) ||
+          (view != NULL && !view->has_arc(u, k, edges[k].first))) {
+        continue;
+      }
+      add_label(edges[k].first, length + edges[k].second,
+                resource + edge_resources[k], l);
+    }
+  }
+  return (best == label_none) ? infinity : labels[best].length;
+}
+
+float Constrained_Search::get_resource_used() const {
+  return (best == label_none) ? infinity : labels[best].resource;
+}
+
+bool Constrained_Search::get_path(vector<unsigned int> &path) const {
+  path.clear();
+  if (best == label_none) {
+    return false;
+  }
+  unsigned int l = best;
+  while (labels[l].parent != l) {
+    path.push_back(labels[l].vertex);
+    l = labels[l].parent;
+  }
+  path.push_back(labels[l].vertex);
+  reverse(path.begin(), path.end());
+  return true;
+}
@@ -0,0 +1,219 @@
+#ifndef __CONSTRAINED_HPP_
+#define __CONSTRAINED_HPP_
+
+/*!
+ * \file
+ * \brief This module provides resource constrained shortest paths on Graph
+ * (e.g. the shortest path of an electric vehicle within its energy budget).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+class Graph_View;
+
+/*!
+ * \brief Search workspace for the shortest path between two vertices of a
+ * Graph whose resource consumed (the sum of the resources of its edges) is
+ * within a budget.
+ *
+ * The resources are a column along the edges of the graph (as the weights of
+ * a Profile), 0 unless set.
+ *
+ * Label-correcting search: a label is a path to a vertex, with its length and
+ * resource. The labels are held in one pool and treated in the order of their
+ * creation. Each vertex has a list, linked through the pool, of the labels not
+ * dominated (shorter or as long and consuming at most as much); a new label
+ * dominated by the list of its vertex is dropped, and the labels it dominates
+ * are taken out of the list and not treated.
+ *
+ * Before the labels, two searches from the target, along the arcs backwards,
+ * give lower bounds of the resource and of the length still to go from each
+ * vertex. A label is dropped as soon as its resource plus its bound is over
+ * budget, or its length plus its bound is not shorter than the best path
+ * found yet.
+ */
+class Constrained_Search {
+
+public:
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! A path to a vertex. */
+  class Label {
+  public:
+    float length;
+    float resource;
+    unsigned int vertex;
+    /*! Label of the path without its last edge (itself at the source). */
+    unsigned int parent;
+    /*! Next label of the list of the vertex. */
+    unsigned int next;
+    /*! Whether the label was taken out of the list of its vertex. */
+    bool is_dead;
+  };
+
+  /*! Array of the position of the resources of each vertex, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Array of the resources of the arcs, vertex by vertex. */
+  float *const resources;
+
+  /*! Array of the position of the arcs into each vertex, plus the end. */
+  unsigned int *const in_offsets;
+
+  /*! Array of the tails of the arcs into each vertex. */
+  unsigned int *const in_tails;
+
+  /*! Array of the positions of the arcs into each vertex, in get_edges. */
+  unsigned int *const in_positions;
+
+  /*! Array of the lower bounds of the length to the target, by vertex. */
+  float *const length_bounds;
+
+  /*! Array of the lower bounds of the resource to the target, by vertex. */
+  float *const resource_bounds;
+
+  /*! Array of the first label of the list of each vertex. */
+  unsigned int *const heads;
+
+  /*! Labels of the last query. */
+  std::vector<Label> labels;
+
+  /*! Vertices with a list in the last query (to reset them). */
+  std::vector<unsigned int> touched;
+
+  /*! Target of the last query. */
+  unsigned int target;
+
+  /*! Resource budget of the last query. */
+  float max_resource;
+
+  /*! Label of the best path found by the last query, if any. */
+  unsigned int best;
+
+  /*! View of the queries (NULL if none). */
+  Graph_View const *view;
+
+  /*!
+   * Compute lower bounds of the distance to a vertex, along the arcs
+   * backwards.
+   * \param to vertex.
+   * \param is_resource true for the resources, false for the lengths.
+   * \param bounds array filled with the bounds (infinity if not reachable).
+   */
+  void bound(unsigned int to, bool is_resource, float *bounds) const;
+
+  /*!
+   * Add a label, unless it is pruned or dominated.
+   * \param i vertex of the label.
+   * \param length,resource length and resource of the label.
+   * \param parent label of the path without its last edge.
+   */
+  void add_label(unsigned int i, float length, float resource,
+                 unsigned int parent);
+
+  /*! Not copyable. */
+  Constrained_Search(Constrained_Search const &);
+
+  /*! Not assignable. */
+  Constrained_Search &operator=(Constrained_Search const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace, with 0 as resources.
+   * \param _graph graph, it must not be destroyed before the workspace, nor
+   * get new edges.
+   * \pre \c _graph has no negative length.
+   */
+  Constrained_Search(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Constrained_Search();
+
+  //
+  //  RESOURCES
+  //
+
+  /*!
+   * Set the resource of an edge, in one direction: the reverse edge of an
+   * undirected graph keeps its own resource.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param resource new resource.
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \pre \c resource is positive or zero.
+   */
+  void set_resource(unsigned int i, size_t k, float resource) {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    assert(0 <= resource);
+    resources[offsets[i] + k] = resource;
+  }
+
+  /*!
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \return the resource of the edge.
+   */
+  float get_resource(unsigned int i, size_t k) const {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    return resources[offsets[i] + k];
+  }
+
+  //
+  //  QUERIES
+  //
+
+  /*!
+   * Search the shortest path within a resource budget.
+   * \param from,to endpoints.
+   * \param _max_resource budget.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \return the length of the path, infinity if there is none within the
+   * budget.
+   */
+  float run(unsigned int from, unsigned int to, float _max_resource);
+
+  /*!
+   * \return the resource consumed by the path found by the last query, or
+   * infinity if none.
+   */
+  float get_resource_used() const;
+
+  /*!
+   * Path found by the last query.
+   * \param path filled with the vertices of the path, from the source.
+   * \return false (and leave \c path empty) iff no path was found.
+   */
+  bool get_path(std::vector<unsigned int> &path) const;
+
+  /*! \return the number of labels created by the last query. */
+  unsigned int get_nbr_labels() const { return labels.size(); }
+
+  /*!
+   * Set the view used by the next queries: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the queries are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+};
+
+#endif
@@ -0,0 +1,168 @@
+/*!
+ * \file
+ * \brief This module provides the diameter of an undirected Graph (iFUB).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // max, min
+#include <limits>
+
+#include "diameter.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+Diameter::Diameter(Graph const &_graph)
+    // Fewest edges are shortest when all the edges have the same length
+    : graph(_graph),
+      search(_graph.has_common_length() ? NULL : new Dijkstra(_graph)),
+      bfs(_graph.has_common_length() ? new Bfs(_graph) : NULL), lower(0),
+      upper(0), nbr_searches(0), max_searches(0), progress(NULL),
+      context(NULL), view(NULL) {
+  assert(!graph.is_directed);
+  ends[0] = ends[1] = 0;
+}
+
+Diameter::~Diameter() {
+  delete search;
+  delete bfs;
+}
+
+void Diameter::set_view(Graph_View const *_view) {
+  assert(_view == NULL || &_view->graph == &graph);
+  view = _view;
+  if (bfs != NULL) {
+    bfs->set_view(view);
+  } else {
+    search->set_view(view);
+  }
+}
+
+void Diameter::search_from(unsigned int from) {
+  if (bfs != NULL) {
+    bfs->run(from, graph.nbr_vertices);
+  } else {
+    search->one_to_all(from);
+  }
+}
+
+float Diameter::get_distance(unsigned int i) const {
+  if (bfs == NULL) {
+    return search->get_distance(i);
+  }
+  unsigned int const hops = bfs->get_hops(i);
+  return (hops == Bfs::unreached) ? numeric_limits<float>::infinity()
+                                  : hops * graph.get_common_length();
+}
+
+unsigned int Diameter::sweep(unsigned int from) {
+  search_from(from);
+  nbr_searches++;
+  // The last vertex reached is the farthest
+  unsigned int const farthest = get_order().back();
+  float const eccentricity = get_distance(farthest);
+  if (lower < eccentricity) {
+    lower = eccentricity;
+    ends[0] = from;
+    ends[1] = farthest;
+  }
+  return farthest;
+}
+
+void Diameter::run_component(unsigned int from) {
+  // The bounds of the other components are kept: the upper bound of this
+  // one is only known at the end
+  float const other_upper = upper;
+  upper = numeric_limits<float>::infinity();
+
+  // DOUBLE SWEEP, and the middle of the path found
+  unsigned int const a = sweep(from);
+  unsigned int const b = sweep(a);
+  float const half = get_distance(b) / 2;
+  vector<unsigned int> path;
+  if (bfs != NULL) {
+    bfs->get_path(b, path);
+  } else {
+    search->get_path(b, path);
+  }
+  unsigned int u = a;
+  for (size_t k = 0; k < path.size(); k++) {
+    if (get_distance(path[k]) <= half) {
+      u = path[k];
+    }
+  }
+
+  // FRINGES: the vertices by decreasing distance to u
+  search_from(u);
+  nbr_searches++;
+  vector<unsigned int> const order = get_order();
+  vector<float> distances(order.size());
+  for (size_t k = 0; k < order.size(); k++) {
+    distances[k] = get_distance(order[k]);
+  }
+  // Eccentricity of u: its farthest vertex
+  if (lower < distances.back()) {
+    lower = distances.back();
+    ends[0] = u;
+    ends[1] = order.back();
+  }
+  upper = min(upper, 2 * distances.back());
+  if (progress != NULL) {
+    progress(lower, max(upper, other_upper), nbr_searches, context);
+  }
+  for (size_t k = order.size(); 0 < k && lower < upper; k--) {
+    // The vertices before k are within 2 distances[k - 1] of each other,
+    // the ones after are done
+    upper = max(lower, 2 * distances[k - 1]);
+    if (upper <= lower || is_over_budget()) {
+      break;
+    }
+    sweep(order[k - 1]);
+    if (progress != NULL) {
+      progress(lower, max(upper, other_upper), nbr_searches, context);
+    }
+  }
+  upper = max(upper, other_upper);
+}
+
+float Diameter::run(unsigned int from) {
+  assert(from < graph.nbr_vertices);
+  lower = 0;
+  upper = 0;
+  ends[0] = ends[1] = from;
+  nbr_searches = 0;
+  run_component(from);
+  return lower;
+}
+
+float Diameter::run_all() {
+  lower = 0;
+  upper = 0;
+  ends[0] = ends[1] = 0;
+  nbr_searches = 0;
+  // The components of a view are not those of the graph: a vertex of the
+  // view not reached yet starts a new one
+  vector<bool> is_reached(view == NULL ? 0 : graph.nbr_vertices, false);
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    if (view == NULL ? graph.get_component(i) != i
+                     : !view->has_vertex(i) || is_reached[i]) {
+      continue;
+    }
+    if (is_over_budget()) {
+      // A component left out may be the widest
+      upper = numeric_limits<float>::infinity();
+      break;
+    }
+    run_component(i);
+    if (view != NULL) {
+      // Every search of the component reaches all of it
+      vector<unsigned int> const &order = get_order();
+      for (size_t k = 0; k < order.size(); k++) {
+        is_reached[order[k]] = true;
+      }
+    }
+  }
+  return lower;
+}
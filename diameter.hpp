@@ -0,0 +1,208 @@
+#ifndef __DIAMETER_HPP_
+#define __DIAMETER_HPP_
+
+/*!
+ * \file
+ * \brief This module provides the diameter of an undirected Graph with few
+ * searches (iFUB), or bounds of it within a budget of searches.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "bfs.hpp"
+#include "dijkstra.hpp"
+
+/*!
+ * \brief Diameter of an undirected Graph: the largest distance between two
+ * connected vertices.
+ *
+ * The iFUB algorithm (iterative fringe upper bound), on each connected
+ * component:
+ * \li a double sweep (search from a vertex, then from the vertex farthest
+ * from it) gives a lower bound, its eccentricity, and a path of that length;
+ * \li from \c u, the middle of that path, the vertices are taken by
+ * decreasing distance to \c u, and their eccentricities raise the lower
+ * bound;
+ * \li two vertices not taken yet are within 2 d(u, x) of each other, \c x
+ * being the next vertex to take: this is the upper bound, and the search
+ * stops when it meets the lower bound.
+ *
+ * On road networks and small-world graphs, a few dozen searches are
+ * typically enough. Each search is a breadth-first search (Bfs) if all the
+ * edges have the same length, a Dijkstra one-to-all query otherwise.
+ */
+class Diameter {
+
+public:
+  /*!
+   * Progress callback, after each search.
+   * \param lower,upper bounds of the diameter so far.
+   * \param nbr_searches number of searches so far.
+   * \param context context given to run.
+   */
+  typedef void (*Progress)(float lower, float upper,
+                           unsigned int nbr_searches, void *context);
+
+  /*! The graph. */
+  Graph const &graph;
+
+private:
+  /*! Search workspace, \c NULL if \c bfs is used. */
+  Dijkstra *const search;
+
+  /*! Breadth-first search workspace, if all the edges have the same
+   * length (else \c NULL). */
+  Bfs *const bfs;
+
+  /*! Lower bound of the diameter: the distance between \c ends. */
+  float lower;
+
+  /*! Upper bound of the diameter. */
+  float upper;
+
+  /*! Two vertices at distance \c lower. */
+  unsigned int ends[2];
+
+  /*! Number of searches of the last run. */
+  unsigned int nbr_searches;
+
+  /*! Largest number of searches of a run, 0 for no limit. */
+  unsigned int max_searches;
+
+  /*! Progress callback (\c NULL if none) and its context. */
+  Progress progress;
+  void *context;
+
+  /*! View of the searches (NULL if none). */
+  Graph_View const *view;
+
+  /*! Search from a vertex, with \c bfs if set, else \c search. */
+  void search_from(unsigned int from);
+
+  /*! \return the distance to \c i found by the last search. */
+  float get_distance(unsigned int i) const;
+
+  /*! \return the vertices reached by the last search, by increasing
+   * distance. */
+  std::vector<unsigned int> const &get_order() const {
+    return bfs != NULL ? bfs->get_reached() : search->get_treated();
+  }
+
+  /*!
+   * Search from a vertex and raise the lower bound with its eccentricity.
+   * \param from vertex.
+   * \return the vertex farthest from \c from.
+   */
+  unsigned int sweep(unsigned int from);
+
+  /*!
+   * Bound the diameter of a connected component, raising the bounds.
+   * \param from vertex of the component.
+   */
+  void run_component(unsigned int from);
+
+  /*! \return true iff the budget of searches is spent. */
+  bool is_over_budget() const {
+    return 0 < max_searches && max_searches <= nbr_searches;
+  }
+
+  /*! Not copyable. */
+  Diameter(Diameter const &);
+
+  /*! Not assignable. */
+  Diameter &operator=(Diameter const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace for the diameter of \c _graph.
+   * \param _graph graph, it must not be destroyed before the workspace.
+   * \pre \c _graph is undirected.
+   */
+  Diameter(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the workspace. */
+  ~Diameter();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Set the largest number of searches of the next runs: when it is reached,
+   * the bounds found so far are returned. The double sweep and the search
+   * from the middle of a component are always done (3 searches).
+   * \param _max_searches number of searches, 0 for no limit.
+   */
+  void set_max_searches(unsigned int _max_searches) {
+    max_searches = _max_searches;
+  }
+
+  /*!
+   * Set the progress callback of the next runs.
+   * \param _progress callback, or \c NULL for none.
+   * \param _context given to \c _progress.
+   */
+  void set_progress(Progress _progress, void *_context) {
+    progress = _progress;
+    context = _context;
+  }
+
+  /*!
+   * Set the view used by the next runs: only the edges of the view whose
+   * head is in the view are followed (see Graph_View), and the diameter is
+   * the one of the subgraph of the view.
+   * \param _view view of the graph, which must outlive its use, or \c NULL
+   * for none.
+   */
+  void set_view(Graph_View const *_view);
+
+  /*!
+   * Bound the diameter of the connected component of a vertex.
+   * \param from vertex.
+   * \pre \c from is a legal vertex number, in the view if any.
+   * \return the diameter of the component (the lower bound if the budget
+   * ran out).
+   */
+  float run(unsigned int from);
+
+  /*!
+   * Bound the diameter of the graph (of all its components, as given by
+   * Graph::get_component: compact the graph first if edges were removed),
+   * or of the view (of all its components, found by the searches).
+   * \return the diameter (the lower bound if the budget ran out).
+   */
+  float run_all();
+
+  /*! \return the lower bound found by the last run. */
+  float get_lower_bound() const { return lower; }
+
+  /*! \return the upper bound found by the last run (the diameter if equal
+   * to the lower bound). */
+  float get_upper_bound() const { return upper; }
+
+  /*! \return true iff the last run found the diameter exactly. */
+  bool is_exact() const { return lower == upper; }
+
+  /*!
+   * \param k 0 or 1.
+   * \return an end of a path of length get_lower_bound().
+   */
+  unsigned int get_end(unsigned int k) const {
+    assert(k < 2);
+    return ends[k];
+  }
+
+  /*! \return the number of searches of the last run. */
+  unsigned int get_nbr_searches() const { return nbr_searches; }
+};
+
+#endif
@@ -0,0 +1,383 @@
+/*!
+ * \file
+ * \brief This module provides Dijkstra's algorithm on Graph as a reusable
+ * search workspace.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // reverse
+#include <limits>
+
+#include <time.h>
+
+#include "dijkstra.hpp"
+#include "profile.hpp"
+#include "view.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DIJKSTRA_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/*! Constant to indicate that the node is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the node was treated. */
+int const id_treated = -2;
+
+/*! Distance of the vertices not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! Number of edges ahead of the relaxed one whose heads are prefetched. */
+size_t const prefetch_distance = 4;
+
+/*! Least degree of the vertices whose edges are relaxed in batches. */
+size_t const batch_min_degree = 16;
+
+/*! Number of vertices treated between two readings of the clock. */
+unsigned int const time_check_period = 64;
+
+/*! \return the time in seconds (monotonic clock). */
+double now_s() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*!
+ * Find the edges that lower the distance of their head, without potentials.
+ * \param edges array of the edges of the treated vertex.
+ * \param nbr_edges number of edges.
+ * \param keys keys of the vertices.
+ * \param du distance of the treated vertex.
+ * \param lowered filled with the positions of the edges such that
+ * du + length < keys[head].distance, in increasing order.
+ * \return the number of positions in \c lowered.
+ */
+size_t find_lowered_scalar(Graph::Edge const *edges, size_t nbr_edges,
+                           Dijkstra::Vertex_Key const *keys, float du,
+                           unsigned int *lowered) {
+  size_t nbr_lowered = 0;
+  for (size_t k = 0; k < nbr_edges; k++) {
+    // Branch free: the position is always written, and kept if lowered
+    lowered[nbr_lowered] = k;
+    nbr_lowered += du + edges[k].second < keys[edges[k].first].distance;
+  }
+  return nbr_lowered;
+}
+
+#ifdef DIJKSTRA_AVX2
+/*!
+ * Same as find_lowered_scalar, 8 edges at a time: the distances of the heads
+ * are gathered, compared to the candidates, and the positions of the lowered
+ * ones are compressed from the comparison mask.
+ */
+__attribute__((target("avx2"))) size_t
+find_lowered_avx2(Graph::Edge const *edges, size_t nbr_edges,
+                  Dijkstra::Vertex_Key const *keys, float du,
+                  unsigned int *lowered) {
+  __m256 const vu = _mm256_set1_ps(du);
+  float const *const distances = &keys[0].distance;
+  size_t nbr_lowered = 0;
+  size_t k = 0;
+  for (; k + 8 <= nbr_edges; k += 8) {
+    // (head, length) pairs of 8 edges, split into heads and lengths
+    float const *const p = reinterpret_cast<float const *>(edges + k);
+    __m256 const lo = _mm256_loadu_ps(p);
+    __m256 const hi = _mm256_loadu_ps(p + 8);
+    __m256i const heads = _mm256_permute4x64_epi64(
+        _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))),
+        _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 const lengths = _mm256_castpd_ps(_mm256_permute4x64_pd(
+        _mm256_castps_pd(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))),
+        _MM_SHUFFLE(3, 1, 2, 0)));
+    __m256 const dv =
+        _mm256_i32gather_ps(distances, heads, sizeof(Dijkstra::Vertex_Key));
+    __m256 const candidate = _mm256_add_ps(vu, lengths);
+    unsigned int mask =
+        _mm256_movemask_ps(_mm256_cmp_ps(candidate, dv, _CMP_LT_OQ));
+    for (; mask != 0; mask &= mask - 1) {
+      lowered[nbr_lowered++] = k + __builtin_ctz(mask);
+    }
+  }
+  for (; k < nbr_edges; k++) {
+    lowered[nbr_lowered] = k;
+    nbr_lowered += du + edges[k].second < keys[edges[k].first].distance;
+  }
+  return nbr_lowered;
+}
+#endif
+
+/*! Type of the searches of lowered edges. */
+typedef size_t (*Find_Lowered)(Graph::Edge const *, size_t,
+                               Dijkstra::Vertex_Key const *, float,
+                               unsigned int *);
+
+/*! \return the search of lowered edges to use, according to the processor. */
+Find_Lowered pick_find_lowered() {
+#ifdef DIJKSTRA_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return find_lowered_avx2;
+  }
+#endif
+  return find_lowered_scalar;
+}
+
+/*! Search of lowered edges used, chosen once. */
+Find_Lowered const find_lowered = pick_find_lowered();
+}
+
+Dijkstra::Dijkstra(Graph const &_graph)
+    : graph(_graph), heap(_graph.nbr_vertices),
+      keys(new Vertex_Key[_graph.nbr_vertices]),
+      parents(new unsigned int[_graph.nbr_vertices]),
+      heap_ids(new int[_graph.nbr_vertices]), source(0),
+      target(_graph.nbr_vertices), radius(infinity), nbr_scanned(0),
+      deadline(0), status(status_complete), potentials(NULL),
+      profile(NULL), view(NULL) {
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    keys[i].distance = infinity;
+    keys[i].i = i;
+    parents[i] = i;
+    heap_ids[i] = id_undefined;
+  }
+}
+
+Dijkstra::~Dijkstra() {
+  delete[] keys;
+  delete[] parents;
+  delete[] heap_ids;
+}
+
+void Dijkstra::start(unsigned int from, unsigned int _target,
+                     float _radius) {
+  assert(from < graph.nbr_vertices);
+  assert(potentials != NULL || !graph.has_negative_length());
+  assert(potentials == NULL || profile == NULL);
+  assert(profile == NULL || &profile->graph == &graph);
+  assert(view == NULL || (&view->graph == &graph && view->has_vertex(from)));
+  for (size_t k = 0; k < touched.size(); k++) {
+    unsigned int i = touched[k];
+    keys[i].distance = infinity;
+    parents[i] = i;
+    heap_ids[i] = id_undefined;
+  }
+  touched.clear();
+  heap.clear();
+
+  source = from;
+  target = _target;
+  radius = _radius;
+  treated.clear();
+  nbr_scanned = 0;
+  if (0 < budget.max_seconds) {
+    deadline = now_s() + budget.max_seconds;
+  }
+  keys[from].distance = 0;
+  touched.push_back(from);
+  if (target < graph.nbr_vertices && !graph.is_connected(from, target)) {
+    // Unreachable: no need to explore the component of from
+    status = status_complete;
+    return;
+  }
+  heap_ids[from] = heap.push(keys[from]);
+  status = status_running;
+  update_status();
+}
+
+void Dijkstra::relax(unsigned int u, unsigned int v, float dv) {
+  // Vertices not reached are at infinity, so removed edges (infinitely
+  // long) never get through
+  if (!(dv < keys[v].distance)) {
+    return;
+  }
+  keys[v].distance = dv;
+  parents[v] = u;
+  if (heap_ids[v] == id_undefined) {
+    heap_ids[v] = heap.push(keys[v]);
+    touched.push_back(v);
+  } else {
+    heap.reposition(heap_ids[v]);
+  }
+}
+
+unsigned int Dijkstra::treat_next() {
+  // Get the vertex at minimal distance
+  unsigned int const u = heap.pop().i;
+  float const du = keys[u].distance;
+  heap_ids[u] = id_treated;
+  treated.push_back(u);
+
+  // Relax its edges
+  Graph::VEdge const &edges = graph.get_edges(u);
+  nbr_scanned += edges.size();
+#ifndef DIJKSTRA_NO_PREFETCH
+  // Adjacency of the next vertex to treat, likely the one at the top now
+  if (!heap.is_empty()) {
+    Graph::VEdge const &next = graph.get_edges(heap.top().i);
+    if (!next.empty()) {
+      __builtin_prefetch(&next[0]);
+    }
+  }
+#endif
+#ifndef DIJKSTRA_NO_BATCH_RELAX
+  if (batch_min_degree <= edges.size() && potentials == NULL &&
+      profile == NULL && view == NULL) {
+    // High degree: the heads with a lowered distance are picked out in
+    // batches, then only they are updated
+    if (lowered.size() < edges.size()) {
+      lowered.resize(edges.size());
+    }
+    size_t const nbr_lowered =
+        find_lowered(&edges[0], edges.size(), keys, du, &lowered[0]);
+    for (size_t k = 0; k < nbr_lowered; k++) {
+#ifndef DIJKSTRA_NO_PREFETCH
+      if (k + prefetch_distance < nbr_lowered) {
+        prefetch_state(edges[lowered[k + prefetch_distance]].first);
+      }
+#endif
+      Graph::Edge const &e = edges[lowered[k]];
+      relax(u, e.first, du + e.second);
+    }
+    return u;
+  }
+#endif
+#ifndef DIJKSTRA_NO_PREFETCH
+  for (size_t k = 0; k < edges.size() && k < prefetch_distance; k++) {
+    prefetch_state(edges[k].first);
+  }
+#endif
+  // Weights and modes of the edges, with a profile
+  float const *const weights =
+      (profile == NULL) ? NULL : profile->get_weights(u);
+  Graph::Modes const *const modes =
+      (profile == NULL || edges.empty()) ? NULL : &graph.get_modes(u)[0];
+  for (size_t k = 0; k < edges.size(); k++) {
+#ifndef DIJKSTRA_NO_PREFETCH
+    // Pipeline: the search state of the head prefetch_distance edges ahead,
+    // then its heap position once its heap id is in cache
+    if (k + prefetch_distance < edges.size()) {
+      prefetch_state(edges[k + prefetch_distance].first);
+    }
+    if (k + prefetch_distance / 2 < edges.size()) {
+      int const id = heap_ids[edges[k + prefetch_distance / 2].first];
+      if (0 <= id) {
+        heap.prefetch(id);
+      }
+    }
+#endif
+    // Tombstones have an infinite length, but not an infinite weight
+    if (modes != NULL &&
+        ((modes[k] & profile->modes) == 0 || Graph::is_removed(edges[k]))) {
+      continue;
+    }
+    unsigned int const v = edges[k].first;
+    if (view != NULL && !view->has_arc(u, k, v)) {
+      continue;
+    }
+    float dv = du + ((weights == NULL) ? edges[k].second : weights[k]);
+    if (potentials != NULL) {
+      // Reduced length, rounding errors may make it slightly negative
+      dv += potentials[u] - potentials[v];
+      dv = (dv < du) ? du : dv;
+    }
+    relax(u, v, dv);
+  }
+  return u;
+}
+
+float Dijkstra::shortest_distance(unsigned int from, unsigned int to) {
+  start_point_to_point(from, to);
+  while (!resume(graph.nbr_vertices)) {
+  }
+  return get_distance(to);
+}
+
+void Dijkstra::one_to_all(unsigned int from) {
+  start_one_to_all(from);
+  while (!resume(graph.nbr_vertices)) {
+  }
+}
+
+void Dijkstra::isochrone(unsigned int from, float radius,
+                         vector<unsigned int> &reached) {
+  start_isochrone(from, radius);
+  while (!resume(graph.nbr_vertices)) {
+  }
+  reached = treated;
+}
+
+void Dijkstra::start_point_to_point(unsigned int from, unsigned int to) {
+  assert(to < graph.nbr_vertices);
+  start(from, to, infinity);
+}
+
+void Dijkstra::start_one_to_all(unsigned int from) {
+  start(from, graph.nbr_vertices, infinity);
+}
+
+void Dijkstra::start_isochrone(unsigned int from, float radius) {
+  assert(potentials == NULL);
+  start(from, graph.nbr_vertices, radius);
+}
+
+void Dijkstra::update_status() {
+  if (heap.is_empty() ||
+      (target < graph.nbr_vertices && heap_ids[target] == id_treated) ||
+      radius < heap.top().distance) {
+    status = status_complete;
+  } else if (0 < budget.max_treated && budget.max_treated <= treated.size()) {
+    status = status_over_treated;
+  } else if (0 < budget.max_scanned && budget.max_scanned <= nbr_scanned) {
+    status = status_over_scanned;
+  } else if (0 < budget.max_seconds &&
+             treated.size() % time_check_period == 0 && deadline <= now_s()) {
+    status = status_over_time;
+  }
+}
+
+bool Dijkstra::resume(unsigned int max_treated) {
+  for (unsigned int k = 0; k < max_treated && status == status_running; k++) {
+    treat_next();
+    update_status();
+  }
+  return is_finished();
+}
+
+float Dijkstra::get_lower_bound() const {
+  return heap.is_empty() ? infinity : heap.top().distance;
+}
+
+bool Dijkstra::is_treated(unsigned int i) const {
+  assert(i < graph.nbr_vertices);
+  return heap_ids[i] == id_treated;
+}
+
+float Dijkstra::get_distance(unsigned int i) const {
+  assert(i < graph.nbr_vertices);
+  if (potentials != NULL) {
+    return keys[i].distance - potentials[source] + potentials[i];
+  }
+  return keys[i].distance;
+}
+
+bool Dijkstra::get_path(unsigned int to, vector<unsigned int> &path) const {
+  assert(to < graph.nbr_vertices);
+  path.clear();
+  if (keys[to].distance == infinity) {
+    return false;
+  }
+  for (unsigned int i = to; i != source; i = parents[i]) {
+    path.push_back(i);
+  }
+  path.push_back(source);
+  reverse(path.begin(), path.end());
+  return true;
+}
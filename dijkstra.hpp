@@ -0,0 +1,391 @@
+#ifndef __DIJKSTRA_HPP_
+#define __DIJKSTRA_HPP_
+
+/*!
+ * \file
+ * \brief This module provides Dijkstra's algorithm on Graph as a reusable
+ * search workspace: queries return their results instead of printing them.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+#include "heap_id.hpp"
+
+class Graph_View;
+class Profile;
+
+/*!
+ * \brief Search workspace for Dijkstra's algorithm on a Graph.
+ *
+ * The arrays (one cell per vertex) and the heap are allocated once and
+ * reused by every query. Only the vertices touched by the previous query are
+ * reset, so that a short query costs nothing in proportion to the graph size.
+ *
+ * The results of the last query (distances, parents, paths) can be read until
+ * the next query is started.
+ *
+ * The relaxation of the edges of a vertex prefetches the search state of the
+ * heads a few edges ahead, then their heap positions, and the adjacency of
+ * the next vertex to treat (disabled by defining DIJKSTRA_NO_PREFETCH).
+ *
+ * The edges of a vertex of high degree are relaxed in batches instead: the
+ * distances of the heads are gathered and compared with vector instructions
+ * (AVX2 when the processor has it), and only the heads whose distance is
+ * lowered are updated (disabled by defining DIJKSTRA_NO_BATCH_RELAX).
+ *
+ * The searches may be restricted to a Graph_View, follow a Profile, or use
+ * potentials.
+ */
+class Dijkstra {
+
+public:
+  /*!
+   * Value held in the heap for a vertex:
+   * \li lower distance found to get to the vertex, yet, and
+   * \li vertex number.
+   */
+  class Vertex_Key {
+  public:
+    /*! Lower distance found to get to i, yet (infinity if not reached). */
+    float distance;
+
+    /*! Vertex number. */
+    unsigned int i;
+
+    /*! Comparison according to distance. */
+    bool operator<(Vertex_Key const &vk2) const {
+      return distance < vk2.distance;
+    }
+
+    /*! Comparison according to distance. */
+    bool operator<=(Vertex_Key const &vk2) const {
+      return distance <= vk2.distance;
+    }
+  };
+
+  /*!
+   * Limits of a query, a limit at 0 meaning no limit.
+   */
+  class Budget {
+  public:
+    /*! Maximal number of vertices treated. */
+    unsigned int max_treated;
+
+    /*! Maximal number of edges scanned. */
+    unsigned int max_scanned;
+
+    /*! Maximal wall time, in seconds. */
+    double max_seconds;
+
+    /*! Build a budget without limit. */
+    Budget() : max_treated(0), max_scanned(0), max_seconds(0) {}
+  };
+
+  /*! State of a query. */
+  enum Status {
+    /*! Not finished yet. */
+    status_running,
+    /*! Finished: its results are final. */
+    status_complete,
+    /*! Stopped on Budget::max_treated. */
+    status_over_treated,
+    /*! Stopped on Budget::max_scanned. */
+    status_over_scanned,
+    /*! Stopped on Budget::max_seconds. */
+    status_over_time
+  };
+
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! Heap of the reached but not treated vertices. */
+  Heap_Id<Vertex_Key> heap;
+
+  /*! Array of the keys, indexed by vertex number. */
+  Vertex_Key *const keys;
+
+  /*! Array of the vertices to come from to get the distance in \c keys. */
+  unsigned int *const parents;
+
+  /*! Array of the heap ids of the vertices, or id_undefined / id_treated. */
+  int *const heap_ids;
+
+  /*! Vertices modified by the last query (to reset them). */
+  std::vector<unsigned int> touched;
+
+  /*! Source of the last query. */
+  unsigned int source;
+
+  /*! Target of the last query, \c graph.nbr_vertices if none. */
+  unsigned int target;
+
+  /*! Maximal distance of the last query, infinity if none. */
+  float radius;
+
+  /*! Positions of the edges lowering their head, for batch relaxation. */
+  std::vector<unsigned int> lowered;
+
+  /*! Vertices treated by the last query, in the order of treatment. */
+  std::vector<unsigned int> treated;
+
+  /*! Number of edges scanned by the last query. */
+  unsigned int nbr_scanned;
+
+  /*! Limits of the queries. */
+  Budget budget;
+
+  /*! Time at which the last query runs out of time, in seconds. */
+  double deadline;
+
+  /*! State of the last query. */
+  Status status;
+
+  /*! Potentials of the vertices (NULL if none): lengths are reduced to
+   * len + potentials[i] - potentials[j] for an arc from i to j. */
+  float const *potentials;
+
+  /*! Profile of the searches (NULL if none): only its edges are followed,
+   * with its weights as lengths. */
+  Profile const *profile;
+
+  /*! View of the searches (NULL if none): only its vertices and edges are
+   * followed. */
+  Graph_View const *view;
+
+  /*!
+   * Reset the vertices touched by the previous query and put \c from in the
+   * heap at distance 0.
+   * \param from source vertex.
+   * \param _target target vertex, \c graph.nbr_vertices if none.
+   * \param _radius maximal distance, infinity if none.
+   * \pre \c from is a legal vertex number.
+   */
+  void start(unsigned int from, unsigned int _target, float _radius);
+
+  /*!
+   * Lower the distance of \c v to \c dv, through \c u, if shorter (and put
+   * \c v in the heap if not yet reached).
+   * \pre \c v is not treated or \c dv is not shorter.
+   */
+  void relax(unsigned int u, unsigned int v, float dv);
+
+  /*!
+   * Treat the vertex at minimal distance in the heap: relax its edges.
+   * \pre The heap is not empty.
+   * \return the treated vertex.
+   */
+  unsigned int treat_next();
+
+  /*!
+   * Prefetch the search state of a vertex (key, parent, heap id).
+   * \param i vertex number.
+   */
+  void prefetch_state(unsigned int i) const {
+    __builtin_prefetch(keys + i);
+    __builtin_prefetch(parents + i);
+    __builtin_prefetch(heap_ids + i);
+    if (potentials != NULL) {
+      __builtin_prefetch(potentials + i);
+    }
+  }
+
+  /*!
+   * Check whether the last query is finished or out of budget. The clock is
+   * only read every few treated vertices.
+   */
+  void update_status();
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _graph.
+   * \param _graph graph to search, it must not be destroyed before the
+   * workspace.
+   */
+  Dijkstra(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Dijkstra();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Point-to-point query: the search stops as soon as \c to is treated.
+   * If \c to is in another connected component, nothing is searched.
+   * \param from,to endpoints of the path to search.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \return the distance from \c from to \c to (infinity if unreachable),
+   * or the best distance known if the budget ran out (see get_status).
+   */
+  float shortest_distance(unsigned int from, unsigned int to);
+
+  /*!
+   * One-to-all query: compute the distance from \c from to every vertex.
+   * \param from source vertex.
+   * \pre \c from is a legal vertex number.
+   */
+  void one_to_all(unsigned int from);
+
+  /*!
+   * Isochrone query: compute the vertices within \c radius of \c from.
+   * \param from source vertex.
+   * \param radius maximal distance.
+   * \param reached filled with the vertices at distance at most \c radius,
+   * by increasing distance.
+   * \pre \c from is a legal vertex number.
+   */
+  void isochrone(unsigned int from, float radius,
+                 std::vector<unsigned int> &reached);
+
+  //
+  //  RESUMABLE QUERIES
+  //
+  //  A query is started, then carried on by slices with resume till it is
+  //  finished; this lets a scheduler interleave several workspaces.
+  //
+
+  /*!
+   * Start a point-to-point query (as shortest_distance).
+   * \pre \c from and \c to are legal vertex numbers.
+   */
+  void start_point_to_point(unsigned int from, unsigned int to);
+
+  /*!
+   * Start a one-to-all query (as one_to_all).
+   * \pre \c from is a legal vertex number.
+   */
+  void start_one_to_all(unsigned int from);
+
+  /*!
+   * Start an isochrone query (as isochrone), the vertices reached are the
+   * ones of get_treated.
+   * \pre \c from is a legal vertex number.
+   * \pre there are no potentials.
+   */
+  void start_isochrone(unsigned int from, float radius);
+
+  /*!
+   * Carry on the current query.
+   * \param max_treated maximal number of vertices to treat.
+   * \return true iff the query is finished.
+   */
+  bool resume(unsigned int max_treated);
+
+  /*! \return true iff the current query is finished (or out of budget). */
+  bool is_finished() const { return status != status_running; }
+
+  //
+  //  BUDGET
+  //
+
+  /*!
+   * Set the limits of the next queries. A query out of budget is stopped
+   * with a status telling which limit was hit; its results (distances, paths
+   * and treated vertices) are the partial ones found so far.
+   * \param _budget limits.
+   */
+  void set_budget(Budget const &_budget) { budget = _budget; }
+
+  //
+  //  POTENTIALS
+  //
+
+  /*!
+   * Set the potentials used by the next queries, for graphs with negative
+   * lengths: each arc from \c i to \c j is searched with the reduced length
+   * len + potentials[i] - potentials[j]. Reduced lengths must be
+   * non-negative (see Johnson, which computes such potentials).
+   * \param _potentials array of the potentials of the vertices, which must
+   * outlive their use, or \c NULL for none.
+   */
+  void set_potentials(float const *_potentials) { potentials = _potentials; }
+
+  //
+  //  PROFILE
+  //
+
+  /*!
+   * Set the profile used by the next queries: only the edges allowed for its
+   * modes are followed, with its weights instead of the lengths.
+   * \param _profile profile of the graph searched, which must outlive its
+   * use, or \c NULL for none.
+   * \pre there are no potentials (they are for the lengths).
+   */
+  void set_profile(Profile const *_profile) { profile = _profile; }
+
+  //
+  //  VIEW
+  //
+
+  /*!
+   * Set the view used by the next queries: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the queries are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+
+  /*! \return the state of the last query. */
+  Status get_status() const { return status; }
+
+  /*! \return the number of edges scanned by the last query. */
+  unsigned int get_nbr_scanned() const { return nbr_scanned; }
+
+  /*!
+   * \return a lower bound of the distance to the vertices not treated by the
+   * last query (infinity if there is none reachable), reduced by the
+   * potentials if any.
+   */
+  float get_lower_bound() const;
+
+  /*!
+   * To know if a vertex was treated by the last query, i.e. if its distance
+   * is final.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   */
+  bool is_treated(unsigned int i) const;
+
+  /*!
+   * Distance found by the last query.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the lower distance found to get to \c i (infinity if not
+   * reached). It is the actual distance, even with potentials.
+   */
+  float get_distance(unsigned int i) const;
+
+  /*!
+   * Path found by the last query.
+   * \param to last vertex of the path.
+   * \param path filled with the vertices of the path, from the source to
+   * \c to.
+   * \pre \c to is a legal vertex number.
+   * \return false (and leave \c path empty) iff \c to was not reached.
+   */
+  bool get_path(unsigned int to, std::vector<unsigned int> &path) const;
+
+  /*! \return the number of vertices treated by the last query. */
+  unsigned int get_nbr_treated() const { return treated.size(); }
+
+  /*! \return the vertices treated by the last query, by increasing
+   * distance. */
+  std::vector<unsigned int> const &get_treated() const { return treated; }
+};
+
+#endif
@@ -1,140 +1,153 @@
 /*!
  * \file
- * \biref This module provides the Dijsktra algorithm on graph, the rest (graph
- * definition) is in the header file.
+ * \biref This module provides the printing of Dijkstra's algorithm on graph
+ * and the reading of graphs, the rest (graph definition) is in the header
+ * file.
  *
  * \author PASD
  * \date 2016
  */
 
+#include <iostream>
+#include <limits>
+
+#include "bfs.hpp"
+#include "dijkstra.hpp"
 #include "graph.hpp"
-#include "heap_id.hpp"
 
 using namespace std;
 
-namespace {
-
-/*!
- * Class used to put a Head_Id to store, for a vertex (identifyed by \c i ):
- */
-class Vertex_Distance {
-
-  /*! Reachable vertex number. */
-  unsigned int i;
-
-  /*! Lower distance found to get to i, yet. */
-  float distance;
-
-  /*! From where to come from to get this distance. */
-  unsigned int from;
-
-public:
-  //
-  //  CONSTRUCTORS
-  //
-
-  Vertex_Distance() {}
-  Vertex_Distance(unsigned int _i, float _distance, unsigned int _from)
-      : i(_i), distance(_distance), from(_from) {}
-
-  //
-  //  PUBLIC METHODS
-  //
+unsigned int const Graph::no_back = numeric_limits<unsigned int>::max();
 
-  /*! Comparison according to distance.
-   * \param cd2 Vertex_Distance to compare to.
-   * \return true if vd2 is at a longer distance.
-   */
-  bool operator<(Vertex_Distance const &vd2) const {
-    return distance < vd2.distance;
+Graph *Graph::read(istream &in) {
+  unsigned int nbr_vertices;
+  if (!(in >> nbr_vertices)) {
+    return NULL;
   }
-
-  /*! Comparison according to distance.
-   * \param cd2 Vertex_Distance to compare to.
-   * \return true if vd2 is at a longer or equal distance.
-   */
-  bool operator<=(Vertex_Distance const &vd2) const {
-    return distance <= vd2.distance;
+  Graph *g = new Graph(nbr_vertices);
+  unsigned int i, j;
+  float len;
+  while (in >> i >> j >> len) {
+    if (nbr_vertices <= i || nbr_vertices <= j || !(0 < len) ||
+        numeric_limits<float>::max() < len) {
+      delete g;
+      return NULL;
+    }
+    g->add_edge(i, j, len);
   }
-
-  /*!
-   * To change the value held.
-   * \param _distance new value for distance.
-   * \param _from new value for from.
-   * \pre distance should be decreasing.
-   */
-  void update(float const _distance, unsigned int const _from) {
-    assert(_distance < distance);
-    distance = _distance;
-    from = _from;
+  // Stopping anywhere but at the end means an ill-formed line
+  if (!in.eof()) {
+    delete g;
+    return NULL;
   }
+  return g;
+}
 
-  //
-  //  FRIENDS
-  //
-
-  friend class ::Graph;
-};
+void Graph::set_length(unsigned int i, size_t k, float len) {
+  assert(i < nbr_vertices);
+  assert(k < vertices[i].second.size());
+  assert(!is_removed(vertices[i].second[k]));
+  assert(-numeric_limits<float>::max() <= len &&
+         len <= numeric_limits<float>::max());
+  assert(is_directed || 0 < len);
+  Edge &e = vertices[i].second[k];
+  if (!is_directed) {
+    vertices[e.first].second[get_back(i, k)].second = len;
+  }
+  e.second = len;
+  // The flags stay conservative: a common length is not found again
+  is_common_length = is_common_length && len == common_length;
+  is_negative_length = is_negative_length || len < 0;
+}
 
-/*! Constant to indicate that the node is not reachable yet. */
-int const id_undefined = -1;
+void Graph::remove_edge(unsigned int i, size_t k) {
+  assert(i < nbr_vertices);
+  assert(k < vertices[i].second.size());
+  assert(!is_removed(vertices[i].second[k]));
+  Edge &e = vertices[i].second[k];
+  if (!is_directed) {
+    vertices[e.first].second[get_back(i, k)].second =
+        numeric_limits<float>::infinity();
+    nbr_removed++;
+  }
+  e.second = numeric_limits<float>::infinity();
+  nbr_removed++;
+}
 
-/*! Constant to indicate that the node was treated. */
-int const id_treated = -2;
+void Graph::compact() {
+  // New position of each edge kept, to find the edges back after the move
+  vector<vector<unsigned int> > moved(nbr_vertices);
+  for (unsigned int i = 0; i < nbr_vertices; i++) {
+    VEdge const &edges = vertices[i].second;
+    moved[i].resize(edges.size(), no_back);
+    unsigned int kept = 0;
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (!is_removed(edges[k])) {
+        moved[i][k] = kept++;
+      }
+    }
+  }
+  components.clear();
+  nbr_arcs = 0;
+  nbr_removed = 0;
+  common_length = 0;
+  is_common_length = true;
+  is_negative_length = false;
+  for (unsigned int i = 0; i < nbr_vertices; i++) {
+    VEdge &edges = vertices[i].second;
+    vector<Modes> &edge_modes = modes[i];
+    vector<unsigned int> &edge_backs = backs[i];
+    size_t kept = 0;
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (is_removed(edges[k])) {
+        continue;
+      }
+      // The edge back of a directed graph may be removed alone
+      unsigned int const back = edge_backs[k];
+      edges[kept] = edges[k];
+      edge_modes[kept] = edge_modes[k];
+      edge_backs[kept] =
+          (back == no_back) ? no_back : moved[edges[k].first][back];
+      kept++;
+      components.unite(i, edges[k].first);
+      record_length(edges[k].second);
+    }
+    edges.resize(kept);
+    edge_modes.resize(kept);
+    edge_backs.resize(kept);
+  }
 }
 
 void Graph::print_dijkstra(unsigned int from, unsigned int to) const {
   assert(from < nbr_vertices);
   assert(to < nbr_vertices);
 
-  // HEAP
-  Heap_Id<Vertex_Distance> heap(nbr_vertices);
-
-  // Associate vertices id to heap id
-  int *vertices_ids = new int[nbr_vertices];
-  for (unsigned int i = 0; i < nbr_vertices; i++) {
-    vertices_ids[i] = id_undefined;
-  }
-
-  // Vertex_Distance array
-  Vertex_Distance *vertices_dist = new Vertex_Distance[nbr_vertices];
-
-  // Add start vertex to heap
-  vertices_dist[from] = Vertex_Distance(from, 0, from);
-  vertices_ids[from] = heap.push(vertices_dist[from]);
-
   // CALCULATE DISTANCES
-  // While we don't have check all vertex
-  while (!heap.is_empty()) {
-    // Get the vertex at minimal distance
-    Vertex_Distance vd = heap.pop();
-    // Add vertices distance to heap
-    for (unsigned int i = 0; i < vertices[vd.i].second.size(); i++) {
-      Edge e = vertices[vd.i].second[i];
-      if (vertices_ids[e.first] == id_undefined) {
-        vertices_dist[e.first] =
-            Vertex_Distance(e.first, vd.distance + e.second, vd.i);
-        vertices_ids[e.first] = heap.push(vertices_dist[e.first]);
-
-      } else if (vertices_dist[e.first].distance > vd.distance + e.second) {
-        vertices_dist[e.first].distance = vd.distance + e.second;
-        vertices_dist[e.first].from = vd.i;
-        heap.reposition(vertices_ids[e.first]);
-      }
+  vector<unsigned int> path;
+  vector<float> distances;
+  if (has_common_length()) {
+    // Fewest edges: breadth-first search
+    Bfs search(*this);
+    search.run(from, to);
+    search.get_path(to, path);
+    for (size_t k = 0; k < path.size(); k++) {
+      distances.push_back(k * common_length);
+    }
+  } else {
+    Dijkstra search(*this);
+    search.shortest_distance(from, to);
+    search.get_path(to, path);
+    for (size_t k = 0; k < path.size(); k++) {
+      distances.push_back(search.get_distance(path[k]));
     }
-    vertices_ids[vd.i] = id_treated;
   }
 
-  // PRINT PATH
-  unsigned int i_current = to; // Vertex id
-  while (i_current != from) {
-    // Print vertex and distance
-    cout << "n" << vertices_dist[i_current].i << " "
-         << vertices_dist[i_current].distance << endl;
-    i_current = vertices_dist[i_current].from;
+  // PRINT PATH (flushed once, not at every vertex)
+  if (!path.empty()) {
+    for (size_t k = path.size() - 1; 0 < k; k--) {
+      // Print vertex and distance
+      cout << vertices[path[k]].first << " " << distances[k] << '\n';
+    }
+    cout << vertices[from].first << endl;
   }
-  cout << "n0" << endl;
-
-  delete[] vertices_ids;
-  delete[] vertices_dist;
 }
@@ -3,13 +3,17 @@
 
 /*!
  * \file
- * \brief This module provide a simple implantation of undirected graph.
+ * \brief This module provide a simple implantation of undirected graph (and
+ * of directed graph, on demand).
  *
  * \author PASD
  * \date 2016
  */
 
+#include <istream>
+#include <limits>
 #include <sstream>
+#include <string>
 
 #include <utility> // pair
 #include <vector>
@@ -17,6 +21,8 @@
 #undef NDEBUG
 #include <assert.h>
 
+#include "union_find.hpp"
+
 /*!
  * \brief To encode an undirected graph.
  *
@@ -24,6 +30,21 @@
  * Edges are then added.
  *
  * Vertices are numbered from 0.
+ *
+ * Vertices may have coordinates (x, y), e.g. to find the vertex nearest to a
+ * point with a Kd_Tree.
+ *
+ * Each edge has a bitmask of the modes allowed on it (all by default): see
+ * Profile to search with a mode and its own weights.
+ *
+ * An edge removed stays in place, with an infinite length (its tombstone),
+ * till the graph is compacted: searches on lengths never follow it, the others
+ * check is_removed. Compaction moves the edges, so it is done once the
+ * tombstones are many (needs_compaction), e.g. by the writer of a
+ * Graph_Versions update, off the read path.
+ *
+ * A graph created directed also accepts arcs (one way edges), of any length,
+ * even negative: see Johnson for shortest paths then.
  */
 class Graph {
 
@@ -42,13 +63,71 @@ public:
    */
   typedef std::pair<std::string, VEdge> Vertex;
 
+  /*!
+   * Type to store the modes (e.g. car, bike, foot) allowed on an edge, one
+   * bit per mode, the meaning of the bits being left to the user.
+   */
+  typedef unsigned char Modes;
+
+  /*! Modes allowed on the edges added without modes: all of them. */
+  static Modes const all_modes = 0xFF;
+
   /* Number of vertices. */
   unsigned int const nbr_vertices;
 
+  /* Whether arcs (add_arc) are accepted. */
+  bool const is_directed;
+
 private:
   /*! Array to store the vertices. */
   Vertex *const vertices;
 
+  /*! Array of the modes of the edges going out of each vertex, in the
+   * order of the edges. */
+  std::vector<Modes> *const modes;
+
+  /*! Array of the positions of the edges back (in the edges of their head)
+   * of the edges going out of each vertex, in the order of the edges;
+   * \c no_back for an arc. Parallel edges of the same length are thus told
+   * apart. */
+  std::vector<unsigned int> *const backs;
+
+  /*! Position of the edge back of an arc: none. */
+  static unsigned int const no_back;
+
+  /*! Connected components (weakly connected for arcs), maintained by
+   * add_edge and add_arc. */
+  Union_Find components;
+
+  /*! Number of arcs: each edge counts as two. */
+  unsigned int nbr_arcs;
+
+  /*! Number of arcs removed (still in place till compact). */
+  unsigned int nbr_removed;
+
+  /*! Length of the first arc. */
+  float common_length;
+
+  /*! Whether all the arcs have length \c common_length. */
+  bool is_common_length;
+
+  /*! Whether some arc has a negative length. */
+  bool is_negative_length;
+
+  /*! Coordinates of the vertices, one column per axis (empty if none). */
+  std::vector<float> xs;
+  std::vector<float> ys;
+
+  /*! Record the length of a new arc. */
+  void record_length(float len) {
+    if (nbr_arcs == 0) {
+      common_length = len;
+    }
+    is_common_length = is_common_length && len == common_length;
+    is_negative_length = is_negative_length || len < 0;
+    nbr_arcs++;
+  }
+
 public:
   //
   //  CONSTRUCTOR
@@ -58,10 +137,18 @@ public:
    * Create a graph with given number of vertices.
    * Names are provided for vertices: n0, n1…
    * \param _nbr_vertices number of vertices.
+   * \param _is_directed whether arcs are accepted.
    * The graph has no edges.
    */
-  Graph(unsigned int _nbr_vertices)
-      : nbr_vertices(_nbr_vertices), vertices(new Vertex[_nbr_vertices]) {
+  Graph(unsigned int _nbr_vertices, bool _is_directed = false)
+      : nbr_vertices(_nbr_vertices), is_directed(_is_directed),
+        vertices(new Vertex[_nbr_vertices]),
+        modes(new std::vector<Modes>[_nbr_vertices]),
+        backs(new std::vector<unsigned int>[_nbr_vertices]),
+        components(_nbr_vertices),
+        nbr_arcs(0), nbr_removed(0), common_length(0),
+        is_common_length(true),
+        is_negative_length(false) {
     std::string prefix("n");
     for (unsigned int i = 0; i < nbr_vertices; i++) {
       // "magic formula" for to_string ()
@@ -73,12 +160,36 @@ public:
     }
   }
 
+  /*!
+   * Create a copy of a graph (vertices, edges, modes and names).
+   * \param g graph to copy.
+   */
+  Graph(Graph const &g)
+      : nbr_vertices(g.nbr_vertices), is_directed(g.is_directed),
+        vertices(new Vertex[g.nbr_vertices]),
+        modes(new std::vector<Modes>[g.nbr_vertices]),
+        backs(new std::vector<unsigned int>[g.nbr_vertices]),
+        components(g.components), nbr_arcs(g.nbr_arcs),
+        nbr_removed(g.nbr_removed), common_length(g.common_length),
+        is_common_length(g.is_common_length),
+        is_negative_length(g.is_negative_length), xs(g.xs), ys(g.ys) {
+    for (unsigned int i = 0; i < nbr_vertices; i++) {
+      vertices[i] = g.vertices[i];
+      modes[i] = g.modes[i];
+      backs[i] = g.backs[i];
+    }
+  }
+
   //
   //  DESTRUCTOR
   //
 
   /*! Release the resources. */
-  ~Graph() { delete[] vertices; }
+  ~Graph() {
+    delete[] vertices;
+    delete[] modes;
+    delete[] backs;
+  }
 
   //
   //  PUBLIC METHODS
@@ -88,17 +199,262 @@ public:
    * i.e. (i,j) and (j,i)
    * \param i,j endpoints of the edge.
    * \param len length of the array.
+   * \param _modes modes allowed on the edge.
    * \pre \c i and \c j are legal vertex number.
-   * \pre \c len is strictly positive.
+   * \pre \c len is strictly positive and finite (infinity marks a removed
+   * edge).
    */
-  void add_edge(unsigned int i, unsigned int j, float len) {
+  void add_edge(unsigned int i, unsigned int j, float len,
+                Modes _modes = all_modes) {
     assert(i < nbr_vertices);
     assert(j < nbr_vertices);
-    assert(0 < len);
+    assert(0 < len && len <= std::numeric_limits<float>::max());
+    // Positions taken one after the other, for a loop (i == j)
+    unsigned int const k_i = vertices[i].second.size();
     vertices[i].second.push_back(Edge(j, len));
+    unsigned int const k_j = vertices[j].second.size();
     vertices[j].second.push_back(Edge(i, len));
+    modes[i].push_back(_modes);
+    modes[j].push_back(_modes);
+    backs[i].push_back(k_j);
+    backs[j].push_back(k_i);
+    components.unite(i, j);
+    record_length(len);
+    record_length(len);
+  }
+
+  /*! Add an arc, from \c i to \c j only.
+   * \param i,j endpoints of the arc.
+   * \param len length of the arc.
+   * \param _modes modes allowed on the arc.
+   * \pre the graph is directed.
+   * \pre \c i and \c j are legal vertex number.
+   * \pre \c len is finite (it may be negative).
+   */
+  void add_arc(unsigned int i, unsigned int j, float len,
+               Modes _modes = all_modes) {
+    assert(is_directed);
+    assert(i < nbr_vertices);
+    assert(j < nbr_vertices);
+    assert(-std::numeric_limits<float>::max() <= len &&
+           len <= std::numeric_limits<float>::max());
+    vertices[i].second.push_back(Edge(j, len));
+    modes[i].push_back(_modes);
+    backs[i].push_back(no_back);
+    components.unite(i, j);
+    record_length(len);
+  }
+
+  /*!
+   * Change the length of an edge. For an edge added by add_edge, the edge
+   * back is changed too (in a directed graph, only the arc is changed).
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param len new length.
+   * \pre \c i is a legal vertex number and \c k a legal position.
+   * \pre the edge is not removed.
+   * \pre \c len is finite, and strictly positive if the graph is
+   * undirected.
+   */
+  void set_length(unsigned int i, size_t k, float len);
+
+  /*!
+   * Remove an edge: its length becomes infinite, in constant time. For an
+   * edge added by add_edge, the edge back is removed too (in a directed
+   * graph, only the arc is removed). The connected components are not split
+   * till compact: is_connected may then be true for vertices not connected.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number and \c k a legal position.
+   * \pre the edge is not removed.
+   */
+  void remove_edge(unsigned int i, size_t k);
+
+  /*!
+   * To get the edge back of an edge added by add_edge, in constant time.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number and \c k a legal position, of an
+   * edge added by add_edge.
+   * \return the position of the edge back in the edges of its head.
+   */
+  size_t get_back(unsigned int i, size_t k) const {
+    assert(i < nbr_vertices);
+    assert(k < backs[i].size());
+    assert(backs[i][k] != no_back);
+    return backs[i][k];
+  }
+
+  /*!
+   * To know if an edge is removed.
+   * \param e edge.
+   * \return true iff \c e is a tombstone.
+   */
+  static bool is_removed(Edge const &e) {
+    return e.second == std::numeric_limits<float>::infinity();
+  }
+
+  /*! \return the number of arcs removed but still in place. */
+  unsigned int get_nbr_removed() const { return nbr_removed; }
+
+  /*!
+   * To know if the tombstones are worth a compaction.
+   * \param ratio share of the arcs removed above which to compact.
+   * \return true iff more than \c ratio of the arcs are removed.
+   */
+  bool needs_compaction(float ratio = 0.25f) const {
+    return ratio * nbr_arcs < nbr_removed;
+  }
+
+  /*!
+   * Drop the edges removed, in linear time: the edges left keep their order,
+   * but their positions change (a Profile or a Turn_Table of the graph must
+   * be built again), and the connected components and lengths are computed
+   * again.
+   */
+  void compact();
+
+  /*! \return the number of arcs (each edge counts as two), the removed ones
+   * included till compact. */
+  unsigned int get_nbr_arcs() const { return nbr_arcs; }
+
+  /*! \return true iff some arc has a negative length. */
+  bool has_negative_length() const { return is_negative_length; }
+
+  /*!
+   * To know if shortest paths are paths with the fewest edges.
+   * \return true iff there are edges and they all have the same positive
+   * length.
+   */
+  bool has_common_length() const {
+    return 0 < nbr_arcs && is_common_length && 0 < common_length;
+  }
+
+  /*!
+   * To get the length of the edges when they all have the same.
+   * \pre has_common_length ()
+   * \return the length of every edge.
+   */
+  float get_common_length() const {
+    assert(has_common_length());
+    return common_length;
+  }
+
+  /*!
+   * To test if there is a path between two vertices, in almost constant time.
+   * \param i,j vertices.
+   * \pre \c i and \c j are legal vertex number.
+   * \return true iff \c i and \c j are in the same connected component.
+   * For a directed graph, components are weakly connected: false means that
+   * there is no path, true that there may be one.
+   */
+  bool is_connected(unsigned int i, unsigned int j) const {
+    assert(i < nbr_vertices);
+    assert(j < nbr_vertices);
+    return components.is_same_set(i, j);
+  }
+
+  /*!
+   * To identify the connected component of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return a vertex of the component of \c i, the same for all of them
+   * (until an edge is added).
+   */
+  unsigned int get_component(unsigned int i) const {
+    assert(i < nbr_vertices);
+    return components.find(i);
+  }
+
+  /*! \return the number of connected components. */
+  unsigned int get_nbr_components() const {
+    return components.get_nbr_sets();
+  }
+
+  /*!
+   * To access the edges going out of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the edges going out of \c i.
+   */
+  VEdge const &get_edges(unsigned int i) const {
+    assert(i < nbr_vertices);
+    return vertices[i].second;
   }
 
+  /*!
+   * To access the modes of the edges going out of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the modes allowed on each edge of get_edges(i), in the same
+   * order.
+   */
+  std::vector<Modes> const &get_modes(unsigned int i) const {
+    assert(i < nbr_vertices);
+    return modes[i];
+  }
+
+  /*!
+   * Set the coordinates of a vertex. The first call gives coordinates (0, 0)
+   * to all the vertices.
+   * \param i vertex number.
+   * \param x,y coordinates.
+   * \pre \c i is a legal vertex number.
+   */
+  void set_coordinates(unsigned int i, float x, float y) {
+    assert(i < nbr_vertices);
+    if (xs.empty()) {
+      xs.resize(nbr_vertices, 0);
+      ys.resize(nbr_vertices, 0);
+    }
+    xs[i] = x;
+    ys[i] = y;
+  }
+
+  /*! \return true iff the vertices have coordinates. */
+  bool has_coordinates() const { return !xs.empty(); }
+
+  /*!
+   * To access the coordinates of a vertex.
+   * \param i vertex number.
+   * \pre has_coordinates() and \c i is a legal vertex number.
+   */
+  float get_x(unsigned int i) const {
+    assert(i < xs.size());
+    return xs[i];
+  }
+
+  /*! \see get_x */
+  float get_y(unsigned int i) const {
+    assert(i < ys.size());
+    return ys[i];
+  }
+
+  /*!
+   * To access the name of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the name of \c i.
+   */
+  std::string const &get_name(unsigned int i) const {
+    assert(i < nbr_vertices);
+    return vertices[i].first;
+  }
+
+  /*!
+   * Read a graph written in the text format:
+   * \verbatim
+   <number of vertices>
+   <i> <j> <length>
+   … …
+   * \endverbatim
+   * with one line per edge.
+   * \param in stream to read from.
+   * \return a newly allocated graph (to be deleted by the caller), or \c NULL
+   * if the stream does not hold a legal graph.
+   */
+  static Graph *read(std::istream &in);
+
   /*!
    * Print the result of Dijkstra's algorithm in the form:
    * \verbatim
@@ -108,6 +464,9 @@ public:
    <second node>   <distance to node from initial node>
    <initial node>
    * \endverbatim
+   * Nothing is printed if there is no path.
+   * If all the edges have the same length, a breadth-first search (Bfs) is
+   * used instead of Dijkstra's algorithm.
    * \param i,j endpoints of the path to search.
    * \pre \c i and \c j are legal vertex number.
    */
@@ -174,6 +174,8 @@ private:
    * \return true iff the Heap_Id is correct (each father less than or equal to
    * sons) and indexing array are ok and free index array is ok.
    * This should to be used in asserts.
+   * The check is linear in the capacity, hence it is skipped (always true)
+   * when \c HEAP_ID_NO_VALIDITY_CHECK is defined, as for the benchmarks.
    */
   bool is_valid() const;
 
@@ -240,6 +242,25 @@ public:
    */
   Element &pop();
 
+  /*!
+   * To access the root of the heap without removing it.
+   * \pre The Heap_Id  is not empty.
+   * \return the minimum of the heap.
+   */
+  Element const &top() const {
+    assert(0 < nb_elem);
+    return *(elements[0].first);
+  }
+
+  /*!
+   * Hint that the value with this id is about to be repositioned: fetch its
+   * position in advance, so that reposition does not wait for memory.
+   * \pre The id is valid.
+   */
+  void prefetch(const unsigned int id) const {
+    __builtin_prefetch(id_to_pos + id);
+  }
+
   /*!
    * \brief Reposition the value with this id in the heap.
    * \pre The id is valid.
@@ -256,6 +277,12 @@ public:
    */
   unsigned int push(Element &v);
 
+  /*!
+   * Remove all the values, making every id available again.
+   * \post The Heap_Id  is empty and valid.
+   */
+  void clear();
+
   //
   //  FRIENDS
   //
@@ -270,6 +297,7 @@ public:
 //
 
 template <class Element> bool Heap_Id<Element>::is_valid() const {
+#ifndef HEAP_ID_NO_VALIDITY_CHECK
   for (size_t i = 0; i < nb_elem; i++) {
     if (get_pos_right_son(i) < nb_elem) {
       assert(le(i, get_pos_right_son(i)));
@@ -293,6 +321,7 @@ template <class Element> bool Heap_Id<Element>::is_valid() const {
     }
     assert(!isFree);
   }
+#endif
   return true;
 }
 
@@ -367,6 +396,15 @@ void Heap_Id<Element>::reposition(const unsigned int id) {
   }
 }
 
+template <class Element> void Heap_Id<Element>::clear() {
+  // Ids in use are exactly the ones held by the nodes, give them back.
+  for (size_t i = 0; i < nb_elem; i++) {
+    id_free[i] = elements[i].second;
+  }
+  nb_elem = 0;
+  assert(is_valid());
+}
+
 /*! Print the heap on the \c ostream as an array with the format:
  * \verbatim [ e0 , e1 , ... , en ] \endverbatim
  * \param out \c ostream to output to.
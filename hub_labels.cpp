@@ -0,0 +1,271 @@
+/*!
+ * \file
+ * \brief This module provides hub labels (pruned landmark labeling) on Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // sort
+#include <fstream>
+#include <limits>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dijkstra.hpp"
+#include "heap_id.hpp"
+#include "hub_labels.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Hub ending every label (greater than any rank). */
+uint32_t const sentinel = numeric_limits<uint32_t>::max();
+
+/*! Distance of the vertices not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! Constant to indicate that the node is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the node was treated. */
+int const id_treated = -2;
+
+/*! First bytes of a label file. */
+char const magic[4] = {'H', 'U', 'B', 'L'};
+
+/*! Header of a label file, followed by the arrays offsets, hubs and
+ * distances. */
+struct File_Header {
+  char magic[4];
+  uint32_t nbr_vertices;
+  uint32_t nbr_entries;
+};
+
+/*!
+ * To order the vertices by decreasing degree.
+ */
+class Higher_Degree {
+  Graph const &g;
+
+public:
+  Higher_Degree(Graph const &_g) : g(_g) {}
+
+  bool operator()(unsigned int i, unsigned int j) const {
+    size_t const di = g.get_edges(i).size();
+    size_t const dj = g.get_edges(j).size();
+    return (di != dj) ? dj < di : i < j;
+  }
+};
+}
+
+Hub_Labels::Hub_Labels(Graph const &g)
+    : nbr_vertices(g.nbr_vertices), mapping(NULL), mapping_size(0) {
+  assert(!g.is_directed);
+  assert(!g.has_negative_length());
+  unsigned int const n = nbr_vertices;
+
+  // PROCESSING ORDER
+  vector<unsigned int> order(n);
+  for (unsigned int i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  sort(order.begin(), order.end(), Higher_Degree(g));
+
+  // PRUNED SEARCHES
+  vector<vector<uint32_t> > label_hubs(n);
+  vector<vector<float> > label_distances(n);
+  // distances from the current root to the hubs of its label, by hub
+  vector<float> root_distances(n, infinity);
+  Heap_Id<Dijkstra::Vertex_Key> heap(n);
+  vector<Dijkstra::Vertex_Key> keys(n);
+  vector<int> heap_ids(n, id_undefined);
+  vector<unsigned int> touched;
+  for (unsigned int i = 0; i < n; i++) {
+    keys[i].distance = infinity;
+    keys[i].i = i;
+  }
+
+  for (uint32_t rank = 0; rank < n; rank++) {
+    unsigned int const root = order[rank];
+    vector<uint32_t> const &root_hubs = label_hubs[root];
+    for (size_t k = 0; k < root_hubs.size(); k++) {
+      root_distances[root_hubs[k]] = label_distances[root][k];
+    }
+
+    keys[root].distance = 0;
+    heap_ids[root] = heap.push(keys[root]);
+    touched.push_back(root);
+    while (!heap.is_empty()) {
+      unsigned int const u = heap.pop().i;
+      float const du = keys[u].distance;
+      heap_ids[u] = id_treated;
+
+      // Pruned if the labels so far already give this distance
+      vector<uint32_t> const &u_hubs = label_hubs[u];
+      bool is_pruned = false;
+      for (size_t k = 0; k < u_hubs.size() && !is_pruned; k++) {
+        is_pruned = root_distances[u_hubs[k]] + label_distances[u][k] <= du;
+      }
+      if (is_pruned) {
+        continue;
+      }
+      label_hubs[u].push_back(rank);
+      label_distances[u].push_back(du);
+
+      Graph::VEdge const &edges = g.get_edges(u);
+      for (size_t k = 0; k < edges.size(); k++) {
+        unsigned int const v = edges[k].first;
+        float const dv = du + edges[k].second;
+        if (Graph::is_removed(edges[k])) {
+          continue;
+        }
+        if (heap_ids[v] == id_undefined) {
+          keys[v].distance = dv;
+          heap_ids[v] = heap.push(keys[v]);
+          touched.push_back(v);
+        } else if (heap_ids[v] != id_treated && dv < keys[v].distance) {
+          keys[v].distance = dv;
+          heap.reposition(heap_ids[v]);
+        }
+      }
+    }
+
+    for (size_t k = 0; k < touched.size(); k++) {
+      keys[touched[k]].distance = infinity;
+      heap_ids[touched[k]] = id_undefined;
+    }
+    touched.clear();
+    for (size_t k = 0; k < root_hubs.size(); k++) {
+      root_distances[root_hubs[k]] = infinity;
+    }
+  }
+
+  // PACKING, each label ended by the sentinel
+  offsets_storage.push_back(0);
+  for (unsigned int i = 0; i < n; i++) {
+    hubs_storage.insert(hubs_storage.end(), label_hubs[i].begin(),
+                        label_hubs[i].end());
+    distances_storage.insert(distances_storage.end(),
+                             label_distances[i].begin(),
+                             label_distances[i].end());
+    hubs_storage.push_back(sentinel);
+    distances_storage.push_back(infinity);
+    offsets_storage.push_back(hubs_storage.size());
+  }
+  offsets = &offsets_storage[0];
+  hubs = hubs_storage.empty() ? NULL : &hubs_storage[0];
+  distances = distances_storage.empty() ? NULL : &distances_storage[0];
+}
+
+Hub_Labels::Hub_Labels(unsigned int _nbr_vertices, void *_mapping,
+                       size_t _mapping_size)
+    : nbr_vertices(_nbr_vertices), mapping(_mapping),
+      mapping_size(_mapping_size) {
+  char const *p = static_cast<char const *>(mapping);
+  File_Header const *header = reinterpret_cast<File_Header const *>(p);
+  offsets = reinterpret_cast<uint32_t const *>(p + sizeof(File_Header));
+  hubs = offsets + nbr_vertices + 1;
+  distances = reinterpret_cast<float const *>(hubs + header->nbr_entries);
+}
+
+Hub_Labels::~Hub_Labels() {
+  if (mapping != NULL) {
+    munmap(mapping, mapping_size);
+  }
+}
+
+float Hub_Labels::get_distance(unsigned int i, unsigned int j) const {
+  assert(i < nbr_vertices);
+  assert(j < nbr_vertices);
+  // Merge of the two labels, both ended by the sentinel
+  uint32_t const *hi = hubs + offsets[i];
+  uint32_t const *hj = hubs + offsets[j];
+  float const *di = distances + offsets[i];
+  float const *dj = distances + offsets[j];
+  float best = infinity;
+  while (*hi != sentinel && *hj != sentinel) {
+    if (*hi == *hj) {
+      float const d = *di + *dj;
+      best = (d < best) ? d : best;
+      hi++, di++, hj++, dj++;
+    } else if (*hi < *hj) {
+      hi++, di++;
+    } else {
+      hj++, dj++;
+    }
+  }
+  return best;
+}
+
+bool Hub_Labels::save(char const *path) const {
+  File_Header header;
+  memcpy(header.magic, magic, sizeof(magic));
+  header.nbr_vertices = nbr_vertices;
+  header.nbr_entries = offsets[nbr_vertices];
+  ofstream out(path, ios::binary);
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  out.write(reinterpret_cast<char const *>(offsets),
+            (size_t(nbr_vertices) + 1) * sizeof(uint32_t));
+  out.write(reinterpret_cast<char const *>(hubs),
+            size_t(header.nbr_entries) * sizeof(uint32_t));
+  out.write(reinterpret_cast<char const *>(distances),
+            size_t(header.nbr_entries) * sizeof(float));
+  return out.good();
+}
+
+Hub_Labels *Hub_Labels::map(char const *path) {
+  int const fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat st;
+  void *data = MAP_FAILED;
+  size_t size = 0;
+  if (fstat(fd, &st) == 0 && sizeof(File_Header) <= size_t(st.st_size)) {
+    size = st.st_size;
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+  // Check the header and the size of the arrays, in size_t so that a huge
+  // number of vertices cannot wrap around, before reading the offsets
+  File_Header const *header = static_cast<File_Header const *>(data);
+  size_t const rest = size - sizeof(File_Header);
+  size_t const nbr_offsets = size_t(header->nbr_vertices) + 1;
+  bool const fits =
+      nbr_offsets <= rest / sizeof(uint32_t) &&
+      header->nbr_entries <= (rest - nbr_offsets * sizeof(uint32_t)) /
+                                 (sizeof(uint32_t) + sizeof(float));
+  if (memcmp(header->magic, magic, sizeof(magic)) != 0 || !fits ||
+      rest != nbr_offsets * sizeof(uint32_t) +
+                  size_t(header->nbr_entries) *
+                      (sizeof(uint32_t) + sizeof(float))) {
+    munmap(data, size);
+    return NULL;
+  }
+  // Check the offsets: from 0 to the number of entries, each label ended by
+  // the sentinel, so that the queries stay in the arrays
+  uint32_t const *offsets = reinterpret_cast<uint32_t const *>(
+      static_cast<char const *>(data) + sizeof(File_Header));
+  uint32_t const *hubs = offsets + header->nbr_vertices + 1;
+  bool is_valid = offsets[0] == 0 &&
+                  offsets[header->nbr_vertices] == header->nbr_entries;
+  for (uint32_t i = 0; is_valid && i < header->nbr_vertices; i++) {
+    is_valid = offsets[i] < offsets[i + 1] &&
+               offsets[i + 1] <= header->nbr_entries &&
+               hubs[offsets[i + 1] - 1] == sentinel;
+  }
+  if (!is_valid) {
+    munmap(data, size);
+    return NULL;
+  }
+  return new Hub_Labels(header->nbr_vertices, data, size);
+}
@@ -0,0 +1,125 @@
+#ifndef __HUB_LABELS_HPP_
+#define __HUB_LABELS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides hub labels (pruned landmark labeling) on Graph,
+ * for distance queries in microseconds.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.hpp"
+
+/*!
+ * \brief Hub labels of the vertices of an undirected Graph.
+ *
+ * Each vertex has a label: a list of (hub, distance to the hub) such that any
+ * two vertices have a hub on a shortest path between them in common. A
+ * distance query is then the merge of two labels, sorted by hub.
+ *
+ * The labels are built by pruned landmark labeling: vertices are processed
+ * by decreasing degree (as a guess of their importance), each one running a
+ * Dijkstra search (with a Heap_Id) that is pruned at the vertices whose
+ * distance is already given by the labels built so far.
+ *
+ * Implementation: all the labels are stored contiguously, hubs and distances
+ * in two separate arrays (so that the merge could be vectorised), each label
+ * ended by a sentinel hub. The arrays can be saved to a file and mapped back
+ * in memory without any copy.
+ */
+class Hub_Labels {
+
+public:
+  /*! Number of vertices. */
+  unsigned int const nbr_vertices;
+
+private:
+  /*! Array of the position of the label of each vertex, plus the end. */
+  uint32_t const *offsets;
+
+  /*! Array of the hubs (rank in the processing order), label by label. */
+  uint32_t const *hubs;
+
+  /*! Array of the distances to the hubs, label by label. */
+  float const *distances;
+
+  /*! Storage of the arrays when built. */
+  std::vector<uint32_t> offsets_storage;
+  std::vector<uint32_t> hubs_storage;
+  std::vector<float> distances_storage;
+
+  /*! File mapping holding the arrays when mapped (\c NULL if built). */
+  void *mapping;
+
+  /*! Size of the mapping. */
+  size_t mapping_size;
+
+  /*!
+   * Build on a file mapping.
+   * \param _nbr_vertices number of vertices.
+   * \param _mapping mapping, released by the destructor.
+   * \param _mapping_size size of the mapping.
+   */
+  Hub_Labels(unsigned int _nbr_vertices, void *_mapping,
+             size_t _mapping_size);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Compute the labels of a graph.
+   * \param g graph.
+   * \pre \c g is not directed and has no negative length.
+   */
+  Hub_Labels(Graph const &g);
+
+  /*!
+   * Map labels saved in a file.
+   * \param path file name.
+   * \return the labels (to be deleted by the caller), or \c NULL if the file
+   * cannot be mapped or does not hold labels.
+   */
+  static Hub_Labels *map(char const *path);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays or the mapping. */
+  ~Hub_Labels();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Distance query.
+   * \param i,j vertices.
+   * \pre \c i and \c j are legal vertex numbers.
+   * \return the distance between \c i and \c j (infinity if unreachable).
+   */
+  float get_distance(unsigned int i, unsigned int j) const;
+
+  /*! \return the total number of (hub, distance) entries of the labels. */
+  unsigned int get_nbr_entries() const {
+    return offsets[nbr_vertices] - nbr_vertices;
+  }
+
+  /*!
+   * Save the labels to a file, to be mapped by map.
+   * \param path file name.
+   * \return false iff the file cannot be written.
+   */
+  bool save(char const *path) const;
+};
+
+#endif
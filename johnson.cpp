@@ -0,0 +1,159 @@
+/*!
+ * \file
+ * \brief This module provides shortest paths on directed Graph with negative
+ * lengths: Johnson's algorithm.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <stdint.h>
+#include <string.h> // memcpy
+
+#include "johnson.hpp"
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace {
+
+/*!
+ * Potential of a vertex together with the number of arcs of the path giving
+ * it, in one word so that both change together: the arcs in the high half,
+ * the bits of the float in the low half.
+ */
+typedef uint64_t Label;
+
+/*! \return the label of a potential reached with \c nbr_arcs arcs. */
+Label make_label(float potential, unsigned int nbr_arcs) {
+  uint32_t bits;
+  memcpy(&bits, &potential, sizeof(bits));
+  return (static_cast<Label>(nbr_arcs) << 32) | bits;
+}
+
+/*! \return the potential of a label. */
+float label_potential(Label label) {
+  uint32_t const bits = static_cast<uint32_t>(label);
+  float potential;
+  memcpy(&potential, &bits, sizeof(potential));
+  return potential;
+}
+
+/*! \return the number of arcs of a label. */
+unsigned int label_nbr_arcs(Label label) {
+  return static_cast<unsigned int>(label >> 32);
+}
+
+/*! State shared by the workers of a Bellman–Ford round. */
+struct Round_State {
+  Graph const &graph;
+  /*! Labels, read and lowered atomically. */
+  vector<Label> labels;
+  /*! Whether a vertex is already in the next round (set atomically). */
+  vector<unsigned char> is_in_next;
+  /*! Vertices relaxed by the round. */
+  vector<unsigned int> frontier;
+  /*! Vertices improved by each worker. */
+  vector<vector<unsigned int> > next;
+  /*! Whether a path of at least n arcs was found (set atomically). */
+  bool is_negative_cycle;
+
+  Round_State(Graph const &g, unsigned int nbr_workers)
+      : graph(g), labels(g.nbr_vertices, make_label(0, 0)),
+        is_in_next(g.nbr_vertices, 0), next(nbr_workers),
+        is_negative_cycle(false) {}
+};
+
+/*!
+ * Relax the arcs of a slice of the frontier. A label is lowered by a
+ * compare-and-swap, so it always is the length and arcs of a real path:
+ * with no negative cycle, a path of n arcs cannot be an improvement.
+ */
+void relax_arcs(unsigned int worker, unsigned int nbr_workers,
+                void *context) {
+  Round_State &state = *static_cast<Round_State *>(context);
+  unsigned int const n = state.graph.nbr_vertices;
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, state.frontier.size(), first, last);
+  for (unsigned int k = first; k < last; k++) {
+    if (__atomic_load_n(&state.is_negative_cycle, __ATOMIC_RELAXED)) {
+      return;
+    }
+    unsigned int const u = state.frontier[k];
+    Label const lu = __atomic_load_n(&state.labels[u], __ATOMIC_RELAXED);
+    Graph::VEdge const &edges = state.graph.get_edges(u);
+    for (size_t e = 0; e < edges.size(); e++) {
+      unsigned int const v = edges[e].first;
+      float const dv = label_potential(lu) + edges[e].second;
+      Label const candidate = make_label(dv, label_nbr_arcs(lu) + 1);
+      Label lv = __atomic_load_n(&state.labels[v], __ATOMIC_RELAXED);
+      bool is_improved = false;
+      while (dv < label_potential(lv)) {
+        if (__atomic_compare_exchange_n(&state.labels[v], &lv, candidate,
+                                        false, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+          is_improved = true;
+          break;
+        }
+      }
+      if (!is_improved) {
+        continue;
+      }
+      if (n <= label_nbr_arcs(candidate)) {
+        __atomic_store_n(&state.is_negative_cycle, true, __ATOMIC_RELAXED);
+        return;
+      }
+      if (__atomic_exchange_n(&state.is_in_next[v], 1, __ATOMIC_RELAXED) ==
+          0) {
+        state.next[worker].push_back(v);
+      }
+    }
+  }
+}
+}
+
+Johnson::Johnson(Graph const &_graph, unsigned int nbr_workers)
+    : graph(_graph), potentials(new float[_graph.nbr_vertices]),
+      is_negative_cycle(false), nbr_rounds(0), search(_graph) {
+  assert(0 < nbr_workers);
+  unsigned int const n = graph.nbr_vertices;
+
+  // BELLMAN–FORD from a virtual source, at distance 0 of every vertex
+  Round_State state(graph, nbr_workers);
+  for (unsigned int i = 0; i < n; i++) {
+    state.frontier.push_back(i);
+  }
+  while (!state.frontier.empty() && !state.is_negative_cycle) {
+    nbr_rounds++;
+    // The last rounds improve few vertices: not worth the workers
+    run_parallel(get_nbr_useful_workers(nbr_workers, state.frontier.size()),
+                 relax_arcs, &state);
+    state.frontier.clear();
+    for (unsigned int w = 0; w < nbr_workers; w++) {
+      state.frontier.insert(state.frontier.end(), state.next[w].begin(),
+                            state.next[w].end());
+      state.next[w].clear();
+    }
+    for (size_t k = 0; k < state.frontier.size(); k++) {
+      state.is_in_next[state.frontier[k]] = 0;
+    }
+  }
+  is_negative_cycle = state.is_negative_cycle;
+  for (unsigned int i = 0; i < n; i++) {
+    potentials[i] = label_potential(state.labels[i]);
+  }
+
+  search.set_potentials(potentials);
+}
+
+Johnson::~Johnson() { delete[] potentials; }
+
+float Johnson::shortest_distance(unsigned int from, unsigned int to) {
+  assert(!is_negative_cycle);
+  return search.shortest_distance(from, to);
+}
+
+void Johnson::one_to_all(unsigned int from) {
+  assert(!is_negative_cycle);
+  search.one_to_all(from);
+}
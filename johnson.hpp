@@ -0,0 +1,140 @@
+#ifndef __JOHNSON_HPP_
+#define __JOHNSON_HPP_
+
+/*!
+ * \file
+ * \brief This module provides shortest paths on directed Graph with negative
+ * lengths: Johnson's algorithm.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "graph.hpp"
+
+/*!
+ * \brief Shortest paths on a Graph with negative lengths.
+ *
+ * On construction, a queue-based Bellman–Ford (SPFA) computes the distances
+ * from a virtual source linked to every vertex with length 0, or detects a
+ * negative cycle. These distances are potentials making every reduced length
+ * non-negative, so that the queries are then answered by Dijkstra's
+ * algorithm (Dijkstra::set_potentials): the Bellman–Ford cost is paid once
+ * for any number of queries.
+ *
+ * The Bellman–Ford runs by rounds: each round relaxes the arcs of the vertices
+ * improved by the previous one. A round can be split across workers (see
+ * run_parallel), which lower the potentials with a compare-and-swap.
+ */
+class Johnson {
+
+public:
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! Array of the potentials, indexed by vertex number. */
+  float *const potentials;
+
+  /*! Whether there is a cycle of negative length. */
+  bool is_negative_cycle;
+
+  /*! Number of Bellman–Ford rounds. */
+  unsigned int nbr_rounds;
+
+  /*! Workspace of the queries. */
+  Dijkstra search;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Compute the potentials of a graph.
+   * \param _graph graph to search, it must not be destroyed before.
+   * \param nbr_workers number of workers of the Bellman–Ford rounds (1 runs
+   * in the calling thread).
+   * \pre \c nbr_workers is at least 1.
+   */
+  Johnson(Graph const &_graph, unsigned int nbr_workers = 1);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the potentials. */
+  ~Johnson();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*! \return true iff the graph has a cycle of negative length (then there
+   * is no shortest path). */
+  bool has_negative_cycle() const { return is_negative_cycle; }
+
+  /*! \return the number of rounds of the Bellman–Ford algorithm. */
+  unsigned int get_nbr_rounds() const { return nbr_rounds; }
+
+  /*!
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the potential of \c i.
+   */
+  float get_potential(unsigned int i) const {
+    assert(i < graph.nbr_vertices);
+    return potentials[i];
+  }
+
+  /*!
+   * Point-to-point query.
+   * \param from,to endpoints of the path to search.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \pre there is no negative cycle.
+   * \return the distance from \c from to \c to (infinity if unreachable).
+   */
+  float shortest_distance(unsigned int from, unsigned int to);
+
+  /*!
+   * One-to-all query.
+   * \param from source vertex.
+   * \pre \c from is a legal vertex number.
+   * \pre there is no negative cycle.
+   */
+  void one_to_all(unsigned int from);
+
+  /*!
+   * Set the view used by the next queries: only the edges of the view whose
+   * head is in the view are followed (see Graph_View). The potentials of
+   * the whole graph stay valid on any part of it.
+   * \param view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the queries are in the view.
+   */
+  void set_view(Graph_View const *view) { search.set_view(view); }
+
+  /*!
+   * Distance found by the last query.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   */
+  float get_distance(unsigned int i) const { return search.get_distance(i); }
+
+  /*!
+   * Path found by the last query.
+   * \param to last vertex of the path.
+   * \param path filled with the vertices of the path, from the source to
+   * \c to.
+   * \pre \c to is a legal vertex number.
+   * \return false (and leave \c path empty) iff \c to was not reached.
+   */
+  bool get_path(unsigned int to, std::vector<unsigned int> &path) const {
+    return search.get_path(to, path);
+  }
+};
+
+#endif
@@ -0,0 +1,300 @@
+/*!
+ * \file
+ * \brief This module provides a static k-d tree on the coordinates of the
+ * vertices of a Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // min, nth_element, push_heap, pop_heap, sort_heap
+#include <fstream>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "kd_tree.hpp"
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Largest number of vertices of a leaf. */
+unsigned int const leaf_size = 8;
+
+/*! First bytes of a tree file. */
+char const magic[4] = {'K', 'D', 'T', 'R'};
+
+/*! Header of a tree file, followed by the arrays xs, ys and ids. */
+struct File_Header {
+  char magic[4];
+  uint32_t nbr_points;
+};
+
+/*!
+ * To order the vertices along an axis.
+ */
+class Less_On_Axis {
+  Graph const &g;
+  bool const is_x;
+
+public:
+  Less_On_Axis(Graph const &_g, bool _is_x) : g(_g), is_x(_is_x) {}
+
+  bool operator()(unsigned int i, unsigned int j) const {
+    return is_x ? g.get_x(i) < g.get_x(j) : g.get_y(i) < g.get_y(j);
+  }
+};
+
+/*!
+ * Sort a range of vertices in tree order.
+ * \param g graph.
+ * \param order vertices.
+ * \param lo,hi range.
+ * \param depth depth of the range in the tree.
+ */
+void sort_subtree(Graph const &g, vector<unsigned int> &order, unsigned int lo,
+                  unsigned int hi, unsigned int depth) {
+  if (hi - lo <= leaf_size) {
+    return;
+  }
+  unsigned int const mid = lo + (hi - lo) / 2;
+  nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+              Less_On_Axis(g, depth % 2 == 0));
+  sort_subtree(g, order, lo, mid, depth + 1);
+  sort_subtree(g, order, mid + 1, hi, depth + 1);
+}
+
+/*! Range of the vertices of a subtree, and its depth. */
+struct Subtree {
+  unsigned int lo;
+  unsigned int hi;
+  unsigned int depth;
+};
+
+/*!
+ * Sort the top levels of a range of vertices in tree order, and list the
+ * subtrees left below them.
+ * \param g graph.
+ * \param order vertices.
+ * \param lo,hi range.
+ * \param depth depth of the range in the tree.
+ * \param nbr_levels number of levels to sort.
+ * \param subtrees filled with the subtrees left.
+ */
+void split_subtree(Graph const &g, vector<unsigned int> &order,
+                   unsigned int lo, unsigned int hi, unsigned int depth,
+                   unsigned int nbr_levels, vector<Subtree> &subtrees) {
+  if (nbr_levels == 0 || hi - lo <= leaf_size) {
+    Subtree const s = {lo, hi, depth};
+    subtrees.push_back(s);
+    return;
+  }
+  unsigned int const mid = lo + (hi - lo) / 2;
+  nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+              Less_On_Axis(g, depth % 2 == 0));
+  split_subtree(g, order, lo, mid, depth + 1, nbr_levels - 1, subtrees);
+  split_subtree(g, order, mid + 1, hi, depth + 1, nbr_levels - 1, subtrees);
+}
+
+/*! State shared by the workers sorting the subtrees. */
+struct Build_State {
+  Graph const &g;
+  vector<unsigned int> &order;
+  vector<Subtree> subtrees;
+
+  Build_State(Graph const &_g, vector<unsigned int> &_order)
+      : g(_g), order(_order) {}
+};
+
+/*! Sort a slice of the subtrees (disjoint ranges of the order). */
+void sort_subtrees(unsigned int worker, unsigned int nbr_workers,
+                   void *context) {
+  Build_State &state = *static_cast<Build_State *>(context);
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, state.subtrees.size(), first, last);
+  for (unsigned int k = first; k < last; k++) {
+    Subtree const &s = state.subtrees[k];
+    sort_subtree(state.g, state.order, s.lo, s.hi, s.depth);
+  }
+}
+
+/*!
+ * Keep a vertex among the \c k nearest ones if it is nearer.
+ * \param candidates max-heap of the nearest vertices.
+ * \param k number of vertices searched.
+ * \param c the vertex and its squared distance.
+ */
+void offer(vector<Kd_Tree::Candidate> &candidates, unsigned int k,
+           Kd_Tree::Candidate const &c) {
+  if (candidates.size() < k) {
+    candidates.push_back(c);
+    push_heap(candidates.begin(), candidates.end());
+  } else if (c < candidates.front()) {
+    pop_heap(candidates.begin(), candidates.end());
+    candidates.back() = c;
+    push_heap(candidates.begin(), candidates.end());
+  }
+}
+}
+
+//
+//  CONSTRUCTORS
+//
+
+Kd_Tree::Kd_Tree(Graph const &g, unsigned int nbr_workers)
+    : nbr_points(g.nbr_vertices), mapping(NULL), mapping_size(0) {
+  assert(g.has_coordinates() || g.nbr_vertices == 0);
+  assert(0 < nbr_workers);
+  vector<unsigned int> order(nbr_points);
+  for (unsigned int i = 0; i < nbr_points; i++) {
+    order[i] = i;
+  }
+  // enough levels sorted first for every worker to get a subtree
+  unsigned int nbr_levels = 0;
+  while ((1u << nbr_levels) < nbr_workers) {
+    nbr_levels++;
+  }
+  Build_State state(g, order);
+  split_subtree(g, order, 0, nbr_points, 0, nbr_levels, state.subtrees);
+  run_parallel(nbr_workers, sort_subtrees, &state);
+  xs_storage.resize(nbr_points);
+  ys_storage.resize(nbr_points);
+  ids_storage.resize(nbr_points);
+  for (unsigned int p = 0; p < nbr_points; p++) {
+    xs_storage[p] = g.get_x(order[p]);
+    ys_storage[p] = g.get_y(order[p]);
+    ids_storage[p] = order[p];
+  }
+  xs = xs_storage.empty() ? NULL : &xs_storage[0];
+  ys = ys_storage.empty() ? NULL : &ys_storage[0];
+  ids = ids_storage.empty() ? NULL : &ids_storage[0];
+}
+
+Kd_Tree::Kd_Tree(unsigned int _nbr_points, void *_mapping,
+                 size_t _mapping_size)
+    : nbr_points(_nbr_points), mapping(_mapping),
+      mapping_size(_mapping_size) {
+  char const *p = static_cast<char const *>(mapping) + sizeof(File_Header);
+  xs = reinterpret_cast<float const *>(p);
+  ys = xs + nbr_points;
+  ids = reinterpret_cast<uint32_t const *>(ys + nbr_points);
+}
+
+Kd_Tree *Kd_Tree::map(char const *path) {
+  int const fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat st;
+  void *data = MAP_FAILED;
+  size_t size = 0;
+  if (fstat(fd, &st) == 0 && sizeof(File_Header) <= size_t(st.st_size)) {
+    size = st.st_size;
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+  // Check the header and the size of the arrays
+  File_Header const *header = static_cast<File_Header const *>(data);
+  size_t const expected =
+      sizeof(File_Header) +
+      size_t(header->nbr_points) * (2 * sizeof(float) + sizeof(uint32_t));
+  if (memcmp(header->magic, magic, sizeof(magic)) != 0 || size != expected) {
+    munmap(data, size);
+    return NULL;
+  }
+  return new Kd_Tree(header->nbr_points, data, size);
+}
+
+//
+//  DESTRUCTOR
+//
+
+Kd_Tree::~Kd_Tree() {
+  if (mapping != NULL) {
+    munmap(mapping, mapping_size);
+  }
+}
+
+//
+//  QUERIES
+//
+
+void Kd_Tree::search(unsigned int lo, unsigned int hi, unsigned int depth,
+                     float x, float y, unsigned int k,
+                     vector<Candidate> &candidates) const {
+  if (hi - lo <= leaf_size) {
+    for (unsigned int p = lo; p < hi; p++) {
+      float const dx = x - xs[p];
+      float const dy = y - ys[p];
+      offer(candidates, k, Candidate(dx * dx + dy * dy, ids[p]));
+    }
+    return;
+  }
+  unsigned int const mid = lo + (hi - lo) / 2;
+  float const dx = x - xs[mid];
+  float const dy = y - ys[mid];
+  offer(candidates, k, Candidate(dx * dx + dy * dy, ids[mid]));
+  // The subtree on the side of the point first, then the other one if it may
+  // hold nearer vertices (ties included, for the smallest numbers)
+  float const delta = (depth % 2 == 0) ? dx : dy;
+  if (delta < 0) {
+    search(lo, mid, depth + 1, x, y, k, candidates);
+  } else {
+    search(mid + 1, hi, depth + 1, x, y, k, candidates);
+  }
+  if (candidates.size() < k || delta * delta <= candidates.front().first) {
+    if (delta < 0) {
+      search(mid + 1, hi, depth + 1, x, y, k, candidates);
+    } else {
+      search(lo, mid, depth + 1, x, y, k, candidates);
+    }
+  }
+}
+
+unsigned int Kd_Tree::nearest(float x, float y) const {
+  assert(0 < nbr_points);
+  vector<Candidate> candidates;
+  candidates.reserve(1);
+  search(0, nbr_points, 0, x, y, 1, candidates);
+  return candidates[0].second;
+}
+
+void Kd_Tree::k_nearest(float x, float y, unsigned int k,
+                        vector<unsigned int> &nearest) const {
+  vector<Candidate> candidates;
+  // k is not bounded by the caller: at most all the points are kept
+  candidates.reserve(min(k, nbr_points));
+  if (0 < k) {
+    search(0, nbr_points, 0, x, y, k, candidates);
+  }
+  sort_heap(candidates.begin(), candidates.end());
+  nearest.resize(candidates.size());
+  for (size_t c = 0; c < candidates.size(); c++) {
+    nearest[c] = candidates[c].second;
+  }
+}
+
+//
+//  FILE
+//
+
+bool Kd_Tree::save(char const *path) const {
+  File_Header header;
+  memcpy(header.magic, magic, sizeof(magic));
+  header.nbr_points = nbr_points;
+  ofstream out(path, ios::binary);
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  out.write(reinterpret_cast<char const *>(xs), nbr_points * sizeof(float));
+  out.write(reinterpret_cast<char const *>(ys), nbr_points * sizeof(float));
+  out.write(reinterpret_cast<char const *>(ids),
+            nbr_points * sizeof(uint32_t));
+  return out.good();
+}
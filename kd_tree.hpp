@@ -0,0 +1,149 @@
+#ifndef __KD_TREE_HPP_
+#define __KD_TREE_HPP_
+
+/*!
+ * \file
+ * \brief This module provides a static k-d tree on the coordinates of the
+ * vertices of a Graph, to find the vertices nearest to a point.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <utility> // pair
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.hpp"
+
+/*!
+ * \brief Static 2-d tree of the vertices of a Graph, by their coordinates.
+ *
+ * Distances are Euclidean in the plane of the coordinates: latitudes and
+ * longitudes are to be projected first (e.g. x = longitude * cos(latitude
+ * of the area), y = latitude), which is accurate at the scale of a city.
+ *
+ * Implementation: the tree is implicit. The vertices are sorted in an array
+ * such that the median of a range, along x at even depths and along y at odd
+ * ones, is in its middle and splits it into the two subtrees. Ranges of a
+ * few vertices are leaves, scanned linearly. The coordinates are stored in
+ * two separate arrays, with the vertex numbers in a third one. The arrays can
+ * be saved to a file and mapped back in memory without any copy.
+ */
+class Kd_Tree {
+
+public:
+  /*! Number of vertices in the tree. */
+  unsigned int const nbr_points;
+
+  /*! Candidate for the nearest vertices: squared distance and vertex. */
+  typedef std::pair<float, uint32_t> Candidate;
+
+private:
+  /*! Arrays of the coordinates and numbers of the vertices, in tree order. */
+  float const *xs;
+  float const *ys;
+  uint32_t const *ids;
+
+  /*! Storage of the arrays when built. */
+  std::vector<float> xs_storage;
+  std::vector<float> ys_storage;
+  std::vector<uint32_t> ids_storage;
+
+  /*! File mapping holding the arrays when mapped (\c NULL if built). */
+  void *mapping;
+
+  /*! Size of the mapping. */
+  size_t mapping_size;
+
+  /*!
+   * Build on a file mapping.
+   * \param _nbr_points number of vertices.
+   * \param _mapping mapping, released by the destructor.
+   * \param _mapping_size size of the mapping.
+   */
+  Kd_Tree(unsigned int _nbr_points, void *_mapping, size_t _mapping_size);
+
+  /*!
+   * Look in a subtree for vertices nearer than the candidates.
+   * \param lo,hi range of the subtree.
+   * \param depth depth of the subtree.
+   * \param x,y point.
+   * \param k number of vertices searched.
+   * \param candidates max-heap of the \c k nearest vertices found so far.
+   */
+  void search(unsigned int lo, unsigned int hi, unsigned int depth, float x,
+              float y, unsigned int k,
+              std::vector<Candidate> &candidates) const;
+
+  /*! Not copyable. */
+  Kd_Tree(Kd_Tree const &);
+
+  /*! Not assignable. */
+  Kd_Tree &operator=(Kd_Tree const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build the tree of the vertices of a graph. The top levels are sorted
+   * first, then the subtrees below them are sorted by the workers (see
+   * run_parallel); the tree does not depend on the number of workers.
+   * \param g graph.
+   * \param nbr_workers number of workers (1 runs in the calling thread).
+   * \pre \c g has coordinates.
+   * \pre \c nbr_workers is at least 1.
+   */
+  Kd_Tree(Graph const &g, unsigned int nbr_workers = 1);
+
+  /*!
+   * Map a tree saved in a file.
+   * \param path file name.
+   * \return the tree (to be deleted by the caller), or \c NULL if the file
+   * cannot be mapped or does not hold a tree.
+   */
+  static Kd_Tree *map(char const *path);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays or the mapping. */
+  ~Kd_Tree();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Nearest vertex query.
+   * \param x,y point.
+   * \pre the tree is not empty.
+   * \return the vertex nearest to (x, y), the smallest number if there are
+   * several.
+   */
+  unsigned int nearest(float x, float y) const;
+
+  /*!
+   * k-nearest vertices query.
+   * \param x,y point.
+   * \param k number of vertices.
+   * \param nearest filled with the \c k vertices nearest to (x, y) (all of
+   * them if there are less), by increasing distance then number.
+   */
+  void k_nearest(float x, float y, unsigned int k,
+                 std::vector<unsigned int> &nearest) const;
+
+  /*!
+   * Save the tree to a file, to be mapped by map.
+   * \param path file name.
+   * \return false iff the file cannot be written.
+   */
+  bool save(char const *path) const;
+};
+
+#endif
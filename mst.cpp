@@ -0,0 +1,288 @@
+/*!
+ * \file
+ * \brief This module provides minimum spanning trees of Graph, with Prim's
+ * and Borůvka's algorithms.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // min, max
+#include <limits>
+
+#include "heap_id.hpp"
+#include "mst.hpp"
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace {
+
+/*!
+ * Class used to put in a Heap_Id, for a vertex (identifyed by \c i ), the
+ * length of the lightest edge linking it to the tree.
+ */
+class Vertex_Link {
+public:
+  /*! Length of the lightest edge to the tree, yet. */
+  float len;
+
+  /*! Vertex number. */
+  unsigned int i;
+
+  /*! Comparison according to length. */
+  bool operator<(Vertex_Link const &vl2) const { return len < vl2.len; }
+
+  /*! Comparison according to length. */
+  bool operator<=(Vertex_Link const &vl2) const { return len <= vl2.len; }
+};
+
+/*! Constant to indicate that the node is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the node is in the tree. */
+int const id_treated = -2;
+
+/*! Constant to indicate that a component has no outgoing edge (yet). */
+unsigned int const no_edge = numeric_limits<unsigned int>::max();
+
+/*!
+ * To compare edges: by length, then by endpoints. This total order makes
+ * the lightest edges unique, so that Borůvka's rounds never make a cycle.
+ */
+bool is_lighter(float len_1, unsigned int i_1, unsigned int j_1, float len_2,
+                unsigned int i_2, unsigned int j_2) {
+  if (len_1 != len_2) {
+    return len_1 < len_2;
+  }
+  if (i_1 != i_2) {
+    return i_1 < i_2;
+  }
+  return j_1 < j_2;
+}
+
+/*!
+ * State of Borůvka's algorithm, shared by the workers. The arcs are numbered
+ * vertex by vertex in the order of Graph::get_edges.
+ */
+struct Boruvka_State {
+  Graph const *g;
+
+  /*! Array of the number of the first arc of each vertex, plus the end. */
+  unsigned int *offsets;
+
+  /*! Array of the tails of the arcs. */
+  unsigned int *tails;
+
+  /*! Array of the component (its root vertex) of each vertex. */
+  unsigned int *components;
+
+  /*! Array of the lightest outgoing arc of each root, no_edge if none. */
+  unsigned int *best;
+
+  /*! Array of the root each root is hooked to (itself if none). */
+  unsigned int *hooks;
+
+  /*! Edges added by each worker during the round. */
+  vector<vector<Spanning_Tree::Tree_Edge> > added;
+};
+
+/*!
+ * To compare arcs with is_lighter.
+ * \return true iff arc \c a_1 is lighter than arc \c a_2.
+ */
+bool is_lighter_arc(Boruvka_State const &s, unsigned int a_1,
+                    unsigned int a_2) {
+  unsigned int const u_1 = s.tails[a_1];
+  unsigned int const u_2 = s.tails[a_2];
+  Graph::Edge const &e_1 = s.g->get_edges(u_1)[a_1 - s.offsets[u_1]];
+  Graph::Edge const &e_2 = s.g->get_edges(u_2)[a_2 - s.offsets[u_2]];
+  return is_lighter(e_1.second, min(u_1, e_1.first), max(u_1, e_1.first),
+                    e_2.second, min(u_2, e_2.first), max(u_2, e_2.first));
+}
+
+/*! Phase 1: every vertex offers its lightest outgoing arc to its component
+ * (lock-free minimum). */
+void offer_arcs(unsigned int worker, unsigned int nbr_workers,
+                void *context) {
+  Boruvka_State &s = *static_cast<Boruvka_State *>(context);
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, s.g->nbr_vertices, first, last);
+  for (unsigned int u = first; u < last; u++) {
+    unsigned int const cu = s.components[u];
+    Graph::VEdge const &edges = s.g->get_edges(u);
+    unsigned int a = no_edge;
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (Graph::is_removed(edges[k]) ||
+          s.components[edges[k].first] == cu) {
+        continue;
+      }
+      unsigned int const arc = s.offsets[u] + k;
+      if (a == no_edge || is_lighter_arc(s, arc, a)) {
+        a = arc;
+      }
+    }
+    if (a == no_edge) {
+      continue;
+    }
+    unsigned int current = __atomic_load_n(&s.best[cu], __ATOMIC_RELAXED);
+    while ((current == no_edge || is_lighter_arc(s, a, current)) &&
+           !__atomic_compare_exchange_n(&s.best[cu], &current, a, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      // current was changed by another worker: compare again
+    }
+  }
+}
+
+/*! Phase 2: every root hooks itself to the root across its lightest arc. */
+void hook_components(unsigned int worker, unsigned int nbr_workers,
+                     void *context) {
+  Boruvka_State &s = *static_cast<Boruvka_State *>(context);
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, s.g->nbr_vertices, first, last);
+  for (unsigned int c = first; c < last; c++) {
+    if (s.components[c] != c) {
+      continue;
+    }
+    unsigned int const a = s.best[c];
+    s.hooks[c] = c;
+    if (a == no_edge) {
+      continue;
+    }
+    unsigned int const u = s.tails[a];
+    Graph::Edge const &e = s.g->get_edges(u)[a - s.offsets[u]];
+    unsigned int const d = s.components[e.first];
+    // Two components picking the same edge (the order is total up to
+    // parallel edges): the smaller one stays a root and the edge is added
+    // once
+    bool const is_mutual =
+        !is_lighter_arc(s, a, s.best[d]) && !is_lighter_arc(s, s.best[d], a);
+    if (!(is_mutual && c < d)) {
+      s.hooks[c] = d;
+      s.added[worker].push_back(Spanning_Tree::Tree_Edge(u, e.first, e.second));
+    }
+  }
+}
+
+/*! Phase 3: every vertex follows the hooks to its new root, compressing the
+ * paths (concurrent compressions only store roots of the path). */
+void relabel(unsigned int worker, unsigned int nbr_workers, void *context) {
+  Boruvka_State &s = *static_cast<Boruvka_State *>(context);
+  unsigned int first, last;
+  get_slice(worker, nbr_workers, s.g->nbr_vertices, first, last);
+  for (unsigned int u = first; u < last; u++) {
+    unsigned int root = s.components[u];
+    unsigned int hook;
+    while ((hook = __atomic_load_n(&s.hooks[root], __ATOMIC_RELAXED)) !=
+           root) {
+      root = hook;
+    }
+    for (unsigned int c = s.components[u]; c != root;) {
+      unsigned int const next = __atomic_load_n(&s.hooks[c], __ATOMIC_RELAXED);
+      __atomic_store_n(&s.hooks[c], root, __ATOMIC_RELAXED);
+      c = next;
+    }
+    s.components[u] = root;
+    s.best[u] = no_edge;
+  }
+}
+}
+
+void prim(Graph const &g, Spanning_Tree &tree) {
+  assert(!g.is_directed);
+  tree.clear();
+  unsigned int const n = g.nbr_vertices;
+  Heap_Id<Vertex_Link> heap(n);
+  Vertex_Link *links = new Vertex_Link[n];
+  unsigned int *fathers = new unsigned int[n];
+  int *heap_ids = new int[n];
+  for (unsigned int i = 0; i < n; i++) {
+    links[i].i = i;
+    heap_ids[i] = id_undefined;
+  }
+
+  // Grow a tree from every vertex not in a tree yet
+  for (unsigned int root = 0; root < n; root++) {
+    if (heap_ids[root] != id_undefined) {
+      continue;
+    }
+    links[root].len = 0;
+    fathers[root] = root;
+    heap_ids[root] = heap.push(links[root]);
+    while (!heap.is_empty()) {
+      unsigned int const u = heap.pop().i;
+      heap_ids[u] = id_treated;
+      if (u != root) {
+        tree.add(fathers[u], u, links[u].len);
+      }
+      Graph::VEdge const &edges = g.get_edges(u);
+      for (size_t k = 0; k < edges.size(); k++) {
+        unsigned int const v = edges[k].first;
+        float const len = edges[k].second;
+        if (Graph::is_removed(edges[k])) {
+          continue;
+        }
+        if (heap_ids[v] == id_undefined) {
+          links[v].len = len;
+          fathers[v] = u;
+          heap_ids[v] = heap.push(links[v]);
+        } else if (heap_ids[v] != id_treated && len < links[v].len) {
+          links[v].len = len;
+          fathers[v] = u;
+          heap.reposition(heap_ids[v]);
+        }
+      }
+    }
+  }
+
+  delete[] links;
+  delete[] fathers;
+  delete[] heap_ids;
+}
+
+void boruvka(Graph const &g, Spanning_Tree &tree, unsigned int nbr_workers) {
+  assert(!g.is_directed);
+  assert(0 < nbr_workers);
+  tree.clear();
+  unsigned int const n = g.nbr_vertices;
+  Boruvka_State s;
+  s.g = &g;
+  s.offsets = new unsigned int[n + 1];
+  s.tails = new unsigned int[g.get_nbr_arcs()];
+  s.components = new unsigned int[n];
+  s.best = new unsigned int[n];
+  s.hooks = new unsigned int[n];
+  s.added.resize(nbr_workers);
+  unsigned int position = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    s.offsets[i] = position;
+    for (size_t k = 0; k < g.get_edges(i).size(); k++) {
+      s.tails[position++] = i;
+    }
+    s.components[i] = i;
+    s.best[i] = no_edge;
+  }
+  s.offsets[n] = position;
+
+  bool is_merging = true;
+  while (is_merging) {
+    run_parallel(nbr_workers, offer_arcs, &s);
+    run_parallel(nbr_workers, hook_components, &s);
+    run_parallel(nbr_workers, relabel, &s);
+    is_merging = false;
+    for (unsigned int w = 0; w < nbr_workers; w++) {
+      for (size_t k = 0; k < s.added[w].size(); k++) {
+        Spanning_Tree::Tree_Edge const &e = s.added[w][k];
+        tree.add(e.i, e.j, e.len);
+      }
+      is_merging = is_merging || !s.added[w].empty();
+      s.added[w].clear();
+    }
+  }
+
+  delete[] s.offsets;
+  delete[] s.tails;
+  delete[] s.components;
+  delete[] s.best;
+  delete[] s.hooks;
+}
@@ -0,0 +1,95 @@
+#ifndef __MST_HPP_
+#define __MST_HPP_
+
+/*!
+ * \file
+ * \brief This module provides minimum spanning trees of Graph, with Prim's
+ * and Borůvka's algorithms.
+ *
+ * If the graph is not connected, a spanning tree of each connected component
+ * is computed (a minimum spanning forest).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+/*!
+ * \brief Edges of a minimum spanning forest, packed in an array, together
+ * with their total length.
+ */
+class Spanning_Tree {
+
+public:
+  /*!
+   * Type to store edges of the tree:
+   * \li endpoints \c i and \c j, and
+   * \li length.
+   */
+  class Tree_Edge {
+  public:
+    unsigned int i;
+    unsigned int j;
+    float len;
+
+    Tree_Edge(unsigned int _i, unsigned int _j, float _len)
+        : i(_i), j(_j), len(_len) {}
+  };
+
+  /*! Edges of the forest (at most \c nbr_vertices -1). */
+  std::vector<Tree_Edge> edges;
+
+  /*! Sum of the lengths of the edges. */
+  double total_length;
+
+  Spanning_Tree() : total_length(0) {}
+
+  /*! Remove all the edges. */
+  void clear() {
+    edges.clear();
+    total_length = 0;
+  }
+
+  /*! Add an edge. */
+  void add(unsigned int i, unsigned int j, float len) {
+    edges.push_back(Tree_Edge(i, j, len));
+    total_length += len;
+  }
+};
+
+/*!
+ * Compute a minimum spanning forest with Prim's algorithm: each tree is grown
+ * from a vertex, the closest vertex being picked with a Heap_Id.
+ * \param g graph.
+ * \param tree filled with the forest.
+ * \pre \c g is not directed.
+ */
+void prim(Graph const &g, Spanning_Tree &tree);
+
+/*!
+ * Compute a minimum spanning forest with Borůvka's algorithm: at each round,
+ * every component picks its lightest outgoing edge, and the components are
+ * merged along them. There are at most log2(\c nbr_vertices) rounds, each one
+ * a linear scan of the edges.
+ *
+ * Each round runs in three parallel phases, the vertices being split among
+ * the workers:
+ * \li every vertex offers its lightest outgoing edge to its component, with
+ * a compare-and-swap loop (lock-free minimum);
+ * \li every component hooks itself to the component across its lightest edge
+ * (of two components picking the same edge, the smaller one stays a root);
+ * \li every vertex follows the hooks to its new component.
+ * \param g graph.
+ * \param tree filled with the forest (in an order depending on the number of
+ * workers).
+ * \param nbr_workers number of threads.
+ * \pre \c g is not directed.
+ * \pre \c nbr_workers is at least 1.
+ */
+void boruvka(Graph const &g, Spanning_Tree &tree,
+             unsigned int nbr_workers = 1);
+
+#endif
@@ -0,0 +1,298 @@
+/*!
+ * \file
+ * \brief This module provides one-to-all searches on Graph from several
+ * sources at once.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <limits>
+
+#include "multi_source.hpp"
+#include "view.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MULTI_SOURCE_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/*! Constant to indicate that the node is not in the heap. */
+int const id_undefined = -1;
+
+/*! Distance of the vertices not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! A vertex with lowered lanes and the least of them. */
+struct Lowered {
+  unsigned int j;
+  float key;
+};
+
+/*!
+ * Relax the edges of a vertex for all the lanes.
+ * \param edges edges of the vertex.
+ * \param du distances of the vertex, one per lane.
+ * \param distances distances of all the vertices, updated.
+ * \param lowered filled with the heads with lowered lanes (room for one per
+ * edge).
+ * \return the number of heads with lowered lanes.
+ */
+size_t relax_lanes_scalar(Graph::VEdge const &edges, float const *du,
+                          float *distances, Lowered *lowered) {
+  size_t nbr_lowered = 0;
+  for (size_t e = 0; e < edges.size(); e++) {
+    float *const dv = distances + edges[e].first * Lane_Dijkstra::nbr_lanes;
+    float key = infinity;
+    for (unsigned int k = 0; k < Lane_Dijkstra::nbr_lanes; k++) {
+      float const candidate = du[k] + edges[e].second;
+      if (candidate < dv[k]) {
+        dv[k] = candidate;
+        key = (candidate < key) ? candidate : key;
+      }
+    }
+    if (key < infinity) {
+      lowered[nbr_lowered].j = edges[e].first;
+      lowered[nbr_lowered].key = key;
+      nbr_lowered++;
+    }
+  }
+  return nbr_lowered;
+}
+
+#ifdef MULTI_SOURCE_AVX2
+/*! Same as relax_lanes_scalar, the 8 lanes at a time. */
+__attribute__((target("avx2"))) size_t
+relax_lanes_avx2(Graph::VEdge const &edges, float const *du, float *distances,
+                 Lowered *lowered) {
+  __m256 const vu = _mm256_loadu_ps(du);
+  __m256 const vinf = _mm256_set1_ps(infinity);
+  size_t nbr_lowered = 0;
+  for (size_t e = 0; e < edges.size(); e++) {
+    float *const dv = distances + edges[e].first * Lane_Dijkstra::nbr_lanes;
+    __m256 const vv = _mm256_loadu_ps(dv);
+    __m256 const candidate = _mm256_add_ps(vu, _mm256_set1_ps(edges[e].second));
+    __m256 const better = _mm256_cmp_ps(candidate, vv, _CMP_LT_OQ);
+    if (_mm256_movemask_ps(better) == 0) {
+      continue;
+    }
+    _mm256_storeu_ps(dv, _mm256_blendv_ps(vv, candidate, better));
+    // least lowered lane
+    __m256 const m = _mm256_blendv_ps(vinf, candidate, better);
+    __m128 x = _mm_min_ps(_mm256_castps256_ps128(m),
+                          _mm256_extractf128_ps(m, 1));
+    x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+    x = _mm_min_ss(x, _mm_shuffle_ps(x, x, 1));
+    lowered[nbr_lowered].j = edges[e].first;
+    lowered[nbr_lowered].key = _mm_cvtss_f32(x);
+    nbr_lowered++;
+  }
+  return nbr_lowered;
+}
+#endif
+
+/*! Type of the relaxations of the edges of a vertex. */
+typedef size_t (*Relax_Lanes)(Graph::VEdge const &, float const *, float *,
+                              Lowered *);
+
+/*! \return the relaxation to use, according to the processor. */
+Relax_Lanes pick_relax_lanes() {
+#ifdef MULTI_SOURCE_AVX2
+  __builtin_cpu_init();
+  if (Lane_Dijkstra::nbr_lanes == 8 && __builtin_cpu_supports("avx2")) {
+    return relax_lanes_avx2;
+  }
+#endif
+  return relax_lanes_scalar;
+}
+
+/*! Relaxation used, chosen once. */
+Relax_Lanes const relax_lanes = pick_relax_lanes();
+
+/*!
+ * Same as relax_lanes_scalar, only along the arcs of a view.
+ * \param view view searched.
+ * \param u the vertex.
+ */
+size_t relax_lanes_in_view(Graph_View const &view, unsigned int u,
+                           Graph::VEdge const &edges, float const *du,
+                           float *distances, Lowered *lowered) {
+  size_t nbr_lowered = 0;
+  for (size_t e = 0; e < edges.size(); e++) {
+    if (!view.has_arc(u, e, edges[e].first)) {
+      continue;
+    }
+    float *const dv = distances + edges[e].first * Lane_Dijkstra::nbr_lanes;
+    float key = infinity;
+    for (unsigned int k = 0; k < Lane_Dijkstra::nbr_lanes; k++) {
+      float const candidate = du[k] + edges[e].second;
+      if (candidate < dv[k]) {
+        dv[k] = candidate;
+        key = (candidate < key) ? candidate : key;
+      }
+    }
+    if (key < infinity) {
+      lowered[nbr_lowered].j = edges[e].first;
+      lowered[nbr_lowered].key = key;
+      nbr_lowered++;
+    }
+  }
+  return nbr_lowered;
+}
+}
+
+//
+//  LANE DIJKSTRA
+//
+
+Lane_Dijkstra::Lane_Dijkstra(Graph const &_graph)
+    : graph(_graph), heap(_graph.nbr_vertices),
+      keys(new Dijkstra::Vertex_Key[_graph.nbr_vertices]),
+      heap_ids(new int[_graph.nbr_vertices]),
+      distances(new float[_graph.nbr_vertices * nbr_lanes]), nbr_treated(0),
+      view(NULL) {
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    keys[i].distance = infinity;
+    keys[i].i = i;
+    heap_ids[i] = id_undefined;
+  }
+  for (unsigned int k = 0; k < graph.nbr_vertices * nbr_lanes; k++) {
+    distances[k] = infinity;
+  }
+}
+
+Lane_Dijkstra::~Lane_Dijkstra() {
+  delete[] keys;
+  delete[] heap_ids;
+  delete[] distances;
+}
+
+void Lane_Dijkstra::run(vector<unsigned int> const &sources) {
+  assert(sources.size() <= nbr_lanes);
+  assert(!graph.has_negative_length());
+  for (unsigned int k = 0; k < graph.nbr_vertices * nbr_lanes; k++) {
+    distances[k] = infinity;
+  }
+  nbr_treated = 0;
+  for (size_t lane = 0; lane < sources.size(); lane++) {
+    unsigned int const s = sources[lane];
+    assert(s < graph.nbr_vertices);
+    assert(view == NULL || (&view->graph == &graph && view->has_vertex(s)));
+    distances[s * nbr_lanes + lane] = 0;
+    if (heap_ids[s] == id_undefined) {
+      keys[s].distance = 0;
+      heap_ids[s] = heap.push(keys[s]);
+    }
+  }
+
+  vector<Lowered> lowered;
+  while (!heap.is_empty()) {
+    unsigned int const u = heap.pop().i;
+    heap_ids[u] = id_undefined;
+    nbr_treated++;
+    Graph::VEdge const &edges = graph.get_edges(u);
+    if (lowered.size() < edges.size()) {
+      lowered.resize(edges.size());
+    }
+    Lowered *const room = lowered.empty() ? NULL : &lowered[0];
+    size_t const nbr_lowered =
+        (view == NULL)
+            ? relax_lanes(edges, distances + u * nbr_lanes, distances, room)
+            : relax_lanes_in_view(*view, u, edges, distances + u * nbr_lanes,
+                                  distances, room);
+    for (size_t k = 0; k < nbr_lowered; k++) {
+      unsigned int const v = lowered[k].j;
+      if (heap_ids[v] == id_undefined) {
+        keys[v].distance = lowered[k].key;
+        heap_ids[v] = heap.push(keys[v]);
+      } else if (lowered[k].key < keys[v].distance) {
+        keys[v].distance = lowered[k].key;
+        heap.reposition(heap_ids[v]);
+      }
+    }
+  }
+}
+
+//
+//  BIT-PARALLEL BFS
+//
+
+unsigned int const Bit_Parallel_Bfs::unreached =
+    numeric_limits<unsigned int>::max();
+
+Bit_Parallel_Bfs::Bit_Parallel_Bfs(Graph const &_graph)
+    : graph(_graph), seen(new unsigned int[_graph.nbr_vertices]),
+      visit(new unsigned int[_graph.nbr_vertices]),
+      visit_next(new unsigned int[_graph.nbr_vertices]),
+      hops(new unsigned int[_graph.nbr_vertices * nbr_lanes]), view(NULL) {
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    seen[i] = 0;
+    visit[i] = 0;
+    visit_next[i] = 0;
+  }
+}
+
+Bit_Parallel_Bfs::~Bit_Parallel_Bfs() {
+  delete[] seen;
+  delete[] visit;
+  delete[] visit_next;
+  delete[] hops;
+}
+
+void Bit_Parallel_Bfs::run(vector<unsigned int> const &sources) {
+  assert(sources.size() <= nbr_lanes);
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    seen[i] = 0;
+  }
+  for (unsigned int k = 0; k < graph.nbr_vertices * nbr_lanes; k++) {
+    hops[k] = unreached;
+  }
+  frontier.clear();
+  for (size_t lane = 0; lane < sources.size(); lane++) {
+    unsigned int const s = sources[lane];
+    assert(s < graph.nbr_vertices);
+    assert(view == NULL || (&view->graph == &graph && view->has_vertex(s)));
+    if (visit[s] == 0) {
+      frontier.push_back(s);
+    }
+    visit[s] |= 1u << lane;
+    seen[s] |= 1u << lane;
+    hops[s * nbr_lanes + lane] = 0;
+  }
+
+  for (unsigned int level = 1; !frontier.empty(); level++) {
+    next.clear();
+    for (size_t f = 0; f < frontier.size(); f++) {
+      unsigned int const u = frontier[f];
+      unsigned int const bits = visit[u];
+      visit[u] = 0;
+      Graph::VEdge const &edges = graph.get_edges(u);
+      for (size_t e = 0; e < edges.size(); e++) {
+        unsigned int const v = edges[e].first;
+        unsigned int const new_bits = bits & ~seen[v];
+        if (new_bits == 0 || Graph::is_removed(edges[e]) ||
+            (view != NULL && !view->has_arc(u, e, v))) {
+          continue;
+        }
+        if (visit_next[v] == 0) {
+          next.push_back(v);
+        }
+        visit_next[v] |= new_bits;
+        seen[v] |= new_bits;
+        for (unsigned int b = new_bits; b != 0; b &= b - 1) {
+          hops[v * nbr_lanes + __builtin_ctz(b)] = level;
+        }
+      }
+    }
+    // The next level becomes the current one
+    for (size_t k = 0; k < next.size(); k++) {
+      visit[next[k]] = visit_next[next[k]];
+      visit_next[next[k]] = 0;
+    }
+    frontier.swap(next);
+  }
+}
@@ -0,0 +1,220 @@
+#ifndef __MULTI_SOURCE_HPP_
+#define __MULTI_SOURCE_HPP_
+
+/*!
+ * \file
+ * \brief This module provides one-to-all searches on Graph from several
+ * sources at once, sharing the scans of the adjacency lists: a Dijkstra
+ * search over lanes of distances and a bit-parallel breadth-first search.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "graph.hpp"
+#include "heap_id.hpp"
+
+class Graph_View;
+
+/*!
+ * \brief Search workspace for Dijkstra's algorithm from nbr_lanes sources at
+ * once.
+ *
+ * Each vertex holds one distance per source (a lane), contiguous. A vertex
+ * is in the heap while some of its lanes were lowered since it was last
+ * treated, keyed by the least of these lanes. Treating a vertex relaxes its
+ * edges for all the lanes at once (with AVX2 when the processor has it), so
+ * that its adjacency list is read once for all the sources.
+ *
+ * A vertex may be treated more than once (when its lanes become final at
+ * different times), but far fewer than nbr_lanes times when the sources are
+ * close, as in batches of centrality or accessibility queries.
+ */
+class Lane_Dijkstra {
+
+public:
+  /*! Number of sources searched at once. */
+  static unsigned int const nbr_lanes = 8;
+
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! Heap of the vertices with lowered lanes. */
+  Heap_Id<Dijkstra::Vertex_Key> heap;
+
+  /*! Array of the keys (least lowered lane), indexed by vertex number. */
+  Dijkstra::Vertex_Key *const keys;
+
+  /*! Array of the heap ids of the vertices, or id_undefined. */
+  int *const heap_ids;
+
+  /*! Array of the distances, indexed by vertex number then lane. */
+  float *const distances;
+
+  /*! Number of vertices treated by the last search. */
+  unsigned int nbr_treated;
+
+  /*! View of the searches (NULL if none). */
+  Graph_View const *view;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _graph.
+   * \param _graph graph to search, it must not be destroyed before the
+   * workspace.
+   */
+  Lane_Dijkstra(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Lane_Dijkstra();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Compute the distance from each source to every vertex.
+   * \param sources source vertices, one per lane.
+   * \pre there are at most nbr_lanes sources, legal vertex numbers.
+   * \pre the graph has no negative length.
+   */
+  void run(std::vector<unsigned int> const &sources);
+
+  /*!
+   * Set the view used by the next searches: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the searches are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+
+  /*!
+   * Distance found by the last search.
+   * \param lane position of the source in the sources.
+   * \param i vertex number.
+   * \pre \c lane is less than nbr_lanes and \c i is a legal vertex number.
+   * \return the distance from the source of \c lane to \c i (infinity if
+   * unreachable).
+   */
+  float get_distance(unsigned int lane, unsigned int i) const {
+    assert(lane < nbr_lanes);
+    assert(i < graph.nbr_vertices);
+    return distances[i * nbr_lanes + lane];
+  }
+
+  /*! \return the number of vertices treated by the last search (counting
+   * every time a vertex is treated). */
+  unsigned int get_nbr_treated() const { return nbr_treated; }
+};
+
+/*!
+ * \brief Search workspace for a breadth-first search from nbr_lanes sources
+ * at once.
+ *
+ * Each vertex holds a bit per source: the sources that reached it, and the
+ * ones that reached it at the current level. A level scans the edges of the
+ * vertices reached at the previous one once for all the sources, with word
+ * operations. The edge lengths are ignored: the results are hop distances.
+ */
+class Bit_Parallel_Bfs {
+
+public:
+  /*! Number of sources searched at once (bits of a word). */
+  static unsigned int const nbr_lanes = 32;
+
+  /*! Hop distance of the vertices not reached. */
+  static unsigned int const unreached;
+
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! Array of the sources that reached each vertex, one bit per lane. */
+  unsigned int *const seen;
+
+  /*! Array of the sources that reached each vertex at the current level. */
+  unsigned int *const visit;
+
+  /*! Array of the sources that reached each vertex at the next level. */
+  unsigned int *const visit_next;
+
+  /*! Array of the hop distances, indexed by vertex number then lane. */
+  unsigned int *const hops;
+
+  /*! Vertices reached at the current level. */
+  std::vector<unsigned int> frontier;
+
+  /*! Vertices reached at the next level. */
+  std::vector<unsigned int> next;
+
+  /*! View of the searches (NULL if none). */
+  Graph_View const *view;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _graph.
+   * \param _graph graph to search, it must not be destroyed before the
+   * workspace.
+   */
+  Bit_Parallel_Bfs(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Bit_Parallel_Bfs();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Compute the hop distances from each source to every vertex.
+   * \param sources source vertices, one per lane.
+   * \pre there are at most nbr_lanes sources, legal vertex numbers.
+   */
+  void run(std::vector<unsigned int> const &sources);
+
+  /*!
+   * Set the view used by the next searches: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the searches are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+
+  /*!
+   * Hop distance found by the last search.
+   * \param lane position of the source in the sources.
+   * \param i vertex number.
+   * \pre \c lane is less than nbr_lanes and \c i is a legal vertex number.
+   * \return the number of edges of a shortest path from the source of
+   * \c lane to \c i, or \c unreached.
+   */
+  unsigned int get_hops(unsigned int lane, unsigned int i) const {
+    assert(lane < nbr_lanes);
+    assert(i < graph.nbr_vertices);
+    return hops[i * nbr_lanes + lane];
+  }
+};
+
+#endif
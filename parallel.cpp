@@ -0,0 +1,220 @@
+/*!
+ * \file
+ * \brief This module provides a minimal fork-join over POSIX threads.
+ *
+ * The worker threads are kept between the calls (a pool, grown to the
+ * largest number of workers asked): the engines call run_parallel once per
+ * BFS level, Floyd–Warshall phase or Bellman–Ford round, where creating
+ * threads each time would cost more than the work of a small step. A call
+ * made while the pool is busy (from another thread, or from a task) falls
+ * back to threads of its own.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // min
+#include <vector>
+
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "parallel.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Arguments of a worker thread. */
+struct Worker {
+  unsigned int worker;
+  unsigned int nbr_workers;
+  Parallel_Task task;
+  void *context;
+};
+
+/*! Entry point of a worker thread. */
+void *run_worker(void *argument) {
+  Worker const &w = *static_cast<Worker const *>(argument);
+  w.task(w.worker, w.nbr_workers, w.context);
+  return NULL;
+}
+
+//
+//  POOL
+//
+
+/*! Held by the call using the pool. */
+pthread_mutex_t pool_busy = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Protects the job below and the number of threads. */
+pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Signalled when a job is posted. */
+pthread_cond_t pool_start = PTHREAD_COND_INITIALIZER;
+
+/*! Signalled when the last pooled worker of the job is done. */
+pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+
+/*! Number of threads of the pool: they are workers 1 to \c pool_size. */
+unsigned int pool_size = 0;
+
+/*! Number of the current job, raised by each post. */
+unsigned long pool_job = 0;
+
+/*! Current job: the workers below \c pool_first_inline run it in the
+ * pool, the others in the calling thread. */
+Parallel_Task pool_task = NULL;
+void *pool_context = NULL;
+unsigned int pool_nbr_workers = 0;
+unsigned int pool_first_inline = 0;
+
+/*! Number of pooled workers of the job not done yet. */
+unsigned int pool_nbr_running = 0;
+
+/*! Whether the pool is forgotten in the children of a fork. */
+bool is_fork_handled = false;
+
+/*! Arguments of a pool thread. */
+struct Pool_Worker {
+  unsigned int worker;
+  /*! Last job posted before the thread was created. */
+  unsigned long seen;
+};
+
+/*! Entry point of a pool thread: run the jobs posted, for ever. */
+void *run_pool_worker(void *argument) {
+  Pool_Worker *const start = static_cast<Pool_Worker *>(argument);
+  unsigned int const worker = start->worker;
+  unsigned long seen = start->seen;
+  delete start;
+  pthread_mutex_lock(&pool_lock);
+  for (;;) {
+    while (pool_job == seen) {
+      pthread_cond_wait(&pool_start, &pool_lock);
+    }
+    // A worker not in a job may skip it: the next one is posted once the
+    // workers in it are done
+    seen = pool_job;
+    if (worker < pool_first_inline) {
+      Parallel_Task const task = pool_task;
+      void *const context = pool_context;
+      unsigned int const nbr_workers = pool_nbr_workers;
+      pthread_mutex_unlock(&pool_lock);
+      task(worker, nbr_workers, context);
+      pthread_mutex_lock(&pool_lock);
+      if (--pool_nbr_running == 0) {
+        pthread_cond_signal(&pool_done);
+      }
+    }
+  }
+  return NULL;
+}
+
+/*! In the child of a fork, only the calling thread is left: forget the
+ * pool (its locks were free, as fork is not called from a task). */
+void forget_pool() {
+  pthread_mutex_init(&pool_busy, NULL);
+  pthread_mutex_init(&pool_lock, NULL);
+  pthread_cond_init(&pool_start, NULL);
+  pthread_cond_init(&pool_done, NULL);
+  pool_size = 0;
+}
+
+/*!
+ * Grow the pool to \c size threads, if it can.
+ * \pre \c pool_busy is held.
+ */
+void grow_pool(unsigned int size) {
+  if (!is_fork_handled) {
+    pthread_atfork(NULL, NULL, forget_pool);
+    is_fork_handled = true;
+  }
+  while (pool_size < size) {
+    // The thread waits for the jobs posted after its creation, even if it
+    // only starts after the next post
+    Pool_Worker *const start = new Pool_Worker;
+    start->worker = pool_size + 1;
+    start->seen = pool_job;
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, run_pool_worker, start) != 0) {
+      delete start;
+      break;
+    }
+    pthread_detach(thread);
+    pool_size++;
+  }
+}
+
+/*! Run a task on threads created for the call (when the pool is busy). */
+void run_on_new_threads(unsigned int nbr_workers, Parallel_Task task,
+                        void *context) {
+  vector<Worker> workers(nbr_workers);
+  vector<pthread_t> threads(nbr_workers);
+  for (unsigned int k = 0; k < nbr_workers; k++) {
+    workers[k].worker = k;
+    workers[k].nbr_workers = nbr_workers;
+    workers[k].task = task;
+    workers[k].context = context;
+  }
+  // A worker that cannot get a thread runs in the calling one
+  vector<bool> is_started(nbr_workers, false);
+  for (unsigned int k = 1; k < nbr_workers; k++) {
+    is_started[k] =
+        pthread_create(&threads[k], NULL, run_worker, &workers[k]) == 0;
+  }
+  task(0, nbr_workers, context);
+  for (unsigned int k = 1; k < nbr_workers; k++) {
+    if (is_started[k]) {
+      pthread_join(threads[k], NULL);
+    } else {
+      task(k, nbr_workers, context);
+    }
+  }
+}
+}
+
+unsigned int get_nbr_cores() {
+  long const nbr_cores = sysconf(_SC_NPROCESSORS_ONLN);
+  return (0 < nbr_cores) ? nbr_cores : 1;
+}
+
+void run_parallel(unsigned int nbr_workers, Parallel_Task task,
+                  void *context) {
+  assert(0 < nbr_workers);
+  if (nbr_workers == 1) {
+    task(0, 1, context);
+    return;
+  }
+  if (pthread_mutex_trylock(&pool_busy) != 0) {
+    run_on_new_threads(nbr_workers, task, context);
+    return;
+  }
+  grow_pool(nbr_workers - 1);
+
+  // POST the job to the pool, whose workers wake up
+  pthread_mutex_lock(&pool_lock);
+  pool_task = task;
+  pool_context = context;
+  pool_nbr_workers = nbr_workers;
+  pool_first_inline = min(nbr_workers, pool_size + 1);
+  pool_nbr_running = pool_first_inline - 1;
+  pool_job++;
+  pthread_cond_broadcast(&pool_start);
+  pthread_mutex_unlock(&pool_lock);
+
+  // Worker 0, and the workers that could not get a thread, run here
+  task(0, nbr_workers, context);
+  for (unsigned int k = pool_first_inline; k < nbr_workers; k++) {
+    task(k, nbr_workers, context);
+  }
+
+  // WAIT for the pooled workers: the lock makes their writes visible
+  pthread_mutex_lock(&pool_lock);
+  while (0 < pool_nbr_running) {
+    pthread_cond_wait(&pool_done, &pool_lock);
+  }
+  pthread_mutex_unlock(&pool_lock);
+  pthread_mutex_unlock(&pool_busy);
+}
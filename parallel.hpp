@@ -0,0 +1,79 @@
+#ifndef __PARALLEL_HPP_
+#define __PARALLEL_HPP_
+
+/*!
+ * \file
+ * \brief This module provides a minimal fork-join over POSIX threads, for the
+ * engines that split their work across cores.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * Task run by each worker of run_parallel.
+ * \param worker worker number, from 0.
+ * \param nbr_workers number of workers.
+ * \param context context given to run_parallel.
+ */
+typedef void (*Parallel_Task)(unsigned int worker, unsigned int nbr_workers,
+                              void *context);
+
+/*! \return the number of cores online (at least 1). */
+unsigned int get_nbr_cores();
+
+/*! Fewest items worth a worker of their own: waking a worker costs about as
+ * much as a few hundred relaxed arcs. */
+unsigned int const min_items_per_worker = 1024;
+
+/*!
+ * Number of workers worth splitting a step on.
+ * \param nbr_workers number of workers available.
+ * \param nbr_items number of items of the step.
+ * \return at most \c nbr_workers, with \c min_items_per_worker items each,
+ * and at least 1.
+ */
+inline unsigned int get_nbr_useful_workers(unsigned int nbr_workers,
+                                           size_t nbr_items) {
+  size_t const useful = nbr_items / min_items_per_worker;
+  if (useful < 1) {
+    return 1;
+  }
+  return (useful < nbr_workers) ? static_cast<unsigned int>(useful)
+                                : nbr_workers;
+}
+
+/*!
+ * Run a task on several workers and wait for them all: worker 0 is the
+ * calling thread, the others are threads of a pool kept between the calls
+ * (or threads of their own if the pool is busy). Everything written by
+ * the workers is visible to the caller on return. The workers must not wait
+ * for each other (a phase that needs all the others done is a new call).
+ * \param nbr_workers number of workers.
+ * \param task task run by each worker.
+ * \param context context given to the task.
+ * \pre \c nbr_workers is at least 1.
+ */
+void run_parallel(unsigned int nbr_workers, Parallel_Task task,
+                  void *context);
+
+/*!
+ * Share of a worker in a range of items split in contiguous slices.
+ * \param worker worker number.
+ * \param nbr_workers number of workers.
+ * \param size number of items.
+ * \param first,last filled with the slice of the worker: [first, last[.
+ */
+inline void get_slice(unsigned int worker, unsigned int nbr_workers,
+                      unsigned int size, unsigned int &first,
+                      unsigned int &last) {
+  first = static_cast<unsigned int>(static_cast<uint64_t>(size) * worker /
+                                    nbr_workers);
+  last = static_cast<unsigned int>(static_cast<uint64_t>(size) *
+                                   (worker + 1) / nbr_workers);
+}
+
+#endif
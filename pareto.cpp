@@ -0,0 +1,153 @@
+/*!
+ * \file
+ * \brief This module provides multi-criteria shortest paths on Graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // lower_bound, push_heap, pop_heap, reverse
+#include <functional> // greater
+
+#include "pareto.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+Pareto_Search::Pareto_Search(Graph const &_graph)
+    : graph(_graph), offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      arc_costs(new Costs[_graph.get_nbr_arcs()]),
+      bags(new vector<Bag_Entry>[_graph.nbr_vertices]), target(0),
+      view(NULL) {
+  assert(!graph.has_negative_length());
+  unsigned int position = 0;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    offsets[i] = position;
+    Graph::VEdge const &edges = graph.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      Costs &costs = arc_costs[position++];
+      costs.values[0] = edges[k].second;
+      for (unsigned int c = 1; c < nbr_criteria; c++) {
+        costs.values[c] = 0;
+      }
+    }
+  }
+  offsets[graph.nbr_vertices] = position;
+}
+
+Pareto_Search::~Pareto_Search() {
+  delete[] offsets;
+  delete[] arc_costs;
+  delete[] bags;
+}
+
+bool Pareto_Search::is_dominated(unsigned int i, Costs const &costs) const {
+  // Only the entries with a first cost at most the one of costs may dominate
+  // them: the bag is sorted
+  vector<Bag_Entry> const &bag = bags[i];
+  for (size_t k = 0;
+       k < bag.size() && bag[k].costs.values[0] <= costs.values[0]; k++) {
+    if (bag[k].costs.dominates(costs)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Pareto_Search::add_label(unsigned int i, Costs const &costs,
+                              unsigned int parent) {
+  if (is_dominated(i, costs) || is_dominated(target, costs)) {
+    return;
+  }
+  Label label;
+  label.costs = costs;
+  label.vertex = i;
+  label.parent = parent;
+  label.is_dead = false;
+  Bag_Entry entry;
+  entry.costs = costs;
+  entry.label = labels.size();
+  labels.push_back(label);
+
+  // Drop the entries dominated by the new one (all after it in the bag)
+  vector<Bag_Entry> &bag = bags[i];
+  if (bag.empty()) {
+    touched.push_back(i);
+  }
+  vector<Bag_Entry>::iterator const position =
+      lower_bound(bag.begin(), bag.end(), entry);
+  vector<Bag_Entry>::iterator kept = position;
+  for (vector<Bag_Entry>::iterator e = position; e != bag.end(); ++e) {
+    if (costs.dominates(e->costs)) {
+      labels[e->label].is_dead = true;
+    } else {
+      *kept++ = *e;
+    }
+  }
+  bag.erase(kept, bag.end());
+  bag.insert(position, entry);
+
+  queue.push_back(entry);
+  push_heap(queue.begin(), queue.end(), greater<Bag_Entry>());
+}
+
+unsigned int Pareto_Search::run(unsigned int from, unsigned int to) {
+  assert(from < graph.nbr_vertices);
+  assert(to < graph.nbr_vertices);
+  assert(view == NULL || (&view->graph == &graph && view->has_vertex(from)));
+  for (size_t k = 0; k < touched.size(); k++) {
+    bags[touched[k]].clear();
+  }
+  touched.clear();
+  labels.clear();
+  queue.clear();
+  target = to;
+  if (!graph.is_connected(from, to)) {
+    return 0;
+  }
+
+  Costs zero;
+  for (unsigned int c = 0; c < nbr_criteria; c++) {
+    zero.values[c] = 0;
+  }
+  add_label(from, zero, 0);
+  while (!queue.empty()) {
+    pop_heap(queue.begin(), queue.end(), greater<Bag_Entry>());
+    unsigned int const l = queue.back().label;
+    queue.pop_back();
+    // Labels dropped from their bag, at the target, or dominated at the
+    // target since they were added, are not extended
+    if (labels[l].is_dead || labels[l].vertex == target ||
+        is_dominated(target, labels[l].costs)) {
+      continue;
+    }
+    unsigned int const u = labels[l].vertex;
+    Costs const costs = labels[l].costs;
+    Graph::VEdge const &edges = graph.get_edges(u);
+    Costs const *const edge_costs = arc_costs + offsets[u];
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (Graph::is_removed(edges[k]) ||
+          (view != NULL && !view->has_arc(u, k, edges[k].first))) {
+        continue;
+      }
+      Costs next;
+      for (unsigned int c = 0; c < nbr_criteria; c++) {
+        next.values[c] = costs.values[c] + edge_costs[k].values[c];
+      }
+      add_label(edges[k].first, next, l);
+    }
+  }
+  return bags[target].size();
+}
+
+void Pareto_Search::get_path(unsigned int s, vector<unsigned int> &path) const {
+  assert(s < bags[target].size());
+  path.clear();
+  unsigned int l = bags[target][s].label;
+  while (labels[l].parent != l) {
+    path.push_back(labels[l].vertex);
+    l = labels[l].parent;
+  }
+  path.push_back(labels[l].vertex);
+  reverse(path.begin(), path.end());
+}
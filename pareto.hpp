@@ -0,0 +1,247 @@
+#ifndef __PARETO_HPP_
+#define __PARETO_HPP_
+
+/*!
+ * \file
+ * \brief This module provides multi-criteria shortest paths on Graph (e.g.
+ * time and toll): the Pareto-optimal paths between two vertices.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "graph.hpp"
+
+class Graph_View;
+
+/*!
+ * \brief Search workspace for the Pareto-optimal paths between two vertices
+ * of a Graph, on nbr_criteria costs per edge.
+ *
+ * The first cost of an edge is its length, the others are a column along the
+ * edges of the graph (as the weights of a Profile), 0 unless set. A path is
+ * Pareto-optimal if no other path is at most as costly on every criterion
+ * (and the paths of equal costs are only given once).
+ *
+ * Label-setting search: a label is a path to a vertex, with its costs. The
+ * labels are taken in lexicographic order of their costs, so that a label
+ * taken is never dominated afterwards. Each vertex has a bag of the labels
+ * not dominated, sorted by costs; a new label dominated by the bag of its
+ * vertex, or by the bag of the target (target pruning, costs being
+ * non-negative), is dropped, and the labels it dominates are dropped from the
+ * bag.
+ */
+class Pareto_Search {
+
+public:
+  /*! Number of costs of an edge. */
+  static unsigned int const nbr_criteria = 2;
+
+  /*!
+   * Costs of an edge or of a path.
+   */
+  class Costs {
+  public:
+    /*! Cost on each criterion. */
+    float values[nbr_criteria];
+
+    /*! Lexicographic comparison. */
+    bool operator<(Costs const &c2) const {
+      for (unsigned int c = 0; c < nbr_criteria; c++) {
+        if (values[c] != c2.values[c]) {
+          return values[c] < c2.values[c];
+        }
+      }
+      return false;
+    }
+
+    /*! \return true iff the costs are at most \c c2 on every criterion. */
+    bool dominates(Costs const &c2) const {
+      for (unsigned int c = 0; c < nbr_criteria; c++) {
+        if (c2.values[c] < values[c]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  /*! The graph searched. */
+  Graph const &graph;
+
+private:
+  /*! A path to a vertex. */
+  class Label {
+  public:
+    Costs costs;
+    unsigned int vertex;
+    /*! Label of the path without its last edge (itself at the source). */
+    unsigned int parent;
+    /*! Whether the label was dropped from its bag. */
+    bool is_dead;
+  };
+
+  /*! Entry of a bag: the costs of a label (next to each other). */
+  class Bag_Entry {
+  public:
+    Costs costs;
+    unsigned int label;
+
+    /*! Order of the bags: by costs. */
+    bool operator<(Bag_Entry const &e2) const { return costs < e2.costs; }
+
+    /*! Order of the queue, reversed: by costs, then by label. */
+    bool operator>(Bag_Entry const &e2) const {
+      return e2.costs < costs || (!(costs < e2.costs) && e2.label < label);
+    }
+  };
+
+  /*! Array of the position of the costs of each vertex, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Array of the costs of the arcs, vertex by vertex. */
+  Costs *const arc_costs;
+
+  /*! Labels of the last query. */
+  std::vector<Label> labels;
+
+  /*! Array of the bags, sorted by costs, indexed by vertex number. */
+  std::vector<Bag_Entry> *const bags;
+
+  /*! Vertices with a bag in the last query (to reset them). */
+  std::vector<unsigned int> touched;
+
+  /*! Labels not taken yet: a heap of the smallest entry on top. */
+  std::vector<Bag_Entry> queue;
+
+  /*! Target of the last query. */
+  unsigned int target;
+
+  /*! View of the queries (NULL if none). */
+  Graph_View const *view;
+
+  /*!
+   * To know if costs are dominated by the bag of a vertex.
+   * \param i vertex number.
+   * \param costs costs.
+   */
+  bool is_dominated(unsigned int i, Costs const &costs) const;
+
+  /*!
+   * Add a label, unless it is dominated.
+   * \param i vertex of the label.
+   * \param costs costs of the label.
+   * \param parent label of the path without its last edge.
+   */
+  void add_label(unsigned int i, Costs const &costs, unsigned int parent);
+
+  /*! Not copyable. */
+  Pareto_Search(Pareto_Search const &);
+
+  /*! Not assignable. */
+  Pareto_Search &operator=(Pareto_Search const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace, with the lengths as first costs and 0 as the others.
+   * \param _graph graph, it must not be destroyed before the workspace, nor
+   * get new edges.
+   * \pre \c _graph has no negative length.
+   */
+  Pareto_Search(Graph const &_graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Pareto_Search();
+
+  //
+  //  COSTS
+  //
+
+  /*!
+   * Set a cost of an edge, in one direction: the reverse edge of an
+   * undirected graph keeps its own costs.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param criterion criterion, from 1 (criterion 0 is the length).
+   * \param cost new cost.
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \pre 0 < \c criterion < nbr_criteria and \c cost is positive or zero.
+   */
+  void set_cost(unsigned int i, size_t k, unsigned int criterion,
+                float cost) {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    assert(0 < criterion && criterion < nbr_criteria);
+    assert(0 <= cost);
+    arc_costs[offsets[i] + k].values[criterion] = cost;
+  }
+
+  /*!
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \return the costs of the edge.
+   */
+  Costs const &get_costs(unsigned int i, size_t k) const {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    return arc_costs[offsets[i] + k];
+  }
+
+  //
+  //  QUERIES
+  //
+
+  /*!
+   * Search the Pareto-optimal paths between two vertices.
+   * \param from,to endpoints.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \return the number of Pareto-optimal paths (0 if \c to is unreachable).
+   */
+  unsigned int run(unsigned int from, unsigned int to);
+
+  /*! \return the number of Pareto-optimal paths found by the last query. */
+  unsigned int get_nbr_solutions() const { return bags[target].size(); }
+
+  /*!
+   * Costs of a path found by the last query.
+   * \param s number of the path, by increasing first cost.
+   * \pre \c s is less than get_nbr_solutions().
+   */
+  Costs const &get_solution(unsigned int s) const {
+    assert(s < bags[target].size());
+    return bags[target][s].costs;
+  }
+
+  /*!
+   * Path found by the last query.
+   * \param s number of the path, by increasing first cost.
+   * \param path filled with the vertices of the path, from the source.
+   * \pre \c s is less than get_nbr_solutions().
+   */
+  void get_path(unsigned int s, std::vector<unsigned int> &path) const;
+
+  /*! \return the number of labels created by the last query. */
+  unsigned int get_nbr_labels() const { return labels.size(); }
+
+  /*!
+   * Set the view used by the next queries: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the queries are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+};
+
+#endif
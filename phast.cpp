@@ -0,0 +1,184 @@
+/*!
+ * \file
+ * \brief This module provides PHAST: one-to-all shortest distances by a
+ * linear sweep over a contraction hierarchy.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <limits>
+
+#include "phast.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHAST_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/*! Constant to indicate that the node is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the node was treated. */
+int const id_treated = -2;
+
+/*! Distance of the vertices not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*!
+ * Downward sweep of many_to_all: for each rank by decreasing order and each
+ * lane, \c d[rank][lane] = min over the upward arcs of
+ * \c d[head][lane] + length.
+ * \param ch hierarchy.
+ * \param d distances, indexed by rank then lane.
+ */
+void sweep_lanes_scalar(Contraction_Hierarchy const &ch, float *d) {
+  for (unsigned int r = ch.nbr_vertices; 0 < r--;) {
+    float *const dr = d + r * Phast::nbr_lanes;
+    Contraction_Hierarchy::Arc const *const end = ch.get_arcs_end(r);
+    for (Contraction_Hierarchy::Arc const *a = ch.get_arcs_begin(r); a != end;
+         a++) {
+      float const *const dh = d + a->head * Phast::nbr_lanes;
+      for (unsigned int k = 0; k < Phast::nbr_lanes; k++) {
+        float const candidate = dh[k] + a->length;
+        dr[k] = (candidate < dr[k]) ? candidate : dr[k];
+      }
+    }
+  }
+}
+
+#ifdef PHAST_AVX2
+/*! Same as sweep_lanes_scalar, the 8 lanes at a time. */
+__attribute__((target("avx2"))) void
+sweep_lanes_avx2(Contraction_Hierarchy const &ch, float *d) {
+  for (unsigned int r = ch.nbr_vertices; 0 < r--;) {
+    float *const dr = d + r * Phast::nbr_lanes;
+    __m256 vr = _mm256_loadu_ps(dr);
+    Contraction_Hierarchy::Arc const *const end = ch.get_arcs_end(r);
+    for (Contraction_Hierarchy::Arc const *a = ch.get_arcs_begin(r); a != end;
+         a++) {
+      __m256 const dh = _mm256_loadu_ps(d + a->head * Phast::nbr_lanes);
+      vr = _mm256_min_ps(vr, _mm256_add_ps(dh, _mm256_set1_ps(a->length)));
+    }
+    _mm256_storeu_ps(dr, vr);
+  }
+}
+#endif
+
+/*! Type of the sweeps of many_to_all. */
+typedef void (*Sweep_Lanes)(Contraction_Hierarchy const &, float *);
+
+/*! \return the sweep to use, according to the processor. */
+Sweep_Lanes pick_sweep_lanes() {
+#ifdef PHAST_AVX2
+  __builtin_cpu_init();
+  if (Phast::nbr_lanes == 8 && __builtin_cpu_supports("avx2")) {
+    return sweep_lanes_avx2;
+  }
+#endif
+  return sweep_lanes_scalar;
+}
+
+/*! Sweep used, chosen once. */
+Sweep_Lanes const sweep_lanes = pick_sweep_lanes();
+}
+
+Phast::Phast(Contraction_Hierarchy const &_ch)
+    : ch(_ch), heap(_ch.nbr_vertices),
+      keys(new Dijkstra::Vertex_Key[_ch.nbr_vertices]),
+      heap_ids(new int[_ch.nbr_vertices]),
+      distances(new float[_ch.nbr_vertices]),
+      lane_distances(new float[_ch.nbr_vertices * nbr_lanes]) {
+  for (unsigned int r = 0; r < ch.nbr_vertices; r++) {
+    keys[r].distance = infinity;
+    keys[r].i = r;
+    heap_ids[r] = id_undefined;
+    distances[r] = infinity;
+  }
+  for (unsigned int k = 0; k < ch.nbr_vertices * nbr_lanes; k++) {
+    lane_distances[k] = infinity;
+  }
+}
+
+Phast::~Phast() {
+  delete[] keys;
+  delete[] heap_ids;
+  delete[] distances;
+  delete[] lane_distances;
+}
+
+void Phast::search_upward(unsigned int from) {
+  for (size_t k = 0; k < touched.size(); k++) {
+    keys[touched[k]].distance = infinity;
+    heap_ids[touched[k]] = id_undefined;
+  }
+  touched.clear();
+  heap.clear();
+
+  unsigned int const s = ch.get_rank(from);
+  keys[s].distance = 0;
+  heap_ids[s] = heap.push(keys[s]);
+  touched.push_back(s);
+  while (!heap.is_empty()) {
+    unsigned int const r = heap.pop().i;
+    heap_ids[r] = id_treated;
+    float const dr = keys[r].distance;
+    Contraction_Hierarchy::Arc const *const end = ch.get_arcs_end(r);
+    for (Contraction_Hierarchy::Arc const *a = ch.get_arcs_begin(r); a != end;
+         a++) {
+      float const dh = dr + a->length;
+      if (heap_ids[a->head] == id_undefined) {
+        keys[a->head].distance = dh;
+        heap_ids[a->head] = heap.push(keys[a->head]);
+        touched.push_back(a->head);
+      } else if (heap_ids[a->head] != id_treated &&
+                 dh < keys[a->head].distance) {
+        keys[a->head].distance = dh;
+        heap.reposition(heap_ids[a->head]);
+      }
+    }
+  }
+}
+
+void Phast::one_to_all(unsigned int from) {
+  search_upward(from);
+  for (unsigned int r = 0; r < ch.nbr_vertices; r++) {
+    distances[r] = infinity;
+  }
+  for (size_t k = 0; k < touched.size(); k++) {
+    distances[touched[k]] = keys[touched[k]].distance;
+  }
+
+  // DOWNWARD SWEEP
+  for (unsigned int r = ch.nbr_vertices; 0 < r--;) {
+    float dr = distances[r];
+    Contraction_Hierarchy::Arc const *const end = ch.get_arcs_end(r);
+    for (Contraction_Hierarchy::Arc const *a = ch.get_arcs_begin(r); a != end;
+         a++) {
+      float const candidate = distances[a->head] + a->length;
+      dr = (candidate < dr) ? candidate : dr;
+    }
+    distances[r] = dr;
+  }
+}
+
+void Phast::many_to_all(vector<unsigned int> const &sources) {
+  assert(sources.size() <= nbr_lanes);
+  for (unsigned int k = 0; k < ch.nbr_vertices * nbr_lanes; k++) {
+    lane_distances[k] = infinity;
+  }
+  for (size_t lane = 0; lane < sources.size(); lane++) {
+    search_upward(sources[lane]);
+    for (size_t k = 0; k < touched.size(); k++) {
+      lane_distances[touched[k] * nbr_lanes + lane] =
+          keys[touched[k]].distance;
+    }
+  }
+
+  // DOWNWARD SWEEP, all the lanes at once
+  sweep_lanes(ch, lane_distances);
+}
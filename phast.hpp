@@ -0,0 +1,137 @@
+#ifndef __PHAST_HPP_
+#define __PHAST_HPP_
+
+/*!
+ * \file
+ * \brief This module provides PHAST: one-to-all shortest distances by a
+ * linear sweep over a contraction hierarchy.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "ch.hpp"
+#include "dijkstra.hpp"
+#include "heap_id.hpp"
+
+/*!
+ * \brief Search workspace for PHAST on a Contraction_Hierarchy.
+ *
+ * A one-to-all query is made of:
+ * \li a Dijkstra search from the source following the upward arcs only
+ * (which is small), then
+ * \li a sweep over the vertices by decreasing rank, without heap: the
+ * distance of each vertex is the minimum over its upward arcs of the distance
+ * of the head plus the length, the heads being already final.
+ *
+ * The sweep reads the arcs and the distances in the order of the ranks, so
+ * it is bound by the memory bandwidth rather than by cache misses.
+ *
+ * Several sources (up to nbr_lanes) can be swept at once: the distances are
+ * then interleaved, one lane per source, so that an arc is read once for all
+ * of them and relaxed for all the lanes with vector instructions (AVX2 when
+ * the processor has them).
+ */
+class Phast {
+
+public:
+  /*! Number of sources swept at once by many_to_all. */
+  static unsigned int const nbr_lanes = 8;
+
+  /*! The hierarchy searched. */
+  Contraction_Hierarchy const &ch;
+
+private:
+  /*! Heap of the upward search. */
+  Heap_Id<Dijkstra::Vertex_Key> heap;
+
+  /*! Array of the keys of the upward search, indexed by rank. */
+  Dijkstra::Vertex_Key *const keys;
+
+  /*! Array of the heap ids of the upward search, or id_undefined /
+   * id_treated. */
+  int *const heap_ids;
+
+  /*! Ranks reached by the last upward search (to reset them). */
+  std::vector<unsigned int> touched;
+
+  /*! Array of the distances of the last one_to_all, indexed by rank. */
+  float *const distances;
+
+  /*! Array of the distances of the last many_to_all, indexed by rank then
+   * lane. */
+  float *const lane_distances;
+
+  /*!
+   * Dijkstra search from \c from following the upward arcs only: the
+   * distances are in \c keys for the ranks in \c touched.
+   * \param from source vertex.
+   * \pre \c from is a legal vertex number.
+   */
+  void search_upward(unsigned int from);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _ch.
+   * \param _ch hierarchy to search, it must not be destroyed before the
+   * workspace.
+   */
+  Phast(Contraction_Hierarchy const &_ch);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Phast();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * One-to-all query: compute the distance from \c from to every vertex.
+   * \param from source vertex.
+   * \pre \c from is a legal vertex number.
+   */
+  void one_to_all(unsigned int from);
+
+  /*!
+   * Distance found by the last one_to_all.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the distance to \c i (infinity if unreachable).
+   */
+  float get_distance(unsigned int i) const {
+    return distances[ch.get_rank(i)];
+  }
+
+  /*!
+   * Many-to-all query: compute the distance from each source to every
+   * vertex, with a single sweep.
+   * \param sources source vertices, one per lane.
+   * \pre there are at most nbr_lanes sources, legal vertex numbers.
+   */
+  void many_to_all(std::vector<unsigned int> const &sources);
+
+  /*!
+   * Distance found by the last many_to_all.
+   * \param lane position of the source in the sources.
+   * \param i vertex number.
+   * \pre \c lane is a lane of a source and \c i a legal vertex number.
+   * \return the distance from the source of \c lane to \c i (infinity if
+   * unreachable).
+   */
+  float get_distance(unsigned int lane, unsigned int i) const {
+    assert(lane < nbr_lanes);
+    return lane_distances[ch.get_rank(i) * nbr_lanes + lane];
+  }
+};
+
+#endif
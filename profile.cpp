@@ -0,0 +1,30 @@
+/*!
+ * \file
+ * \brief This module provides profiles to search a Graph with a mode and
+ * weights of its own.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "profile.hpp"
+
+Profile::Profile(Graph const &_graph, Graph::Modes _modes)
+    : graph(_graph), modes(_modes),
+      offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      weights(new float[_graph.get_nbr_arcs()]) {
+  unsigned int position = 0;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    offsets[i] = position;
+    Graph::VEdge const &edges = graph.get_edges(i);
+    for (size_t k = 0; k < edges.size(); k++) {
+      weights[position++] = edges[k].second;
+    }
+  }
+  offsets[graph.nbr_vertices] = position;
+}
+
+Profile::~Profile() {
+  delete[] offsets;
+  delete[] weights;
+}
@@ -0,0 +1,105 @@
+#ifndef __PROFILE_HPP_
+#define __PROFILE_HPP_
+
+/*!
+ * \file
+ * \brief This module provides profiles (e.g. car, bike, foot) to search a
+ * Graph with a mode and weights of its own, without copying the graph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "graph.hpp"
+
+/*!
+ * \brief Profile of a search on a Graph: the edges usable and their weights.
+ *
+ * An edge is usable iff one of the modes of the profile is allowed on it
+ * (Graph::get_modes). Its weight is its length unless set otherwise (e.g. a
+ * travel time at the speed of the mode).
+ *
+ * Implementation: the weights are a column along the edges of the graph,
+ * vertex by vertex in the order of Graph::get_edges, so that a search reads
+ * them next to the edges.
+ */
+class Profile {
+
+public:
+  /*! The graph of the profile. */
+  Graph const &graph;
+
+  /*! Modes of the profile. */
+  Graph::Modes const modes;
+
+private:
+  /*! Array of the position of the weights of each vertex, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Array of the weights of the edges, vertex by vertex. */
+  float *const weights;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a profile with the lengths as weights.
+   * \param _graph graph, it must not be destroyed before the profile, nor
+   * get new edges.
+   * \param _modes modes of the profile.
+   */
+  Profile(Graph const &_graph, Graph::Modes _modes);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Profile();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To know if an edge is usable.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \return true iff one of the modes is allowed on the edge.
+   */
+  bool is_allowed(unsigned int i, size_t k) const {
+    return (graph.get_modes(i)[k] & modes) != 0;
+  }
+
+  /*!
+   * Set the weight of an edge, in one direction: the reverse edge of an
+   * undirected graph keeps its own weight.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param weight new weight.
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   * \pre \c weight is positive or zero.
+   */
+  void set_weight(unsigned int i, size_t k, float weight) {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    assert(0 <= weight);
+    weights[offsets[i] + k] = weight;
+  }
+
+  /*!
+   * To access the weights of the edges going out of a vertex.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   * \return the weight of each edge of get_edges(i), in the same order.
+   */
+  float const *get_weights(unsigned int i) const {
+    assert(i < graph.nbr_vertices);
+    return weights + offsets[i];
+  }
+};
+
+#endif
@@ -0,0 +1,660 @@
+/*!
+ * \file
+ * \brief Query server: loads a graph once and answers shortest path queries
+ * received on a Unix domain socket.
+ *
+ * Usage:
+ * \verbatim ./query_server <graph file> <socket path> [<nbr workers> [<max ms>]] \endverbatim
+ * The graph file is in the format of Graph::read. A request running for more
+ * than \c max ms milliseconds (no limit by default) is stopped and answered
+ * with what was found so far.
+ *
+ * Messages (requests and responses) are a \c uint32 giving the length of the
+ * payload followed by the payload, all in host byte order. A request longer
+ * than 16 MiB closes the connection.
+ *
+ * A request payload is a \c uint32 tag, chosen by the client, and a one
+ * byte kind followed by:
+ * \li 0, point-to-point: \c uint32 from, \c uint32 to;
+ * \li 1, one-to-many: \c uint32 from, \c uint32 count, \c count \c uint32
+ * targets;
+ * \li 2, isochrone: \c uint32 from, \c float radius.
+ *
+ * A response payload is the \c uint32 tag of its request and a one byte
+ * status (0 ok, 1 bad request, 2 partial: out of time) followed, when ok or
+ * partial, by:
+ * \li point-to-point: \c float distance, \c uint32 count, \c count \c uint32
+ * vertices of the path from \c from to \c to;
+ * \li one-to-many: \c count \c float distances;
+ * \li isochrone: \c uint32 count, \c count pairs of \c uint32 vertex and
+ * \c float distance.
+ * Unreachable vertices are at infinite distance. For a partial response,
+ * distances are the best known ones and the isochrone is truncated.
+ *
+ * The workers are processes forked after loading the graph (which is then
+ * shared), each one accepting connections on the socket with its own search
+ * workspaces. All the requests received by a read are processed as a batch:
+ * they are interleaved on a few workspaces, by slices of treated vertices, so
+ * that short requests are not stuck behind long ones. Responses are sent as
+ * soon as ready, hence possibly out of order. A one-to-many request stops
+ * once all its targets are treated, rather than searching the whole graph.
+ *
+ * A worker serves one connection at a time, where threads would share the
+ * connections of a process. This is acceptable as the clients are expected
+ * to keep a connection and pipeline their requests on it, which the batches
+ * above already spread over the workspaces of the worker; with one worker
+ * per core, every core is busy once there are as many clients, and the
+ * clients beyond wait in the listen backlog. Processes also keep a crash or
+ * a leak of a worker from touching the others.
+ *
+ * On SIGINT or SIGTERM, each worker reports on \c cerr its median (p50) and
+ * 99th percentile (p99) latencies and its throughput (QPS).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // sort
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dijkstra.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Kinds of request. */
+enum Request_Kind { point_to_point = 0, one_to_many = 1, isochrone = 2 };
+
+/*! Status of a response. */
+enum Response_Status {
+  status_ok = 0,
+  status_bad_request = 1,
+  status_partial = 2
+};
+
+/*! Size of the length prefix of the messages. */
+size_t const prefix_size = sizeof(uint32_t);
+
+/*! Maximal length of a request payload (the buffer of a connection holds
+ * at most one incomplete request). */
+uint32_t const max_request_size = 1 << 24;
+
+/*! Size of the reads on the connections. */
+size_t const read_size = 1 << 16;
+
+/*! Set by the signal handler to stop serving. */
+volatile sig_atomic_t stop_requested = 0;
+
+/*! Signal handler for SIGINT and SIGTERM. */
+void request_stop(int) { stop_requested = 1; }
+
+/*! \return the time in micro-seconds (monotonic clock). */
+double now_us() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+/*!
+ * To read values from a request payload.
+ */
+class Reader {
+
+  /*! Next byte to read. */
+  char const *current;
+
+  /*! End of the payload. */
+  char const *const end;
+
+public:
+  Reader(char const *begin, size_t size)
+      : current(begin), end(begin + size) {}
+
+  /*!
+   * Read a value.
+   * \param value filled with the value read.
+   * \return false iff the payload is too short.
+   */
+  template <class T> bool get(T &value) {
+    if (static_cast<size_t>(end - current) < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, current, sizeof(T));
+    current += sizeof(T);
+    return true;
+  }
+
+  /*! \return true iff the whole payload was read. */
+  bool is_done() const { return current == end; }
+};
+
+/*!
+ * Append a value to a response.
+ * \param out response buffer.
+ * \param value value to append.
+ */
+template <class T> void put(vector<char> &out, T const value) {
+  char const *bytes = reinterpret_cast<char const *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/*!
+ * Latencies of the requests answered by a worker.
+ */
+class Statistics {
+
+  /*! Latency of each request, in micro-seconds. */
+  vector<double> latencies;
+
+  /*! Time spent processing batches, in micro-seconds. */
+  double busy_us;
+
+public:
+  Statistics() : busy_us(0) {}
+
+  /*! Record the latency of a request. */
+  void add_request(double latency_us) { latencies.push_back(latency_us); }
+
+  /*! Record the processing time of a batch. */
+  void add_batch(double duration_us) { busy_us += duration_us; }
+
+  /*!
+   * Print the number of requests, p50, p99 and QPS.
+   * \param out stream to print to.
+   */
+  void report(ostream &out) {
+    out << "worker " << getpid() << ": " << latencies.size() << " requests";
+    if (!latencies.empty()) {
+      sort(latencies.begin(), latencies.end());
+      size_t const last = latencies.size() - 1;
+      out << ", p50 " << latencies[last / 2] << " us, p99 "
+          << latencies[last * 99 / 100] << " us, "
+          << latencies.size() / (busy_us * 1e-6) << " QPS";
+    }
+    out << endl;
+  }
+};
+
+/*!
+ * A request, from its parsing to its response.
+ */
+struct Pending {
+  /*! Tag of the request, echoed in its response. */
+  uint32_t tag;
+
+  /*! Kind of the request. */
+  uint8_t kind;
+
+  /*! Source vertex. */
+  uint32_t from;
+
+  /*! Target vertex (point-to-point). */
+  uint32_t to;
+
+  /*! Maximal distance (isochrone). */
+  float radius;
+
+  /*! Target vertices (one-to-many). */
+  vector<unsigned int> targets;
+
+  /*! Number of leading targets known to be treated or unreachable. */
+  size_t nbr_found;
+
+  /*! Time of reception, in micro-seconds. */
+  double arrival_us;
+};
+
+/*!
+ * Parse a request.
+ * \param in request payload.
+ * \param nbr_vertices number of vertices of the graph.
+ * \param request filled with the request.
+ * \return false iff the request is ill-formed (its tag is set if present).
+ */
+bool parse(Reader &in, unsigned int nbr_vertices, Pending &request) {
+  request.tag = 0;
+  request.nbr_found = 0;
+  if (!in.get(request.tag) || !in.get(request.kind) ||
+      !in.get(request.from) || nbr_vertices <= request.from) {
+    return false;
+  }
+  switch (request.kind) {
+  case point_to_point:
+    return in.get(request.to) && in.is_done() && request.to < nbr_vertices;
+  case one_to_many: {
+    uint32_t count;
+    if (!in.get(count)) {
+      return false;
+    }
+    for (size_t k = 0; k < count; k++) {
+      uint32_t to;
+      if (!in.get(to) || nbr_vertices <= to) {
+        return false;
+      }
+      request.targets.push_back(to);
+    }
+    return in.is_done();
+  }
+  case isochrone:
+    return in.get(request.radius) && in.is_done() && 0 <= request.radius;
+  default:
+    return false;
+  }
+}
+
+/*!
+ * Start a request on a workspace.
+ * \param search workspace to use.
+ * \param request request to start.
+ */
+void start(Dijkstra &search, Pending const &request) {
+  switch (request.kind) {
+  case point_to_point:
+    search.start_point_to_point(request.from, request.to);
+    break;
+  case one_to_many:
+    search.start_one_to_all(request.from);
+    break;
+  default:
+    search.start_isochrone(request.from, request.radius);
+  }
+}
+
+/*!
+ * Check whether a one-to-many request has all its targets treated (so that
+ * their distances are final), going on from the targets already found.
+ * \param search workspace processing the request.
+ * \param request request, its number of targets found is updated.
+ * \return true iff the request is one-to-many with all its targets found.
+ */
+bool has_found_targets(Dijkstra const &search, Pending &request) {
+  if (request.kind != one_to_many) {
+    return false;
+  }
+  while (request.nbr_found < request.targets.size()) {
+    unsigned int const to = request.targets[request.nbr_found];
+    if (!search.is_treated(to) &&
+        search.graph.is_connected(request.from, to)) {
+      return false;
+    }
+    request.nbr_found++;
+  }
+  return true;
+}
+
+/*!
+ * Append a response message.
+ * \param out buffer to append the response to.
+ * \param tag tag of the request.
+ * \param status status of the response.
+ * \return position of the response, to be given to end_response.
+ */
+size_t begin_response(vector<char> &out, uint32_t tag,
+                      Response_Status status) {
+  size_t const response_start = out.size();
+  put(out, static_cast<uint32_t>(0));
+  put(out, tag);
+  put(out, static_cast<uint8_t>(status));
+  return response_start;
+}
+
+/*!
+ * Set the length prefix of the last response message.
+ * \param out buffer holding the response.
+ * \param response_start position returned by begin_response.
+ */
+void end_response(vector<char> &out, size_t response_start) {
+  uint32_t const length = out.size() - response_start - prefix_size;
+  memcpy(&out[response_start], &length, prefix_size);
+}
+
+/*!
+ * Append the response of a finished request.
+ * \param search workspace that processed the request.
+ * \param request request.
+ * \param out buffer to append the response to.
+ */
+void respond(Dijkstra const &search, Pending const &request,
+             vector<char> &out) {
+  bool const is_complete =
+      search.get_status() == Dijkstra::status_complete ||
+      (request.kind == one_to_many &&
+       request.nbr_found == request.targets.size());
+  size_t const response_start = begin_response(
+      out, request.tag, is_complete ? status_ok : status_partial);
+  switch (request.kind) {
+  case point_to_point: {
+    vector<unsigned int> path;
+    search.get_path(request.to, path);
+    put(out, search.get_distance(request.to));
+    put(out, static_cast<uint32_t>(path.size()));
+    for (size_t k = 0; k < path.size(); k++) {
+      put(out, static_cast<uint32_t>(path[k]));
+    }
+    break;
+  }
+  case one_to_many:
+    for (size_t k = 0; k < request.targets.size(); k++) {
+      put(out, search.get_distance(request.targets[k]));
+    }
+    break;
+  default: {
+    vector<unsigned int> const &reached = search.get_treated();
+    put(out, static_cast<uint32_t>(reached.size()));
+    for (size_t k = 0; k < reached.size(); k++) {
+      put(out, static_cast<uint32_t>(reached[k]));
+      put(out, search.get_distance(reached[k]));
+    }
+  }
+  }
+  end_response(out, response_start);
+}
+
+/*!
+ * Write a whole buffer.
+ * \return false iff the connection failed.
+ */
+bool write_all(int fd, char const *data, size_t size) {
+  while (0 < size) {
+    ssize_t const n = write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR && !stop_requested) {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    size -= n;
+  }
+  return true;
+}
+
+/*!
+ * \brief Interleaves the requests of a batch on a few workspaces.
+ *
+ * Each running request is carried on by slices of \c slice_size treated
+ * vertices, in turn, so that short requests are not stuck behind long ones.
+ * Responses are written as soon as their request is finished, hence possibly
+ * out of order (they are matched by tag).
+ */
+class Scheduler {
+
+  /*! Number of vertices treated by a request before giving way. */
+  static unsigned int const slice_size = 1024;
+
+  /*! Number of requests run at the same time. */
+  static unsigned int const nbr_slots = 4;
+
+  /*! Workspaces, one per slot. */
+  std::vector<Dijkstra *> workspaces;
+
+  /*! Request of each slot. */
+  std::vector<Pending> running;
+
+  /*! Whether each slot is running a request. */
+  std::vector<bool> is_busy;
+
+  /*! Requests waiting for a slot. */
+  std::deque<Pending> waiting;
+
+  /*! Statistics to update. */
+  Statistics &stats;
+
+public:
+  Scheduler(Graph const &graph, Dijkstra::Budget const &budget,
+            Statistics &_stats)
+      : running(nbr_slots), is_busy(nbr_slots, false), stats(_stats) {
+    for (unsigned int k = 0; k < nbr_slots; k++) {
+      workspaces.push_back(new Dijkstra(graph));
+      workspaces[k]->set_budget(budget);
+    }
+  }
+
+  ~Scheduler() {
+    for (unsigned int k = 0; k < nbr_slots; k++) {
+      delete workspaces[k];
+    }
+  }
+
+  /*! Queue a parsed request. */
+  void add(Pending const &request) { waiting.push_back(request); }
+
+  /*!
+   * Drop the requests queued or running (those of a connection that ended),
+   * so that they are not answered to the next connection.
+   */
+  void reset() {
+    waiting.clear();
+    is_busy.assign(nbr_slots, false);
+  }
+
+  /*!
+   * Run the queued requests till they are all answered.
+   * \param fd connection to write the responses to.
+   * \return false iff the connection failed.
+   */
+  bool run(int fd) {
+    vector<char> out;
+    bool is_idle = false;
+    while (!is_idle && !stop_requested) {
+      is_idle = true;
+      out.clear();
+      for (unsigned int k = 0; k < nbr_slots; k++) {
+        if (!is_busy[k] && !waiting.empty()) {
+          running[k] = waiting.front();
+          waiting.pop_front();
+          start(*workspaces[k], running[k]);
+          is_busy[k] = true;
+        }
+        if (is_busy[k]) {
+          is_idle = false;
+          if (workspaces[k]->resume(slice_size) ||
+              has_found_targets(*workspaces[k], running[k])) {
+            respond(*workspaces[k], running[k], out);
+            stats.add_request(now_us() - running[k].arrival_us);
+            is_busy[k] = false;
+          }
+        }
+      }
+      if (!out.empty() && !write_all(fd, &out[0], out.size())) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/*!
+ * Answer the requests of a connection till it is closed.
+ * \param fd connection.
+ * \param graph graph to search.
+ * \param scheduler scheduler to run the requests.
+ * \param stats statistics to update.
+ */
+void serve_connection(int fd, Graph const &graph, Scheduler &scheduler,
+                      Statistics &stats) {
+  vector<char> in;  // received and not processed yet
+  vector<char> out; // responses to the ill-formed requests
+  size_t received = 0;
+  while (!stop_requested) {
+    if (in.size() < received + read_size) {
+      in.resize(received + read_size);
+    }
+    ssize_t const n = read(fd, &in[received], read_size);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    received += n;
+
+    // BATCH: every complete request received
+    double const batch_start = now_us();
+    size_t pos = 0;
+    out.clear();
+    while (prefix_size <= received - pos) {
+      uint32_t length;
+      memcpy(&length, &in[pos], prefix_size);
+      if (max_request_size < length) {
+        return;
+      }
+      if (received - pos < prefix_size + length) {
+        break;
+      }
+      Reader payload(&in[pos + prefix_size], length);
+      Pending request;
+      request.arrival_us = batch_start;
+      if (parse(payload, graph.nbr_vertices, request)) {
+        scheduler.add(request);
+      } else {
+        end_response(out, begin_response(out, request.tag, status_bad_request));
+        stats.add_request(now_us() - batch_start);
+      }
+      pos += prefix_size + length;
+    }
+    if (0 < pos) {
+      if ((!out.empty() && !write_all(fd, &out[0], out.size())) ||
+          !scheduler.run(fd)) {
+        return;
+      }
+      stats.add_batch(now_us() - batch_start);
+      // Keep the beginning of an incomplete request
+      copy(in.begin() + pos, in.begin() + received, in.begin());
+      received -= pos;
+    }
+  }
+}
+
+/*!
+ * Accept and serve connections till a stop is requested.
+ * \param listen_fd listening socket.
+ * \param graph graph to search.
+ * \param budget limits of each request.
+ */
+void serve(int listen_fd, Graph const &graph,
+           Dijkstra::Budget const &budget) {
+  Statistics stats;
+  Scheduler scheduler(graph, budget, stats);
+  while (!stop_requested) {
+    int const fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("accept");
+      break;
+    }
+    serve_connection(fd, graph, scheduler, stats);
+    scheduler.reset();
+    close(fd);
+  }
+  stats.report(cerr);
+}
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3 || 5 < argc) {
+    cerr << "usage: " << argv[0]
+         << " <graph file> <socket path> [<nbr workers> [<max ms>]]" << endl;
+    return 1;
+  }
+  int const nbr_workers = (4 <= argc) ? atoi(argv[3]) : 1;
+  if (nbr_workers < 1) {
+    cerr << "the number of workers must be positive" << endl;
+    return 1;
+  }
+  Dijkstra::Budget budget;
+  if (argc == 5) {
+    budget.max_seconds = atof(argv[4]) * 1e-3;
+    if (!(0 < budget.max_seconds)) {
+      cerr << "the maximal time must be positive" << endl;
+      return 1;
+    }
+  }
+
+  // LOAD THE GRAPH
+  ifstream file(argv[1]);
+  Graph *graph = Graph::read(file);
+  if (graph == NULL) {
+    cerr << "cannot read a graph from " << argv[1] << endl;
+    return 1;
+  }
+
+  // SOCKET
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (sizeof(address.sun_path) <= strlen(argv[2])) {
+    cerr << "socket path too long" << endl;
+    return 1;
+  }
+  strcpy(address.sun_path, argv[2]);
+  unlink(argv[2]);
+  int const listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0 ||
+      bind(listen_fd, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address)) < 0 ||
+      listen(listen_fd, SOMAXCONN) < 0) {
+    perror(argv[2]);
+    return 1;
+  }
+
+  // SIGNALS: no restart, so that blocking calls return on stop
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = request_stop;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  // WORKERS
+  vector<pid_t> workers;
+  for (int k = 0; k < nbr_workers; k++) {
+    pid_t const pid = fork();
+    if (pid == 0) {
+      serve(listen_fd, *graph, budget);
+      delete graph;
+      return 0;
+    }
+    if (pid < 0) {
+      perror("fork");
+      stop_requested = 1;
+      break;
+    }
+    workers.push_back(pid);
+  }
+  cerr << "serving " << argv[2] << " with " << workers.size() << " workers"
+       << endl;
+
+  while (!stop_requested) {
+    pause();
+  }
+  for (size_t k = 0; k < workers.size(); k++) {
+    kill(workers[k], SIGTERM);
+  }
+  for (size_t k = 0; k < workers.size(); k++) {
+    waitpid(workers[k], NULL, 0);
+  }
+  close(listen_fd);
+  unlink(argv[2]);
+  delete graph;
+  return 0;
+}
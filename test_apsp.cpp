@@ -0,0 +1,110 @@
+/*!
+ * \file
+ * \brief Test file: all-pairs shortest paths, checked against Dijkstra's
+ * algorithm.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "dijkstra.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  // graph of test_graph, plus an isolated vertex (10)
+  Graph g ( 11 ) ;
+
+  g . add_edge ( 0 , 1 , 2.0 ) ;
+  g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ;
+  g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ;
+  g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ;
+  g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ;
+  g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ;
+  g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ;
+  g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ;
+  g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ;
+  g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+
+  All_Pairs ap ( g ) ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    for ( unsigned int j = 0 ; j < g . nbr_vertices ; j ++ ) {
+      cout << ap . get_distance ( i , j ) << " " ;
+    }
+    cout << endl ;
+  }
+  vector < unsigned int > path ;
+  ap . get_path ( 0 , 9 , path ) ;
+  for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+    cout << path [ k ] << " " ;
+  }
+  cout << endl ;
+  cout << "0 -> 10: " << ap . get_path ( 0 , 10 , path ) << endl ;
+
+  // random graph over several tiles: compared to Dijkstra's algorithm
+  srand ( 2016 ) ;
+  Graph r ( 150 ) ;
+  for ( unsigned int k = 0 ; k < 600 ; k ++ ) {
+    r . add_edge ( rand () % 150 , rand () % 150 , 1 + rand () % 100 ) ;
+  }
+  All_Pairs r_ap ( r ) ;
+  Dijkstra search ( r ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    search . one_to_all ( i ) ;
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+      agree = agree && search . get_distance ( j ) == r_ap . get_distance ( i , j ) ;
+      // the path follows edges and has the right length
+      if ( r_ap . get_path ( i , j , path ) ) {
+        float length = 0 ;
+        for ( size_t k = 0 ; k + 1 < path . size () ; k ++ ) {
+          length += r_ap . get_distance ( path [ k ] , path [ k + 1 ] ) ;
+        }
+        agree = agree && length == r_ap . get_distance ( i , j ) ;
+      }
+    }
+  }
+  cout << "agree with Dijkstra: " << agree << endl ;
+
+  // tiles split across workers: the same matrices
+  All_Pairs r_parallel ( r , 3 ) ;
+  bool same = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+      same = same && r_parallel . get_distance ( i , j ) == r_ap . get_distance ( i , j ) ;
+      same = same && r_parallel . get_next_hop ( i , j ) == r_ap . get_next_hop ( i , j ) ;
+    }
+  }
+  cout << "parallel tiles agree: " << same << endl ;
+  cout << "negative cycle: " << r_ap . has_negative_cycle () << endl ;
+
+  // directed, with negative lengths but no negative cycle, then with one
+  Graph d ( 4 , true ) ;
+  d . add_arc ( 0 , 1 , 4.0 ) ;
+  d . add_arc ( 1 , 2 , -2.0 ) ;
+  d . add_arc ( 2 , 3 , 1.0 ) ;
+  d . add_arc ( 3 , 1 , 2.0 ) ;
+  All_Pairs d_ap ( d ) ;
+  cout << "0 -> 3: " << d_ap . get_distance ( 0 , 3 ) << ", negative cycle: "
+       << d_ap . has_negative_cycle () << endl ;
+  d . add_arc ( 3 , 1 , -0.5 ) ;
+  All_Pairs c_ap ( d ) ;
+  cout << "with 3 -> 1 of length -0.5, negative cycle: "
+       << c_ap . has_negative_cycle () << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file
+ * \brief Test file: runs ./batch_query on a small grid with a text query
+ * file, the same queries in a binary file, an empty file and a query on an
+ * illegal vertex, and prints the output records.
+ */
+
+# include <fstream>
+# include <iostream>
+# include <vector>
+
+# include <fcntl.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include <sys/wait.h>
+# include <unistd.h>
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Side of the grid searched. */
+  unsigned int const side = 4 ;
+
+  /*! A record of the output file. */
+  struct Record {
+    uint32_t from ;
+    uint32_t to ;
+    float distance ;
+    uint32_t nbr_edges ;
+  } ;
+
+  /*! Run ./batch_query with two workers.
+   * \return its exit status, or -1 if it did not exit.
+   */
+  int run_batch ( char const * graph_path , char const * query_path ,
+                  char const * output_path ) {
+    pid_t const pid = fork () ;
+    if ( pid == 0 ) {
+      int const null_fd = open ( "/dev/null" , O_WRONLY ) ;
+      dup2 ( null_fd , 2 ) ;
+      execl ( "./batch_query" , "./batch_query" , graph_path , query_path ,
+              output_path , "2" , static_cast < char * > ( NULL ) ) ;
+      _exit ( 127 ) ;
+    }
+    int status ;
+    waitpid ( pid , & status , 0 ) ;
+    return WIFEXITED ( status ) ? WEXITSTATUS ( status ) : -1 ;
+  }
+
+  /*! Read the records of an output file. */
+  vector < Record > read_records ( char const * path ) {
+    ifstream file ( path , ios :: binary ) ;
+    vector < Record > records ;
+    Record r ;
+    while ( file . read ( reinterpret_cast < char * > ( & r ) , sizeof ( r ) ) ) {
+      records . push_back ( r ) ;
+    }
+    return records ;
+  }
+
+  /*! Print records. */
+  void print ( vector < Record > const & records ) {
+    for ( size_t k = 0 ; k < records . size () ; k ++ ) {
+      cout << records [ k ] . from << " -> " << records [ k ] . to << ": "
+           << records [ k ] . distance << " in " << records [ k ] . nbr_edges
+           << " edges" << endl ;
+    }
+  }
+
+  /*! \return whether two lists of records are the same. */
+  bool same ( vector < Record > const & a , vector < Record > const & b ) {
+    return a . size () == b . size ()
+      && ( a . empty () || memcmp ( & a [ 0 ] , & b [ 0 ] ,
+                                    a . size () * sizeof ( Record ) ) == 0 ) ;
+  }
+
+}
+
+
+int main () {
+
+  // GRID, the horizontal edges of length 1, the vertical ones of length 3
+  char graph_path [ 64 ] ;
+  char csv_path [ 64 ] ;
+  char binary_path [ 64 ] ;
+  char output_path [ 64 ] ;
+  sprintf ( graph_path , "/tmp/test_batch_query_%d.txt" , getpid () ) ;
+  sprintf ( csv_path , "/tmp/test_batch_query_%d.csv" , getpid () ) ;
+  sprintf ( binary_path , "/tmp/test_batch_query_%d.bin" , getpid () ) ;
+  sprintf ( output_path , "/tmp/test_batch_query_%d.out" , getpid () ) ;
+  {
+    ofstream file ( graph_path ) ;
+    file << side * side + 1 << endl ;
+    for ( unsigned int i = 0 ; i < side * side ; i ++ ) {
+      if ( ( i + 1 ) % side != 0 ) {
+        file << i << " " << i + 1 << " 1.0" << endl ;
+      }
+      if ( i + side < side * side ) {
+        file << i << " " << i + side << " 3.0" << endl ;
+      }
+    }
+  }
+
+  // TEXT QUERIES, the last one to the isolated vertex
+  uint32_t const queries [] = { 0 , 15 , 15 , 0 , 5 , 5 , 3 , 12 , 0 , 16 } ;
+  size_t const nbr_queries = sizeof ( queries ) / sizeof ( queries [ 0 ] ) / 2 ;
+  {
+    ofstream file ( csv_path ) ;
+    for ( size_t k = 0 ; k < nbr_queries ; k ++ ) {
+      file << queries [ 2 * k ] << "," << queries [ 2 * k + 1 ] << endl ;
+    }
+  }
+  cout << "csv: status " << run_batch ( graph_path , csv_path , output_path )
+       << endl ;
+  vector < Record > const csv_records = read_records ( output_path ) ;
+  print ( csv_records ) ;
+
+  // BINARY QUERIES, the same ones
+  {
+    ofstream file ( binary_path , ios :: binary ) ;
+    file . write ( reinterpret_cast < char const * > ( queries ) ,
+                   sizeof ( queries ) ) ;
+  }
+  cout << "binary: status "
+       << run_batch ( graph_path , binary_path , output_path ) << endl ;
+  cout << "same records as csv: "
+       << same ( read_records ( output_path ) , csv_records ) << endl ;
+
+  // EMPTY FILES
+  {
+    ofstream csv_file ( csv_path , ios :: trunc ) ;
+    ofstream binary_file ( binary_path , ios :: binary | ios :: trunc ) ;
+  }
+  cout << "empty csv: status "
+       << run_batch ( graph_path , csv_path , output_path ) << ", "
+       << read_records ( output_path ) . size () << " records" << endl ;
+  cout << "empty binary: status "
+       << run_batch ( graph_path , binary_path , output_path ) << ", "
+       << read_records ( output_path ) . size () << " records" << endl ;
+
+  // ILLEGAL VERTEX
+  {
+    ofstream file ( csv_path , ios :: trunc ) ;
+    file << "0,1" << endl << "2," << side * side + 1 << endl ;
+  }
+  cout << "illegal vertex: status "
+       << run_batch ( graph_path , csv_path , output_path ) << endl ;
+  {
+    uint32_t const bad [] = { side * side + 1 , 0 } ;
+    ofstream file ( binary_path , ios :: binary | ios :: trunc ) ;
+    file . write ( reinterpret_cast < char const * > ( bad ) , sizeof ( bad ) ) ;
+  }
+  cout << "illegal vertex in binary: status "
+       << run_batch ( graph_path , binary_path , output_path ) << endl ;
+
+  unlink ( graph_path ) ;
+  unlink ( csv_path ) ;
+  unlink ( binary_path ) ;
+  unlink ( output_path ) ;
+  return 0 ;
+}
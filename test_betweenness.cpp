@@ -0,0 +1,222 @@
+/*!
+ * \file
+ * \brief Test file: betweenness centralities, checked against a count of the
+ * shortest paths pair by pair (with Floyd–Warshall distances), then merged
+ * and estimated on samples.
+ */
+
+# include <algorithm>
+# include <iostream>
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "betweenness.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! To order the vertices by distance from a source. */
+  class Closer {
+    All_Pairs const & ap ;
+    unsigned int const s ;
+  public:
+    Closer ( All_Pairs const & _ap , unsigned int _s ) : ap ( _ap ) , s ( _s ) {}
+    bool operator () ( unsigned int i , unsigned int j ) const {
+      return ap . get_distance ( s , i ) < ap . get_distance ( s , j ) ;
+    }
+  } ;
+
+  /*! \return true iff \c a and \c b are equal, up to rounding. */
+  bool near ( double a , double b ) {
+    return fabs ( a - b ) <= 1e-9 * ( 1 + fabs ( a ) + fabs ( b ) ) ;
+  }
+
+  /*! \return true iff the centralities of \c bc are the ones counted pair by
+   * pair. */
+  bool agree ( Graph const & g , Betweenness const & bc ) {
+    unsigned int const n = g . nbr_vertices ;
+    All_Pairs ap ( g ) ;
+    // sigmas [ s ] [ t ]: number of shortest paths from s to t
+    vector < vector < double > > sigmas ( n , vector < double > ( n , 0 ) ) ;
+    for ( unsigned int s = 0 ; s < n ; s ++ ) {
+      vector < unsigned int > order ;
+      for ( unsigned int i = 0 ; i < n ; i ++ ) {
+        order . push_back ( i ) ;
+      }
+      sort ( order . begin () , order . end () , Closer ( ap , s ) ) ;
+      sigmas [ s ] [ s ] = 1 ;
+      for ( unsigned int k = 0 ; k < n ; k ++ ) {
+        unsigned int const u = order [ k ] ;
+        for ( size_t e = 0 ; e < g . get_edges ( u ) . size () ; e ++ ) {
+          unsigned int const v = g . get_edges ( u ) [ e ] . first ;
+          if ( v != u && ap . get_distance ( s , u ) + g . get_edges ( u ) [ e ] . second
+               == ap . get_distance ( s , v ) ) {
+            sigmas [ s ] [ v ] += sigmas [ s ] [ u ] ;
+          }
+        }
+      }
+    }
+    double const scale = g . is_directed ? 1 : 0.5 ;
+    bool same = true ;
+    for ( unsigned int v = 0 ; v < n ; v ++ ) {
+      double c = 0 ;
+      for ( unsigned int s = 0 ; s < n ; s ++ ) {
+        for ( unsigned int t = 0 ; t < n ; t ++ ) {
+          if ( s != v && t != v && s != t && 0 < sigmas [ s ] [ t ]
+               && ap . get_distance ( s , v ) + ap . get_distance ( v , t )
+               == ap . get_distance ( s , t ) ) {
+            c += sigmas [ s ] [ v ] * sigmas [ v ] [ t ] / sigmas [ s ] [ t ] ;
+          }
+        }
+      }
+      same = same && near ( c * scale , bc . get_vertex_centrality ( v ) ) ;
+      for ( size_t e = 0 ; e < g . get_edges ( v ) . size () ; e ++ ) {
+        unsigned int const w = g . get_edges ( v ) [ e ] . first ;
+        float const len = g . get_edges ( v ) [ e ] . second ;
+        double a = 0 ;
+        for ( unsigned int s = 0 ; s < n ; s ++ ) {
+          for ( unsigned int t = 0 ; t < n ; t ++ ) {
+            // both ways for an edge
+            for ( unsigned int way = 0 ; way < ( g . is_directed ? 1u : 2u ) ; way ++ ) {
+              unsigned int const x = ( way == 0 ) ? v : w ;
+              unsigned int const y = ( way == 0 ) ? w : v ;
+              if ( v != w && s != t && 0 < sigmas [ s ] [ t ]
+                   && ap . get_distance ( s , x ) + len + ap . get_distance ( y , t )
+                   == ap . get_distance ( s , t ) ) {
+                a += sigmas [ s ] [ x ] * sigmas [ y ] [ t ] / sigmas [ s ] [ t ] ;
+              }
+            }
+          }
+        }
+        same = same && near ( a * scale , bc . get_edge_centrality ( v , e ) ) ;
+      }
+    }
+    return same ;
+  }
+
+}
+
+
+int main () {
+
+  // path 0 - 1 - 2 - 3 - 4, and a diamond 4 - 5 - 7, 4 - 6 - 7
+  Graph g ( 8 ) ;
+  g . add_edge ( 0 , 1 , 1.0 ) ; g . add_edge ( 1 , 2 , 1.0 ) ;
+  g . add_edge ( 2 , 3 , 1.0 ) ; g . add_edge ( 3 , 4 , 1.0 ) ;
+  g . add_edge ( 4 , 5 , 1.0 ) ; g . add_edge ( 4 , 6 , 1.0 ) ;
+  g . add_edge ( 5 , 7 , 1.0 ) ; g . add_edge ( 6 , 7 , 1.0 ) ;
+  Betweenness bc ( g ) ;
+  bc . add_all_sources () ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    cout << bc . get_vertex_centrality ( i ) << " " ;
+  }
+  cout << endl ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    for ( size_t k = 0 ; k < g . get_edges ( i ) . size () ; k ++ ) {
+      if ( i < g . get_edges ( i ) [ k ] . first ) {
+        cout << i << "-" << g . get_edges ( i ) [ k ] . first << ":"
+             << bc . get_edge_centrality ( i , k ) << " " ;
+      }
+    }
+  }
+  cout << endl ;
+  cout << "exact error bound: " << bc . get_error_bound ( 0.95 ) << endl ;
+
+  // random graphs, many ties
+  srand ( 2016 ) ;
+  Graph r ( 30 ) ;
+  for ( unsigned int k = 0 ; k < 70 ; k ++ ) {
+    r . add_edge ( rand () % 30 , rand () % 30 , float ( 1 + rand () % 4 ) ) ;
+  }
+  Betweenness r_bc ( r ) ;
+  r_bc . add_all_sources () ;
+  cout << "undirected agree: " << agree ( r , r_bc ) << endl ;
+
+  Graph d ( 30 , true ) ;
+  for ( unsigned int k = 0 ; k < 120 ; k ++ ) {
+    d . add_arc ( rand () % 30 , rand () % 30 , float ( 1 + rand () % 4 ) ) ;
+  }
+  Betweenness d_bc ( d ) ;
+  d_bc . add_all_sources () ;
+  cout << "directed agree: " << agree ( d , d_bc ) << endl ;
+
+  // sources split between two accumulators, then merged
+  Betweenness odd ( r ) ;
+  Betweenness even ( r ) ;
+  for ( unsigned int s = 0 ; s < r . nbr_vertices ; s ++ ) {
+    if ( s % 2 == 0 ) {
+      even . add_source ( s ) ;
+    } else {
+      odd . add_source ( s ) ;
+    }
+  }
+  even . merge ( odd ) ;
+  cout << "merged agree: " << agree ( r , even ) << endl ;
+
+  // sources split across workers: the same centralities
+  Betweenness r_parallel ( r ) ;
+  r_parallel . add_all_sources ( 3 ) ;
+  Betweenness d_parallel ( d ) ;
+  d_parallel . add_all_sources ( 4 ) ;
+  bool parallel_same = r_parallel . get_nbr_sources () == r . nbr_vertices ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    parallel_same = parallel_same
+      && near ( r_parallel . get_vertex_centrality ( i ) , r_bc . get_vertex_centrality ( i ) )
+      && near ( d_parallel . get_vertex_centrality ( i ) , d_bc . get_vertex_centrality ( i ) ) ;
+    for ( size_t e = 0 ; e < r . get_edges ( i ) . size () ; e ++ ) {
+      parallel_same = parallel_same
+        && near ( r_parallel . get_edge_centrality ( i , e ) , r_bc . get_edge_centrality ( i , e ) ) ;
+    }
+    for ( size_t e = 0 ; e < d . get_edges ( i ) . size () ; e ++ ) {
+      parallel_same = parallel_same
+        && near ( d_parallel . get_edge_centrality ( i , e ) , d_bc . get_edge_centrality ( i , e ) ) ;
+    }
+  }
+  cout << "parallel agree: " << parallel_same << endl ;
+
+  // samples: within the error bound
+  Betweenness sample ( r ) ;
+  sample . add_sampled_sources ( 20 , 7 ) ;
+  double const bound = sample . get_error_bound ( 0.95 ) ;
+  double worst = 0 ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    worst = max ( worst , fabs ( sample . get_vertex_centrality ( i )
+                                 - r_bc . get_vertex_centrality ( i ) ) ) ;
+  }
+  cout << "sample of " << sample . get_nbr_sources ()
+       << " sources, within the bound: " << ( worst <= bound ) << endl ;
+  Betweenness sample_parallel ( r ) ;
+  sample_parallel . add_sampled_sources ( 20 , 7 , 3 ) ;
+  bool sample_same = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    sample_same = sample_same && near ( sample_parallel . get_vertex_centrality ( i ) ,
+                                        sample . get_vertex_centrality ( i ) ) ;
+  }
+  cout << "parallel sample agrees: " << sample_same << endl ;
+  Betweenness all ( r ) ;
+  all . add_sampled_sources ( 30 , 7 ) ;
+  bool same = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    same = same && near ( all . get_vertex_centrality ( i ) ,
+                          r_bc . get_vertex_centrality ( i ) ) ;
+  }
+  cout << "sample of all the sources is exact: " << same
+       << ", bound " << all . get_error_bound ( 0.95 ) << endl ;
+
+  // two parallel edges of the same length: each one, with its own edge
+  // back, is on half of the shortest paths through 0-1
+  Graph p ( 3 ) ;
+  p . add_edge ( 0 , 1 , 1.0 ) ;
+  p . add_edge ( 0 , 1 , 1.0 ) ;
+  p . add_edge ( 1 , 2 , 1.0 ) ;
+  Betweenness p_bc ( p ) ;
+  p_bc . add_all_sources () ;
+  cout << "parallel edges: " << p_bc . get_edge_centrality ( 0 , 0 ) << " "
+       << p_bc . get_edge_centrality ( 0 , 1 ) << endl ;
+  return 0 ;
+}
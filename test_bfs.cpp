@@ -0,0 +1,121 @@
+/*!
+ * \file
+ * \brief Test file: breadth-first searches on graphs with edges of the same
+ * length, checked against Dijkstra's algorithm.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "bfs.hpp"
+# include "dijkstra.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Print the hop distances of the last search.
+   * \param search workspace.
+   */
+  void print_hops ( Bfs const & search ) {
+    for ( unsigned int i = 0 ; i < search . graph . nbr_vertices ; i ++ ) {
+      if ( search . get_hops ( i ) == Bfs :: unreached ) {
+        cout << "- " ;
+      } else {
+        cout << search . get_hops ( i ) << " " ;
+      }
+    }
+    cout << endl ;
+  }
+
+}
+
+
+int main () {
+
+  // 4 x 4 grid, plus an isolated vertex (16)
+  Graph grid ( 17 ) ;
+  for ( unsigned int i = 0 ; i < 16 ; i ++ ) {
+    if ( i % 4 < 3 ) {
+      grid . add_edge ( i , i + 1 , 2.5 ) ;
+    }
+    if ( i < 12 ) {
+      grid . add_edge ( i , i + 4 , 2.5 ) ;
+    }
+  }
+  cout << "common length: " << grid . has_common_length () << endl ;
+
+  Bfs search ( grid ) ;
+  search . run ( 0 , grid . nbr_vertices ) ;
+  print_hops ( search ) ;
+  search . run ( 5 , 6 ) ;
+  print_hops ( search ) ;
+  vector < unsigned int > path ;
+  search . run ( 0 , 15 ) ;
+  search . get_path ( 15 , path ) ;
+  for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+    cout << path [ k ] << " " ;
+  }
+  cout << endl ;
+  grid . print_dijkstra ( 0 , 15 ) ;
+  grid . print_dijkstra ( 0 , 16 ) ;
+
+  // star: the frontier holds most of the graph (bottom-up steps)
+  Graph star ( 200 ) ;
+  for ( unsigned int i = 1 ; i < 100 ; i ++ ) {
+    star . add_edge ( 0 , i , 1.0 ) ;
+    star . add_edge ( i , 99 + i , 1.0 ) ;
+  }
+  Bfs star_search ( star ) ;
+  star_search . run ( 0 , star . nbr_vertices ) ;
+  cout << star_search . get_hops ( 1 ) << " " << star_search . get_hops ( 198 )
+       << " " << ( star_search . get_hops ( 199 ) == Bfs :: unreached ) << endl ;
+
+  // random graph: compared to Dijkstra's algorithm
+  srand ( 2016 ) ;
+  Graph g ( 500 ) ;
+  for ( unsigned int k = 0 ; k < 1500 ; k ++ ) {
+    g . add_edge ( rand () % 500 , rand () % 500 , 1.0 ) ;
+  }
+  Bfs g_search ( g ) ;
+  Dijkstra g_dijkstra ( g ) ;
+  bool agree = true ;
+  for ( unsigned int from = 0 ; from < 500 ; from += 50 ) {
+    g_search . run ( from , g . nbr_vertices ) ;
+    g_dijkstra . one_to_all ( from ) ;
+    for ( unsigned int i = 0 ; i < 500 ; i ++ ) {
+      float const d = g_dijkstra . get_distance ( i ) ;
+      unsigned int const h = g_search . get_hops ( i ) ;
+      agree = agree && ( h == Bfs :: unreached ? d > 1e30 : d == h ) ;
+    }
+  }
+  cout << "agree with Dijkstra: " << agree << endl ;
+
+  // levels split across workers: same hops, paths of the right length
+  Bfs one_worker ( g ) ;
+  bool same = true ;
+  for ( unsigned int nbr_workers = 2 ; nbr_workers <= 4 ; nbr_workers ++ ) {
+    g_search . set_nbr_workers ( nbr_workers ) ;
+    for ( unsigned int from = 0 ; from < 500 ; from += 50 ) {
+      one_worker . run ( from , g . nbr_vertices ) ;
+      g_search . run ( from , g . nbr_vertices ) ;
+      for ( unsigned int i = 0 ; i < 500 ; i ++ ) {
+        unsigned int const h = g_search . get_hops ( i ) ;
+        same = same && h == one_worker . get_hops ( i ) ;
+        if ( h != Bfs :: unreached ) {
+          g_search . get_path ( i , path ) ;
+          same = same && path . size () == h + 1 ;
+        }
+      }
+    }
+  }
+  star_search . set_nbr_workers ( 3 ) ;
+  star_search . run ( 0 , star . nbr_vertices ) ;
+  same = same && star_search . get_hops ( 198 ) == 2 ;
+  cout << "parallel levels agree: " << same << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,146 @@
+/*!
+ * \file
+ * \brief Test file: closeness and harmonic centralities with every engine,
+ * checked against Floyd–Warshall distances.
+ */
+
+# include <iostream>
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "closeness.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Number of calls of count_calls. */
+  unsigned int nbr_calls = 0 ;
+
+  /*! Progress callback: counts its calls, checks the last one. */
+  void count_calls ( unsigned int nbr_done , unsigned int nbr_sources ,
+                     void * context ) {
+    nbr_calls ++ ;
+    * static_cast < bool * > ( context ) = ( nbr_done == nbr_sources ) ;
+  }
+
+  /*! \return true iff \c a and \c b are equal, up to rounding. */
+  bool near ( double a , double b ) {
+    return fabs ( a - b ) <= 1e-5 * ( 1 + fabs ( a ) + fabs ( b ) ) ;
+  }
+
+  /*! \return true iff the centralities of \c c are the ones of the
+   * Floyd–Warshall distances. */
+  bool agree ( Graph const & g , Closeness const & c ) {
+    All_Pairs ap ( g ) ;
+    bool same = true ;
+    for ( unsigned int v = 0 ; v < g . nbr_vertices ; v ++ ) {
+      double sum = 0 , inverse = 0 ;
+      unsigned int reached = 0 ;
+      for ( unsigned int u = 0 ; u < g . nbr_vertices ; u ++ ) {
+        float const d = ap . get_distance ( v , u ) ;
+        if ( u != v && d < numeric_limits < float > :: infinity () ) {
+          sum += d ;
+          inverse += 1 / d ;
+          reached ++ ;
+        }
+      }
+      same = same && near ( c . get_closeness () [ v ] , ( 0 < sum ) ? reached / sum : 0 )
+        && near ( c . get_harmonic () [ v ] , inverse ) ;
+    }
+    return same ;
+  }
+
+}
+
+
+int main () {
+
+  char const * const names [] = { "dijkstra" , "lane dijkstra" , "phast" ,
+                                  "bit-parallel bfs" } ;
+
+  // path 0 - 1 - 2 - 3, and an isolated vertex
+  Graph p ( 5 ) ;
+  p . add_edge ( 0 , 1 , 1.0 ) ; p . add_edge ( 1 , 2 , 1.0 ) ;
+  p . add_edge ( 2 , 3 , 1.0 ) ;
+  Closeness pc ( p ) ;
+  cout << "engine: " << names [ pc . get_engine () ] << endl ;
+  pc . run_all () ;
+  for ( unsigned int i = 0 ; i < p . nbr_vertices ; i ++ ) {
+    cout << pc . get_closeness () [ i ] << "/" << pc . get_harmonic () [ i ] << " " ;
+  }
+  cout << endl ;
+
+  // unweighted grid with random extra edges
+  srand ( 2016 ) ;
+  Graph u ( 100 ) ;
+  for ( unsigned int i = 0 ; i < 100 ; i ++ ) {
+    if ( i % 10 != 9 ) {
+      u . add_edge ( i , i + 1 , 2.0 ) ;
+    }
+    if ( i + 10 < 100 ) {
+      u . add_edge ( i , i + 10 , 2.0 ) ;
+    }
+  }
+  for ( unsigned int k = 0 ; k < 10 ; k ++ ) {
+    u . add_edge ( rand () % 100 , rand () % 100 , 2.0 ) ;
+  }
+  Closeness uc ( u ) ;
+  bool is_complete = false ;
+  uc . run_all ( count_calls , & is_complete ) ;
+  cout << "unweighted, engine " << names [ uc . get_engine () ] << ": "
+       << agree ( u , uc ) << ", progress calls " << nbr_calls
+       << ", complete " << is_complete << endl ;
+
+  // weighted undirected, every engine
+  Graph w ( 60 ) ;
+  for ( unsigned int k = 0 ; k < 150 ; k ++ ) {
+    w . add_edge ( rand () % 60 , rand () % 60 , float ( 1 + rand () % 30 ) ) ;
+  }
+  Closeness wc ( w ) ;
+  cout << "weighted, engine " << names [ wc . get_engine () ] << endl ;
+  for ( unsigned int e = 0 ; e < Closeness :: engine_bit_parallel_bfs ; e ++ ) {
+    Closeness c ( w ) ;
+    c . set_engine ( Closeness :: Engine ( e ) ) ;
+    // by two ranges
+    c . run ( 0 , 25 ) ;
+    c . run ( 25 , w . nbr_vertices ) ;
+    cout << "  " << names [ e ] << ": " << agree ( w , c ) << endl ;
+  }
+
+  // sources split across workers: the same arrays
+  for ( unsigned int e = 0 ; e <= Closeness :: engine_bit_parallel_bfs ; e ++ ) {
+    Graph const & g = ( e == Closeness :: engine_bit_parallel_bfs ) ? u : w ;
+    Closeness one ( g ) ;
+    one . set_engine ( Closeness :: Engine ( e ) ) ;
+    one . run_all () ;
+    Closeness several ( g ) ;
+    several . set_engine ( Closeness :: Engine ( e ) ) ;
+    several . set_nbr_workers ( 3 ) ;
+    nbr_calls = 0 ;
+    is_complete = false ;
+    several . run_all ( count_calls , & is_complete ) ;
+    bool same = true ;
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      same = same && one . get_closeness () [ i ] == several . get_closeness () [ i ]
+        && one . get_harmonic () [ i ] == several . get_harmonic () [ i ] ;
+    }
+    cout << "  3 workers, " << names [ e ] << ": " << same
+         << ", complete " << is_complete << endl ;
+  }
+
+  // weighted directed
+  Graph d ( 60 , true ) ;
+  for ( unsigned int k = 0 ; k < 200 ; k ++ ) {
+    d . add_arc ( rand () % 60 , rand () % 60 , float ( 1 + rand () % 30 ) ) ;
+  }
+  Closeness dc ( d ) ;
+  dc . run_all () ;
+  cout << "directed, engine " << names [ dc . get_engine () ] << ": "
+       << agree ( d , dc ) << endl ;
+  return 0 ;
+}
@@ -0,0 +1,161 @@
+/*!
+ * \file
+ * \brief Test file: shortest paths within a resource budget, compared to the
+ * best of all the simple paths.
+ */
+
+# include <iostream>
+# include <limits>
+# include <vector>
+
+# include <stdlib.h>
+
+# include "constrained.hpp"
+# include "dijkstra.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Shortest simple path from \c i to \c to within a budget.
+   * \param search workspace holding the resources of the edges.
+   * \param i current vertex.
+   * \param to target.
+   * \param length,resource length and resource of the path to \c i.
+   * \param budget resource budget.
+   * \param on_path whether each vertex is on the path to \c i.
+   * \return the length of the shortest path, infinity if none.
+   */
+  float brute_force ( Constrained_Search const & search , unsigned int i ,
+                      unsigned int to , float length , float resource ,
+                      float budget , vector < bool > & on_path ) {
+    if ( budget < resource ) {
+      return numeric_limits < float > :: infinity () ;
+    }
+    if ( i == to ) {
+      return length ;
+    }
+    float best = numeric_limits < float > :: infinity () ;
+    on_path [ i ] = true ;
+    Graph :: VEdge const & edges = search . graph . get_edges ( i ) ;
+    for ( size_t k = 0 ; k < edges . size () ; k ++ ) {
+      if ( ! on_path [ edges [ k ] . first ] ) {
+        best = min ( best , brute_force ( search , edges [ k ] . first , to ,
+                                           length + edges [ k ] . second ,
+                                           resource + search . get_resource ( i , k ) ,
+                                           budget , on_path ) ) ;
+      }
+    }
+    on_path [ i ] = false ;
+    return best ;
+  }
+
+  /*! Check the path found by the last query of \c search (its length and
+   * resource, the cheapest parallel edge being taken on each).
+   * \return true iff the path is as announced.
+   */
+  bool check_path ( Constrained_Search const & search , float length ,
+                    float budget ) {
+    vector < unsigned int > path ;
+    if ( ! search . get_path ( path ) ) {
+      return length == numeric_limits < float > :: infinity () ;
+    }
+    float path_length = 0 ;
+    float path_resource = 0 ;
+    for ( size_t k = 0 ; k + 1 < path . size () ; k ++ ) {
+      Graph :: VEdge const & edges = search . graph . get_edges ( path [ k ] ) ;
+      float best_length = 1e9 ;
+      float best_resource = 1e9 ;
+      for ( size_t e = 0 ; e < edges . size () ; e ++ ) {
+        if ( edges [ e ] . first == path [ k + 1 ] ) {
+          best_length = min ( best_length , edges [ e ] . second ) ;
+          best_resource = min ( best_resource , search . get_resource ( path [ k ] , e ) ) ;
+        }
+      }
+      path_length += best_length ;
+      path_resource += best_resource ;
+    }
+    return path_length <= length && path_resource <= search . get_resource_used ()
+      && search . get_resource_used () <= budget ;
+  }
+
+}
+
+
+int main () {
+
+  // Short road up a hill (energy 8) or long road around it (energy 2)
+  Graph g ( 5 ) ;
+  g . add_edge ( 0 , 1 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ;
+  g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 2 , 3 , 4.0 ) ;
+  g . add_edge ( 3 , 4 , 4.0 ) ;
+  Constrained_Search search ( g ) ;
+  search . set_resource ( 0 , 0 , 4.0 ) ;
+  search . set_resource ( 1 , 1 , 4.0 ) ;
+  search . set_resource ( 0 , 1 , 1.0 ) ;
+  search . set_resource ( 2 , 1 , 1.0 ) ;
+  vector < unsigned int > path ;
+  float const budgets [] = { 10.0 , 8.0 , 5.0 , 1.0 } ;
+  for ( unsigned int b = 0 ; b < 4 ; b ++ ) {
+    cout << "0 -> 4 within " << budgets [ b ] << ": "
+         << search . run ( 0 , 4 , budgets [ b ] )
+         << " using " << search . get_resource_used () << ":" ;
+    search . get_path ( path ) ;
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << " " << path [ k ] ;
+    }
+    cout << endl ;
+  }
+  cout << "0 -> 0: " << search . run ( 0 , 0 , 0.0 ) << endl ;
+
+  // Random graphs, undirected then directed: compared to the simple paths
+  srand ( 2016 ) ;
+  bool agree = true ;
+  bool unconstrained = true ;
+  unsigned int nbr_found = 0 ;
+  unsigned int nbr_labels = 0 ;
+  for ( unsigned int t = 0 ; t < 20 ; t ++ ) {
+    bool const is_directed = 10 <= t ;
+    Graph r ( 9 , is_directed ) ;
+    for ( unsigned int k = 0 ; k < ( is_directed ? 24u : 14u ) ; k ++ ) {
+      unsigned int const i = rand () % 9 ;
+      unsigned int const j = rand () % 9 ;
+      float const len = 1 + rand () % 9 ;
+      if ( is_directed ) {
+        r . add_arc ( i , j , len ) ;
+      } else {
+        r . add_edge ( i , j , len ) ;
+      }
+    }
+    Constrained_Search r_search ( r ) ;
+    for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+      for ( size_t k = 0 ; k < r . get_edges ( i ) . size () ; k ++ ) {
+        r_search . set_resource ( i , k , rand () % 10 ) ;
+      }
+    }
+    Dijkstra dijkstra ( r ) ;
+    for ( unsigned int from = 0 ; from < r . nbr_vertices ; from ++ ) {
+      for ( unsigned int to = 0 ; to < r . nbr_vertices ; to ++ ) {
+        float const budget = rand () % 20 ;
+        vector < bool > on_path ( r . nbr_vertices , false ) ;
+        float const expected = brute_force ( r_search , from , to , 0 , 0 ,
+                                             budget , on_path ) ;
+        float const length = r_search . run ( from , to , budget ) ;
+        agree = agree && length == expected && check_path ( r_search , length , budget ) ;
+        nbr_found += length < numeric_limits < float > :: infinity () ;
+        nbr_labels += r_search . get_nbr_labels () ;
+        unconstrained = unconstrained
+          && r_search . run ( from , to , 1e9 ) == dijkstra . shortest_distance ( from , to ) ;
+      }
+    }
+  }
+  cout << "random agree with simple paths: " << agree << endl ;
+  cout << "unconstrained agree with Dijkstra: " << unconstrained << endl ;
+  cout << "found: " << nbr_found << " labels: " << nbr_labels << endl ;
+
+  return 0 ;
+}
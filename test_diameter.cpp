@@ -0,0 +1,126 @@
+/*!
+ * \file
+ * \brief Test file: diameters found with few searches (iFUB), checked
+ * against Floyd–Warshall distances, and bounds within a budget.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "diameter.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Number of calls of count_calls. */
+  unsigned int nbr_calls = 0 ;
+
+  /*! Progress callback: counts its calls, checks the bounds. */
+  void count_calls ( float lower , float upper , unsigned int nbr_searches ,
+                     void * context ) {
+    nbr_calls ++ ;
+    float const diameter = * static_cast < float * > ( context ) ;
+    if ( ! ( lower <= diameter && diameter <= upper ) ) {
+      cout << "wrong bounds " << lower << " " << upper << endl ;
+    }
+  }
+
+  /*! \return the largest finite Floyd–Warshall distance of \c g. */
+  float largest_distance ( Graph const & g ) {
+    All_Pairs ap ( g ) ;
+    float largest = 0 ;
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      for ( unsigned int j = 0 ; j < g . nbr_vertices ; j ++ ) {
+        float const d = ap . get_distance ( i , j ) ;
+        if ( d < numeric_limits < float > :: infinity () && largest < d ) {
+          largest = d ;
+        }
+      }
+    }
+    return largest ;
+  }
+
+}
+
+
+int main () {
+
+  // graph of test_graph, plus an isolated vertex (10)
+  Graph g ( 11 ) ;
+  g . add_edge ( 0 , 1 , 2.0 ) ; g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ; g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ; g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ; g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ; g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ; g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ; g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ; g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ; g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+  Diameter diameter ( g ) ;
+  cout << "diameter: " << diameter . run_all ()
+       << " exact " << diameter . is_exact ()
+       << " between " << diameter . get_end ( 0 ) << " and " << diameter . get_end ( 1 )
+       << ", Floyd-Warshall " << largest_distance ( g ) << endl ;
+  cout << "component of 10: " << diameter . run ( 10 ) << endl ;
+
+  // random graphs (with several components)
+  srand ( 2016 ) ;
+  bool agree = true ;
+  for ( unsigned int round = 0 ; round < 10 ; round ++ ) {
+    Graph r ( 60 ) ;
+    for ( unsigned int k = 0 ; k < 70 + 10 * round ; k ++ ) {
+      r . add_edge ( rand () % 60 , rand () % 60 , float ( 1 + rand () % 20 ) ) ;
+    }
+    Diameter rd ( r ) ;
+    agree = agree && rd . run_all () == largest_distance ( r ) && rd . is_exact () ;
+  }
+  cout << "random graphs agree: " << agree << endl ;
+
+  // grid with random lengths: few searches
+  unsigned int const side = 20 ;
+  Graph grid ( side * side ) ;
+  for ( unsigned int i = 0 ; i < side * side ; i ++ ) {
+    if ( i % side != side - 1 ) {
+      grid . add_edge ( i , i + 1 , float ( 1 + rand () % 10 ) ) ;
+    }
+    if ( i + side < side * side ) {
+      grid . add_edge ( i , i + side , float ( 1 + rand () % 10 ) ) ;
+    }
+  }
+  float exact = largest_distance ( grid ) ;
+  Diameter gd ( grid ) ;
+  gd . set_progress ( count_calls , & exact ) ;
+  cout << "grid: " << ( gd . run ( 0 ) == exact ) << " exact " << gd . is_exact ()
+       << ", searches " << gd . get_nbr_searches () << " of " << grid . nbr_vertices
+       << ", progress calls " << ( nbr_calls + 2 == gd . get_nbr_searches () ) << endl ;
+
+  // within a budget
+  gd . set_max_searches ( 4 ) ;
+  gd . run ( 0 ) ;
+  cout << "budget of 4: searches " << gd . get_nbr_searches ()
+       << ", bounds hold " << ( gd . get_lower_bound () <= exact
+                                && exact <= gd . get_upper_bound () ) << endl ;
+
+  // grid with edges of length 2: breadth-first searches
+  Graph unit ( side * side ) ;
+  for ( unsigned int i = 0 ; i < side * side ; i ++ ) {
+    if ( i % side != side - 1 ) {
+      unit . add_edge ( i , i + 1 , 2.0 ) ;
+    }
+    if ( i + side < side * side ) {
+      unit . add_edge ( i , i + side , 2.0 ) ;
+    }
+  }
+  Diameter ud ( unit ) ;
+  cout << "grid of common length: " << ud . run ( 5 ) << " exact "
+       << ud . is_exact () << ", Floyd-Warshall " << largest_distance ( unit )
+       << ", between " << ud . get_end ( 0 ) << " and " << ud . get_end ( 1 )
+       << endl ;
+  return 0 ;
+}
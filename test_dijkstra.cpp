@@ -0,0 +1,146 @@
+/*!
+ * \file
+ * \brief Test file: reads a graph and runs several queries with the same
+ * Dijkstra workspace.
+ */
+
+# include <iostream>
+# include <sstream>
+
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "dijkstra.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Graph of test_graph, plus an isolated vertex (10). */
+  char const * const graph_text =
+    "11\n"
+    "0 1 2.0\n" "0 2 4.0\n" "0 3 7.0\n" "1 2 3.0\n" "1 4 3.0\n"
+    "2 3 2.0\n" "2 4 9.0\n" "2 5 7.0\n" "2 6 9.0\n" "3 6 4.0\n"
+    "4 5 4.0\n" "4 7 9.0\n" "5 6 6.0\n" "5 7 5.0\n" "5 8 1.0\n"
+    "5 9 6.0\n" "6 8 9.0\n" "7 9 3.0\n" "8 9 4.0\n" ;
+
+  /*! Print the path found by the last query of \c search.
+   * \param search workspace.
+   * \param to last vertex of the path.
+   */
+  void print_path ( Dijkstra const & search , unsigned int to ) {
+    vector < unsigned int > path ;
+    if ( ! search . get_path ( to , path ) ) {
+      cout << "no path to " << to << endl ;
+      return ;
+    }
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << path [ k ] << " " ;
+    }
+    cout << endl ;
+  }
+
+}
+
+
+int main () {
+
+  istringstream in ( graph_text ) ;
+  Graph * g = Graph :: read ( in ) ;
+  assert ( g != NULL ) ;
+
+  istringstream bad ( "3\n0 1 1.0\n0 5 1.0\n" ) ;
+  cout << "bad graph rejected: " << ( Graph :: read ( bad ) == NULL ) << endl ;
+
+  Dijkstra search ( * g ) ;
+
+  // point-to-point
+  cout << "0 -> 9: " << search . shortest_distance ( 0 , 9 ) << endl ;
+  print_path ( search , 9 ) ;
+  cout << "0 -> 4: " << search . shortest_distance ( 0 , 4 ) << endl ;
+  print_path ( search , 4 ) ;
+  cout << "9 -> 3: " << search . shortest_distance ( 9 , 3 ) << endl ;
+  print_path ( search , 3 ) ;
+  cout << "0 -> 10: " << search . shortest_distance ( 0 , 10 ) << endl ;
+  print_path ( search , 10 ) ;
+  cout << "treated: " << search . get_nbr_treated () << endl ;
+  cout << "components: " << g -> get_nbr_components () << endl ;
+
+  // one-to-all
+  search . one_to_all ( 3 ) ;
+  for ( unsigned int i = 0 ; i < g -> nbr_vertices ; i ++ ) {
+    cout << search . get_distance ( i ) << " " ;
+  }
+  cout << endl ;
+  cout << "treated: " << search . get_nbr_treated () << endl ;
+
+  // isochrone
+  vector < unsigned int > reached ;
+  search . isochrone ( 0 , 5.0 , reached ) ;
+  for ( size_t k = 0 ; k < reached . size () ; k ++ ) {
+    cout << reached [ k ] << ":" << search . get_distance ( reached [ k ] ) << " " ;
+  }
+  cout << endl ;
+
+  // resumable queries, interleaved on two workspaces
+  Dijkstra other ( * g ) ;
+  search . start_point_to_point ( 0 , 9 ) ;
+  other . start_isochrone ( 9 , 4.0 ) ;
+  unsigned int slices = 0 ;
+  while ( ! search . is_finished () || ! other . is_finished () ) {
+    search . resume ( 2 ) ;
+    other . resume ( 2 ) ;
+    slices ++ ;
+  }
+  cout << "slices: " << slices << endl ;
+  cout << "0 -> 9: " << search . get_distance ( 9 ) << endl ;
+  print_path ( search , 9 ) ;
+  for ( size_t k = 0 ; k < other . get_treated () . size () ; k ++ ) {
+    unsigned int const i = other . get_treated () [ k ] ;
+    cout << i << ":" << other . get_distance ( i ) << " " ;
+  }
+  cout << endl ;
+
+  // budgets
+  Dijkstra :: Budget budget ;
+  budget . max_treated = 3 ;
+  search . set_budget ( budget ) ;
+  cout << "0 -> 9 in 3 vertices: " << search . shortest_distance ( 0 , 9 )
+       << " status " << search . get_status ()
+       << " lower bound " << search . get_lower_bound () << endl ;
+  print_path ( search , 2 ) ;
+  budget . max_treated = 0 ;
+  budget . max_scanned = 8 ;
+  search . set_budget ( budget ) ;
+  cout << "0 -> 9 in 8 edges: " << search . shortest_distance ( 0 , 9 )
+       << " status " << search . get_status ()
+       << " scanned " << search . get_nbr_scanned () << endl ;
+  search . set_budget ( Dijkstra :: Budget () ) ;
+  cout << "0 -> 9: " << search . shortest_distance ( 0 , 9 )
+       << " status " << search . get_status () << endl ;
+
+  // hubs (relaxed in batches): compared to Floyd–Warshall
+  srand ( 2016 ) ;
+  Graph h ( 200 ) ;
+  for ( unsigned int i = 0 ; i < 200 ; i ++ ) {
+    h . add_edge ( i , ( i + 1 ) % 200 , 1 + rand () % 100 ) ;
+  }
+  for ( unsigned int k = 0 ; k < 300 ; k ++ ) {
+    h . add_edge ( rand () % 5 , rand () % 200 , 1 + rand () % 100 ) ;
+  }
+  Dijkstra h_search ( h ) ;
+  All_Pairs ap ( h ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < h . nbr_vertices ; i ++ ) {
+    h_search . one_to_all ( i ) ;
+    for ( unsigned int j = 0 ; j < h . nbr_vertices ; j ++ ) {
+      agree = agree && h_search . get_distance ( j ) == ap . get_distance ( i , j ) ;
+    }
+  }
+  cout << "hubs agree with Floyd-Warshall: " << agree << endl ;
+
+  delete g ;
+  return 0 ;
+}
@@ -1,9 +1,80 @@
 /*! 
  * \file
- * \brief Test file: constructs a graph and call print_dijkstra on it.
+ * \brief Test file: constructs a graph and call print_dijkstra on it, then
+ * removes edges and compacts a graph, checked against a graph built without
+ * them.
  */
 
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "bfs.hpp"
+# include "dijkstra.hpp"
 # include "graph.hpp"
+# include "mst.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! An edge added to the random graph. */
+  struct Added {
+    unsigned int i ;
+    unsigned int j ;
+    float len ;
+    bool is_removed ;
+  } ;
+
+  /*! \return true iff searches on \c g and \c ref find the same distances,
+   * hops and spanning forests. */
+  bool agree ( Graph const & g , Graph const & ref ) {
+    Dijkstra search ( g ) ;
+    Dijkstra ref_search ( ref ) ;
+    Bfs bfs ( g ) ;
+    Bfs ref_bfs ( ref ) ;
+    bool same = true ;
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      search . one_to_all ( i ) ;
+      ref_search . one_to_all ( i ) ;
+      bfs . run ( i , g . nbr_vertices ) ;
+      ref_bfs . run ( i , ref . nbr_vertices ) ;
+      for ( unsigned int j = 0 ; j < g . nbr_vertices ; j ++ ) {
+        same = same && search . get_distance ( j ) == ref_search . get_distance ( j )
+          && bfs . get_hops ( j ) == ref_bfs . get_hops ( j ) ;
+      }
+      same = same && search . get_nbr_treated () == ref_search . get_nbr_treated () ;
+    }
+    Spanning_Tree tree , ref_tree ;
+    prim ( g , tree ) ;
+    prim ( ref , ref_tree ) ;
+    same = same && tree . total_length == ref_tree . total_length ;
+    boruvka ( g , tree ) ;
+    same = same && tree . total_length == ref_tree . total_length ;
+    return same ;
+  }
+
+  /*! \return true iff the edge back of every edge of \c g leads back to
+   * it, with the same length. */
+  bool backs_agree ( Graph const & g ) {
+    bool same = true ;
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      Graph :: VEdge const & edges = g . get_edges ( i ) ;
+      for ( size_t k = 0 ; k < edges . size () ; k ++ ) {
+        unsigned int const j = edges [ k ] . first ;
+        size_t const l = g . get_back ( i , k ) ;
+        same = same && l < g . get_edges ( j ) . size ()
+          && g . get_edges ( j ) [ l ] . first == i
+          && g . get_edges ( j ) [ l ] . second == edges [ k ] . second
+          && g . get_back ( j , l ) == k && ( j != i || l != k ) ;
+      }
+    }
+    return same ;
+  }
+
+}
 
 
 int main () {
@@ -33,5 +104,79 @@ int main () {
   g . add_edge ( 8 , 9 , 4.0 ) ;
 
   g . print_dijkstra ( 0 , 9 ) ;
+
+  // remove 5-8 (and 8-5): the path goes round
+  for ( size_t k = 0 ; k < g . get_edges ( 5 ) . size () ; k ++ ) {
+    if ( g . get_edges ( 5 ) [ k ] . first == 8 ) {
+      g . remove_edge ( 5 , k ) ;
+    }
+  }
+  cout << "removed: " << g . get_nbr_removed () << " of "
+       << g . get_nbr_arcs () << " arcs" << endl ;
+  g . print_dijkstra ( 0 , 9 ) ;
+  g . compact () ;
+  cout << "compacted: " << g . get_nbr_removed () << " of "
+       << g . get_nbr_arcs () << " arcs, degree of 5: "
+       << g . get_edges ( 5 ) . size () << endl ;
+  g . print_dijkstra ( 0 , 9 ) ;
+
+  // random graph, edges removed at random
+  srand ( 2016 ) ;
+  unsigned int const n = 60 ;
+  Graph r ( n ) ;
+  vector < Added > added ;
+  for ( unsigned int k = 0 ; k < 150 ; k ++ ) {
+    Added a = { rand () % n , rand () % n , float ( 1 + rand () % 20 ) , false } ;
+    r . add_edge ( a . i , a . j , a . len ) ;
+    added . push_back ( a ) ;
+  }
+  bool compaction_needed = false ;
+  for ( unsigned int k = 0 ; k < 50 ; k ++ ) {
+    Added & a = added [ rand () % added . size () ] ;
+    if ( a . is_removed ) {
+      continue ;
+    }
+    a . is_removed = true ;
+    Graph :: VEdge const & edges = r . get_edges ( a . i ) ;
+    for ( size_t e = 0 ; e < edges . size () ; e ++ ) {
+      if ( edges [ e ] . first == a . j && edges [ e ] . second == a . len ) {
+        r . remove_edge ( a . i , e ) ;
+        break ;
+      }
+    }
+    compaction_needed = compaction_needed || r . needs_compaction () ;
+  }
+  Graph ref ( n ) ;
+  for ( size_t k = 0 ; k < added . size () ; k ++ ) {
+    if ( ! added [ k ] . is_removed ) {
+      ref . add_edge ( added [ k ] . i , added [ k ] . j , added [ k ] . len ) ;
+    }
+  }
+  cout << "live arcs: "
+       << ( r . get_nbr_arcs () - r . get_nbr_removed () == ref . get_nbr_arcs () )
+       << ", compaction needed: " << compaction_needed << endl ;
+  cout << "with tombstones, agree: " << agree ( r , ref )
+       << ", edges back agree: " << backs_agree ( r ) << endl ;
+  r . compact () ;
+  cout << "compacted, agree: " << agree ( r , ref )
+       << ", same arcs: " << ( r . get_nbr_arcs () == ref . get_nbr_arcs () )
+       << ", same components: "
+       << ( r . get_nbr_components () == ref . get_nbr_components () )
+       << ", edges back agree: " << backs_agree ( r ) << endl ;
+
+  // parallel edges of the same length, and a loop: each edge has its own
+  // edge back
+  Graph p ( 3 ) ;
+  p . add_edge ( 0 , 1 , 2.0 ) ;
+  p . add_edge ( 1 , 1 , 2.0 ) ;
+  p . add_edge ( 0 , 1 , 2.0 ) ;
+  p . add_edge ( 1 , 2 , 2.0 ) ;
+  cout << "parallel edges back: " << p . get_back ( 0 , 0 ) << " "
+       << p . get_back ( 0 , 1 ) << ", loop back: " << p . get_back ( 1 , 1 )
+       << " " << p . get_back ( 1 , 2 ) << endl ;
+  p . remove_edge ( 0 , 0 ) ;
+  p . compact () ;
+  cout << "compacted, second edge back: " << p . get_back ( 0 , 0 )
+       << ", agree: " << backs_agree ( p ) << endl ;
   return 0 ;
 }
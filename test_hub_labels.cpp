@@ -0,0 +1,123 @@
+/*!
+ * \file
+ * \brief Test file: hub labels, checked against Dijkstra's algorithm, and
+ * saved to then mapped from a file.
+ */
+
+# include <fstream>
+# include <iostream>
+
+# include <stdint.h>
+# include <stdlib.h>
+# include <unistd.h>
+
+# include "dijkstra.hpp"
+# include "hub_labels.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  // graph of test_graph, plus an isolated vertex (10)
+  Graph g ( 11 ) ;
+
+  g . add_edge ( 0 , 1 , 2.0 ) ;
+  g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ;
+  g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ;
+  g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ;
+  g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ;
+  g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ;
+  g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ;
+  g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ;
+  g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ;
+  g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+
+  Hub_Labels hl ( g ) ;
+  cout << "entries: " << hl . get_nbr_entries () << endl ;
+  cout << "0 -> 9: " << hl . get_distance ( 0 , 9 ) << endl ;
+  cout << "9 -> 3: " << hl . get_distance ( 9 , 3 ) << endl ;
+  cout << "4 -> 4: " << hl . get_distance ( 4 , 4 ) << endl ;
+  cout << "0 -> 10: " << hl . get_distance ( 0 , 10 ) << endl ;
+
+  // random graph: compared to Dijkstra's algorithm
+  srand ( 2016 ) ;
+  Graph r ( 300 ) ;
+  for ( unsigned int k = 0 ; k < 900 ; k ++ ) {
+    r . add_edge ( rand () % 300 , rand () % 300 , 1 + rand () % 100 ) ;
+  }
+  Hub_Labels r_hl ( r ) ;
+  Dijkstra search ( r ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    search . one_to_all ( i ) ;
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+      agree = agree && search . get_distance ( j ) == r_hl . get_distance ( i , j ) ;
+    }
+  }
+  cout << "agree with Dijkstra: " << agree << endl ;
+
+  // saved then mapped
+  char const * const path = "test_hub_labels.bin" ;
+  cout << "saved: " << r_hl . save ( path ) << endl ;
+  Hub_Labels * mapped = Hub_Labels :: map ( path ) ;
+  cout << "mapped: " << ( mapped != NULL ) << endl ;
+  bool same = mapped -> nbr_vertices == r_hl . nbr_vertices
+    && mapped -> get_nbr_entries () == r_hl . get_nbr_entries () ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+      same = same && mapped -> get_distance ( i , j ) == r_hl . get_distance ( i , j ) ;
+    }
+  }
+  cout << "same after mapping: " << same << endl ;
+  delete mapped ;
+
+  // corrupt offset of vertex 1: the file is rejected
+  {
+    unsigned int const nbr_offsets = r . nbr_vertices + 1 ;
+    unsigned int const nbr_hubs = r_hl . get_nbr_entries () + r . nbr_vertices ;
+    fstream file ( path , ios :: in | ios :: out | ios :: binary ) ;
+    file . seekp ( 0 , ios :: end ) ;
+    streamoff const size = file . tellp () ;
+    uint32_t const bad = 0xfffffff0 ;
+    file . seekp ( size - nbr_hubs * 8 - nbr_offsets * 4 + 4 ) ;
+    file . write ( reinterpret_cast < char const * > ( & bad ) , sizeof ( bad ) ) ;
+  }
+  cout << "corrupt offsets: " << ( Hub_Labels :: map ( path ) == NULL ) << endl ;
+
+  // 2^32 - 1 vertices: the number of offsets wraps around in 32 bits, where
+  // the size of this file would look right
+  {
+    uint32_t const counts [ 2 ] = { 0xffffffff , 1 } ;
+    uint32_t const entry [ 2 ] = { 0 , 0 } ;
+    ofstream file ( path , ios :: binary | ios :: trunc ) ;
+    file . write ( "HUBL" , 4 ) ;
+    file . write ( reinterpret_cast < char const * > ( counts ) , sizeof ( counts ) ) ;
+    file . write ( reinterpret_cast < char const * > ( entry ) , sizeof ( entry ) ) ;
+  }
+  cout << "huge header: " << ( Hub_Labels :: map ( path ) == NULL ) << endl ;
+  unlink ( path ) ;
+
+  // empty graph
+  Graph empty ( 0 ) ;
+  Hub_Labels empty_hl ( empty ) ;
+  cout << "empty: " << empty_hl . get_nbr_entries () << " entries, saved "
+       << empty_hl . save ( path ) ;
+  mapped = Hub_Labels :: map ( path ) ;
+  cout << ", mapped " << ( mapped != NULL ) << endl ;
+  delete mapped ;
+  unlink ( path ) ;
+  cout << "missing file: " << ( Hub_Labels :: map ( path ) == NULL ) << endl ;
+
+  return 0 ;
+}
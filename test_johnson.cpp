@@ -0,0 +1,99 @@
+/*!
+ * \file
+ * \brief Test file: shortest paths on directed graphs with negative lengths,
+ * checked against Floyd–Warshall.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "apsp.hpp"
+# include "johnson.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  // small directed graph with negative arcs
+  Graph g ( 6 , true ) ;
+  g . add_arc ( 0 , 1 , 4.0 ) ;
+  g . add_arc ( 0 , 2 , 2.0 ) ;
+  g . add_arc ( 1 , 3 , -3.0 ) ;
+  g . add_arc ( 2 , 1 , 1.0 ) ;
+  g . add_arc ( 2 , 4 , 6.0 ) ;
+  g . add_arc ( 3 , 4 , 1.0 ) ;
+  g . add_arc ( 4 , 5 , -2.0 ) ;
+  g . add_edge ( 3 , 5 , 5.0 ) ;
+
+  Johnson j ( g ) ;
+  cout << "negative cycle: " << j . has_negative_cycle () << endl ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    cout << j . get_potential ( i ) << " " ;
+  }
+  cout << endl ;
+  cout << "0 -> 5: " << j . shortest_distance ( 0 , 5 ) << endl ;
+  vector < unsigned int > path ;
+  j . get_path ( 5 , path ) ;
+  for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+    cout << path [ k ] << " " ;
+  }
+  cout << endl ;
+  cout << "5 -> 0: " << j . shortest_distance ( 5 , 0 ) << endl ;
+  j . one_to_all ( 2 ) ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    cout << j . get_distance ( i ) << " " ;
+  }
+  cout << endl ;
+
+  // negative cycle
+  Graph c ( 4 , true ) ;
+  c . add_arc ( 0 , 1 , 1.0 ) ;
+  c . add_arc ( 1 , 2 , -2.0 ) ;
+  c . add_arc ( 2 , 1 , 1.0 ) ;
+  c . add_arc ( 2 , 3 , 1.0 ) ;
+  Johnson jc ( c ) ;
+  cout << "negative cycle: " << jc . has_negative_cycle () << endl ;
+  Johnson jc_parallel ( c , 3 ) ;
+  cout << "negative cycle: " << jc_parallel . has_negative_cycle () << endl ;
+
+  // random directed graph: compared to Floyd–Warshall
+  srand ( 2016 ) ;
+  Graph r ( 100 , true ) ;
+  for ( unsigned int i = 0 ; i < 100 ; i ++ ) {
+    r . add_arc ( i , ( i + 1 ) % 100 , 10 ) ;
+  }
+  for ( unsigned int k = 0 ; k < 400 ; k ++ ) {
+    unsigned int const i = rand () % 100 ;
+    unsigned int const l = rand () % 100 ;
+    // no negative cycle: going down from i to l costs more than l - i
+    r . add_arc ( i , l , ( l < i ) ? - int ( i - l ) + 1 + rand () % 5 : int ( l - i ) + rand () % 20 ) ;
+  }
+  Johnson jr ( r ) ;
+  All_Pairs ap ( r ) ;
+  bool agree = ! jr . has_negative_cycle () ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    jr . one_to_all ( i ) ;
+    for ( unsigned int l = 0 ; l < r . nbr_vertices ; l ++ ) {
+      float const d = jr . get_distance ( l ) - ap . get_distance ( i , l ) ;
+      agree = agree && - 1e-3 < d && d < 1e-3 ;
+    }
+  }
+  cout << "agree with Floyd-Warshall: " << agree << endl ;
+
+  // rounds split across workers: the same distances
+  Johnson jr_parallel ( r , 3 ) ;
+  bool same = ! jr_parallel . has_negative_cycle () ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i += 10 ) {
+    jr_parallel . one_to_all ( i ) ;
+    for ( unsigned int l = 0 ; l < r . nbr_vertices ; l ++ ) {
+      float const d = jr_parallel . get_distance ( l ) - ap . get_distance ( i , l ) ;
+      same = same && - 1e-3 < d && d < 1e-3 ;
+    }
+  }
+  cout << "parallel rounds agree: " << same << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,120 @@
+/*!
+ * \file
+ * \brief Test file: nearest vertices found with a k-d tree, checked against
+ * a linear scan, saved to then mapped from a file.
+ */
+
+# include <algorithm>
+# include <fstream>
+# include <iostream>
+# include <iterator>
+# include <string>
+
+# include <limits.h>
+# include <stdlib.h>
+# include <unistd.h>
+
+# include "kd_tree.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! k nearest vertices by a linear scan (by distance, then number). */
+  void scan ( Graph const & g , float x , float y , unsigned int k ,
+              vector < unsigned int > & nearest ) {
+    vector < Kd_Tree :: Candidate > all ;
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      float const dx = x - g . get_x ( i ) ;
+      float const dy = y - g . get_y ( i ) ;
+      all . push_back ( Kd_Tree :: Candidate ( dx * dx + dy * dy , i ) ) ;
+    }
+    sort ( all . begin () , all . end () ) ;
+    nearest . clear () ;
+    for ( unsigned int c = 0 ; c < k && c < all . size () ; c ++ ) {
+      nearest . push_back ( all [ c ] . second ) ;
+    }
+  }
+
+  /*! \return true iff \c tree finds the same vertices as a scan of \c g. */
+  bool agree ( Kd_Tree const & tree , Graph const & g ) {
+    bool same = true ;
+    vector < unsigned int > found , expected ;
+    for ( unsigned int q = 0 ; q < 300 ; q ++ ) {
+      float const x = ( rand () % 1200 ) / 10.0f - 10 ;
+      float const y = ( rand () % 1200 ) / 10.0f - 10 ;
+      scan ( g , x , y , 1 , expected ) ;
+      same = same && tree . nearest ( x , y ) == expected [ 0 ] ;
+      scan ( g , x , y , 7 , expected ) ;
+      tree . k_nearest ( x , y , 7 , found ) ;
+      same = same && found == expected ;
+    }
+    return same ;
+  }
+
+}
+
+
+int main () {
+
+  // 3 x 3 grid, unit spacing
+  Graph g ( 9 ) ;
+  for ( unsigned int i = 0 ; i < 9 ; i ++ ) {
+    g . set_coordinates ( i , float ( i % 3 ) , float ( i / 3 ) ) ;
+  }
+  Kd_Tree tree ( g ) ;
+  cout << "nearest to (0.2, 0.1): " << tree . nearest ( 0.2 , 0.1 ) << endl ;
+  cout << "nearest to (1.6, 1.9): " << tree . nearest ( 1.6 , 1.9 ) << endl ;
+  cout << "nearest to (1.5, 1.5): " << tree . nearest ( 1.5 , 1.5 ) << endl ;
+  vector < unsigned int > nearest ;
+  tree . k_nearest ( 1 , 1 , 5 , nearest ) ;
+  cout << "5 nearest to (1, 1):" ;
+  for ( size_t k = 0 ; k < nearest . size () ; k ++ ) {
+    cout << " " << nearest [ k ] ;
+  }
+  cout << endl ;
+  tree . k_nearest ( 1 , 1 , 20 , nearest ) ;
+  cout << "20 nearest: " << nearest . size () << " vertices" << endl ;
+  tree . k_nearest ( 1 , 1 , UINT_MAX , nearest ) ;
+  cout << "UINT_MAX nearest: " << nearest . size () << " vertices" << endl ;
+
+  // random points (many on a coarse grid, for ties)
+  srand ( 2016 ) ;
+  Graph r ( 3000 ) ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    if ( i % 2 == 0 ) {
+      r . set_coordinates ( i , float ( rand () % 50 ) * 2 , float ( rand () % 50 ) * 2 ) ;
+    } else {
+      r . set_coordinates ( i , ( rand () % 10000 ) / 100.0f , ( rand () % 10000 ) / 100.0f ) ;
+    }
+  }
+  Kd_Tree r_tree ( r ) ;
+  cout << "agree with a scan: " << agree ( r_tree , r ) << endl ;
+
+  // saved then mapped
+  char const * const path = "test_kd_tree.bin" ;
+  cout << "saved: " << r_tree . save ( path ) << endl ;
+  Kd_Tree * mapped = Kd_Tree :: map ( path ) ;
+  cout << "mapped: " << ( mapped != NULL ) << endl ;
+  cout << "same after mapping: "
+       << ( mapped -> nbr_points == r_tree . nbr_points && agree ( * mapped , r ) )
+       << endl ;
+  delete mapped ;
+
+  // subtrees sorted by several workers: the same tree
+  Kd_Tree r_parallel ( r , 3 ) ;
+  char const * const parallel_path = "test_kd_tree_parallel.bin" ;
+  r_parallel . save ( parallel_path ) ;
+  ifstream file ( path , ios :: binary ) ;
+  ifstream parallel_file ( parallel_path , ios :: binary ) ;
+  string const bytes ( ( istreambuf_iterator < char > ( file ) ) , istreambuf_iterator < char > () ) ;
+  string const parallel_bytes ( ( istreambuf_iterator < char > ( parallel_file ) ) , istreambuf_iterator < char > () ) ;
+  cout << "parallel build agrees: "
+       << ( agree ( r_parallel , r ) && bytes == parallel_bytes ) << endl ;
+  unlink ( parallel_path ) ;
+  unlink ( path ) ;
+  cout << "missing file: " << ( Kd_Tree :: map ( path ) == NULL ) << endl ;
+  return 0 ;
+}
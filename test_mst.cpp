@@ -0,0 +1,89 @@
+/*!
+ * \file
+ * \brief Test file: computes the minimum spanning forest of a graph with
+ * Prim's and Borůvka's algorithms, Borůvka's on several threads too.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "mst.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Print the edges and total length of a forest.
+   * \param tree forest to print.
+   */
+  void print_tree ( Spanning_Tree const & tree ) {
+    for ( size_t k = 0 ; k < tree . edges . size () ; k ++ ) {
+      cout << tree . edges [ k ] . i << "-" << tree . edges [ k ] . j
+           << ":" << tree . edges [ k ] . len << " " ;
+    }
+    cout << endl << "total " << tree . total_length << endl ;
+  }
+
+}
+
+
+int main () {
+
+  // graph of test_graph, plus two vertices linked together (10 and 11)
+  Graph g ( 12 ) ;
+
+  g . add_edge ( 0 , 1 , 2.0 ) ;
+  g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ;
+  g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ;
+  g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ;
+  g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ;
+  g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ;
+  g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ;
+  g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ;
+  g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ;
+  g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+  g . add_edge ( 10 , 11 , 1.5 ) ;
+
+  Spanning_Tree tree ;
+
+  cout << "Prim" << endl ;
+  prim ( g , tree ) ;
+  print_tree ( tree ) ;
+
+  cout << "Boruvka" << endl ;
+  boruvka ( g , tree ) ;
+  print_tree ( tree ) ;
+
+  // random graphs with many ties: same total length on any number of
+  // threads, and one edge less than vertices per component
+  srand ( 2016 ) ;
+  bool agree = true ;
+  for ( unsigned int t = 0 ; t < 10 ; t ++ ) {
+    Graph r ( 300 ) ;
+    for ( unsigned int k = 0 ; k < 450 ; k ++ ) {
+      r . add_edge ( rand () % 300 , rand () % 300 , 1 + rand () % 5 ) ;
+    }
+    Spanning_Tree prim_tree ;
+    prim ( r , prim_tree ) ;
+    for ( unsigned int nbr_workers = 1 ; nbr_workers <= 4 ; nbr_workers ++ ) {
+      boruvka ( r , tree , nbr_workers ) ;
+      agree = agree && tree . total_length == prim_tree . total_length
+        && tree . edges . size () == r . nbr_vertices - r . get_nbr_components () ;
+    }
+  }
+  cout << "parallel Boruvka agrees with Prim: " << agree << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,84 @@
+/*!
+ * \file
+ * \brief Test file: searches from several sources at once, checked against
+ * Dijkstra's algorithm and the breadth-first search.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "bfs.hpp"
+# include "multi_source.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  // random graph with an isolated vertex (0)
+  srand ( 2016 ) ;
+  Graph r ( 200 ) ;
+  for ( unsigned int k = 0 ; k < 500 ; k ++ ) {
+    r . add_edge ( 1 + rand () % 199 , 1 + rand () % 199 , 1 + rand () % 100 ) ;
+  }
+
+  vector < unsigned int > sources ;
+  sources . push_back ( 5 ) ;
+  sources . push_back ( 17 ) ;
+  sources . push_back ( 5 ) ;
+  sources . push_back ( 0 ) ;
+  sources . push_back ( 120 ) ;
+
+  Lane_Dijkstra lanes ( r ) ;
+  lanes . run ( sources ) ;
+  cout << "5 -> 17: " << lanes . get_distance ( 0 , 17 ) << endl ;
+  cout << "0 -> 5: " << lanes . get_distance ( 3 , 5 ) << endl ;
+  cout << "0 -> 0: " << lanes . get_distance ( 3 , 0 ) << endl ;
+  cout << "unused lane: " << lanes . get_distance ( 7 , 5 ) << endl ;
+
+  // all the sources, by batches of lanes
+  Dijkstra search ( r ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i += Lane_Dijkstra :: nbr_lanes ) {
+    sources . clear () ;
+    for ( unsigned int k = i ; k < i + Lane_Dijkstra :: nbr_lanes ; k ++ ) {
+      sources . push_back ( k ) ;
+    }
+    lanes . run ( sources ) ;
+    for ( size_t lane = 0 ; lane < sources . size () ; lane ++ ) {
+      search . one_to_all ( sources [ lane ] ) ;
+      for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+        agree = agree && search . get_distance ( j ) == lanes . get_distance ( lane , j ) ;
+      }
+    }
+  }
+  cout << "lanes agree with Dijkstra: " << agree << endl ;
+
+  Bit_Parallel_Bfs bits ( r ) ;
+  Bfs bfs ( r ) ;
+  agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i += Bit_Parallel_Bfs :: nbr_lanes ) {
+    sources . clear () ;
+    for ( unsigned int k = i ; k < i + Bit_Parallel_Bfs :: nbr_lanes && k < r . nbr_vertices ; k ++ ) {
+      sources . push_back ( k ) ;
+    }
+    bits . run ( sources ) ;
+    for ( size_t lane = 0 ; lane < sources . size () ; lane ++ ) {
+      bfs . run ( sources [ lane ] , r . nbr_vertices ) ;
+      for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+        agree = agree && bfs . get_hops ( j ) == bits . get_hops ( lane , j ) ;
+      }
+    }
+  }
+  cout << "bits agree with BFS: " << agree << endl ;
+  sources . clear () ;
+  sources . push_back ( 0 ) ;
+  sources . push_back ( 5 ) ;
+  bits . run ( sources ) ;
+  cout << "0 -> 1 unreached: " << ( bits . get_hops ( 0 , 1 ) == Bit_Parallel_Bfs :: unreached ) << endl ;
+  cout << "5 -> 17 hops: " << bits . get_hops ( 1 , 17 ) << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,163 @@
+/*!
+ * \file
+ * \brief Test file: Pareto-optimal paths on time and toll, compared to the
+ * Pareto front of all the simple paths.
+ */
+
+# include <algorithm>
+# include <iostream>
+# include <utility>
+# include <vector>
+
+# include <stdlib.h>
+
+# include "dijkstra.hpp"
+# include "pareto.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Costs of a path: time (length) then toll. */
+  typedef pair < float , float > Pair ;
+
+  /*! Collect the costs of the simple paths from \c i to \c to.
+   * \param search workspace holding the costs of the edges.
+   * \param i current vertex.
+   * \param to target.
+   * \param costs costs of the path to \c i.
+   * \param on_path whether each vertex is on the path to \c i.
+   * \param all filled with the costs of the paths.
+   */
+  void enumerate ( Pareto_Search const & search , unsigned int i ,
+                   unsigned int to , Pair costs , vector < bool > & on_path ,
+                   vector < Pair > & all ) {
+    if ( i == to ) {
+      all . push_back ( costs ) ;
+      return ;
+    }
+    on_path [ i ] = true ;
+    Graph :: VEdge const & edges = search . graph . get_edges ( i ) ;
+    for ( size_t k = 0 ; k < edges . size () ; k ++ ) {
+      if ( ! on_path [ edges [ k ] . first ] ) {
+        Pareto_Search :: Costs const & c = search . get_costs ( i , k ) ;
+        enumerate ( search , edges [ k ] . first , to ,
+                    Pair ( costs . first + c . values [ 0 ] ,
+                           costs . second + c . values [ 1 ] ) ,
+                    on_path , all ) ;
+      }
+    }
+    on_path [ i ] = false ;
+  }
+
+  /*! \return the Pareto front of \c all, by increasing time. */
+  vector < Pair > front ( vector < Pair > all ) {
+    sort ( all . begin () , all . end () ) ;
+    vector < Pair > result ;
+    for ( size_t k = 0 ; k < all . size () ; k ++ ) {
+      if ( result . empty () || all [ k ] . second < result . back () . second ) {
+        result . push_back ( all [ k ] ) ;
+      }
+    }
+    return result ;
+  }
+
+}
+
+
+int main () {
+
+  // Highway (fast, toll) or country road (slow, free) or in between
+  Graph g ( 5 ) ;
+  g . add_edge ( 0 , 1 , 10.0 ) ;
+  g . add_edge ( 1 , 4 , 10.0 ) ;
+  g . add_edge ( 0 , 2 , 20.0 ) ;
+  g . add_edge ( 2 , 4 , 25.0 ) ;
+  g . add_edge ( 1 , 3 , 12.0 ) ;
+  g . add_edge ( 3 , 4 , 12.0 ) ;
+  Pareto_Search search ( g ) ;
+  search . set_cost ( 0 , 0 , 1 , 5.0 ) ;
+  search . set_cost ( 1 , 1 , 1 , 5.0 ) ;
+  search . set_cost ( 1 , 2 , 1 , 1.0 ) ;
+  cout << "0 -> 4: " << search . run ( 0 , 4 ) << " paths, "
+       << search . get_nbr_labels () << " labels" << endl ;
+  vector < unsigned int > path ;
+  for ( unsigned int s = 0 ; s < search . get_nbr_solutions () ; s ++ ) {
+    Pareto_Search :: Costs const & c = search . get_solution ( s ) ;
+    cout << c . values [ 0 ] << " " << c . values [ 1 ] << ":" ;
+    search . get_path ( s , path ) ;
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << " " << path [ k ] ;
+    }
+    cout << endl ;
+  }
+  cout << "0 -> 0: " << search . run ( 0 , 0 ) << " paths" << endl ;
+  Graph apart ( 2 ) ;
+  Pareto_Search apart_search ( apart ) ;
+  cout << "apart: " << apart_search . run ( 0 , 1 ) << " paths" << endl ;
+
+  // Random graphs: compared to the front of the simple paths
+  srand ( 2016 ) ;
+  bool agree = true ;
+  bool fastest = true ;
+  unsigned int nbr_solutions = 0 ;
+  for ( unsigned int t = 0 ; t < 20 ; t ++ ) {
+    Graph r ( 9 ) ;
+    for ( unsigned int k = 0 ; k < 16 ; k ++ ) {
+      r . add_edge ( rand () % 9 , rand () % 9 , 1 + rand () % 9 ) ;
+    }
+    Pareto_Search r_search ( r ) ;
+    for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+      for ( size_t k = 0 ; k < r . get_edges ( i ) . size () ; k ++ ) {
+        r_search . set_cost ( i , k , 1 , rand () % 10 ) ;
+      }
+    }
+    Dijkstra dijkstra ( r ) ;
+    for ( unsigned int from = 0 ; from < r . nbr_vertices ; from ++ ) {
+      for ( unsigned int to = 0 ; to < r . nbr_vertices ; to ++ ) {
+        vector < Pair > all ;
+        vector < bool > on_path ( r . nbr_vertices , false ) ;
+        enumerate ( r_search , from , to , Pair ( 0 , 0 ) , on_path , all ) ;
+        vector < Pair > const expected = front ( all ) ;
+        unsigned int const n = r_search . run ( from , to ) ;
+        nbr_solutions += n ;
+        agree = agree && n == expected . size () ;
+        for ( unsigned int s = 0 ; agree && s < n ; s ++ ) {
+          Pareto_Search :: Costs const & c = r_search . get_solution ( s ) ;
+          agree = c . values [ 0 ] == expected [ s ] . first
+            && c . values [ 1 ] == expected [ s ] . second ;
+          // The path is at most as costly as announced (with parallel edges,
+          // the cheapest one on each criterion)
+          r_search . get_path ( s , path ) ;
+          Pair sum ( 0 , 0 ) ;
+          for ( size_t k = 0 ; k + 1 < path . size () ; k ++ ) {
+            Graph :: VEdge const & edges = r . get_edges ( path [ k ] ) ;
+            Pair best ( 1e9 , 1e9 ) ;
+            for ( size_t e = 0 ; e < edges . size () ; e ++ ) {
+              if ( edges [ e ] . first == path [ k + 1 ] ) {
+                Pareto_Search :: Costs const & ce = r_search . get_costs ( path [ k ] , e ) ;
+                best . first = min ( best . first , ce . values [ 0 ] ) ;
+                best . second = min ( best . second , ce . values [ 1 ] ) ;
+              }
+            }
+            sum . first += best . first ;
+            sum . second += best . second ;
+          }
+          agree = agree && path . front () == from && path . back () == to
+            && sum . first <= c . values [ 0 ] && sum . second <= c . values [ 1 ] ;
+        }
+        if ( 0 < n ) {
+          fastest = fastest && r_search . get_solution ( 0 ) . values [ 0 ]
+            == dijkstra . shortest_distance ( from , to ) ;
+        }
+      }
+    }
+  }
+  cout << "random agree with simple paths: " << agree << endl ;
+  cout << "fastest agree with Dijkstra: " << fastest << endl ;
+  cout << "solutions: " << nbr_solutions << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,107 @@
+/*!
+ * \file
+ * \brief Test file: one-to-all distances of PHAST over a contraction
+ * hierarchy, checked against Dijkstra's algorithm.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "dijkstra.hpp"
+# include "phast.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  // graph of test_graph, plus an isolated vertex (10)
+  Graph g ( 11 ) ;
+
+  g . add_edge ( 0 , 1 , 2.0 ) ;
+  g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ;
+  g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ;
+  g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ;
+  g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ;
+  g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ;
+  g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ;
+  g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ;
+  g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ;
+  g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+
+  Contraction_Hierarchy ch ( g ) ;
+  Phast phast ( ch ) ;
+  phast . one_to_all ( 3 ) ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    cout << phast . get_distance ( i ) << " " ;
+  }
+  cout << endl ;
+  vector < unsigned int > sources ;
+  sources . push_back ( 0 ) ;
+  sources . push_back ( 9 ) ;
+  sources . push_back ( 10 ) ;
+  phast . many_to_all ( sources ) ;
+  for ( size_t lane = 0 ; lane < sources . size () ; lane ++ ) {
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      cout << phast . get_distance ( lane , i ) << " " ;
+    }
+    cout << endl ;
+  }
+
+  // random grid with extra edges: compared to Dijkstra's algorithm
+  srand ( 2016 ) ;
+  unsigned int const side = 12 ;
+  Graph r ( side * side ) ;
+  for ( unsigned int i = 0 ; i < side * side ; i ++ ) {
+    if ( i % side + 1 < side ) {
+      r . add_edge ( i , i + 1 , 1 + rand () % 100 ) ;
+    }
+    if ( i + side < side * side ) {
+      r . add_edge ( i , i + side , 1 + rand () % 100 ) ;
+    }
+  }
+  for ( unsigned int k = 0 ; k < 20 ; k ++ ) {
+    r . add_edge ( rand () % ( side * side ) , rand () % ( side * side ) , 1 + rand () % 100 ) ;
+  }
+  Contraction_Hierarchy r_ch ( r ) ;
+  Phast r_phast ( r_ch ) ;
+  Dijkstra search ( r ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    search . one_to_all ( i ) ;
+    r_phast . one_to_all ( i ) ;
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+      agree = agree && search . get_distance ( j ) == r_phast . get_distance ( j ) ;
+    }
+  }
+  cout << "one to all agree with Dijkstra: " << agree << endl ;
+
+  agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i += Phast :: nbr_lanes ) {
+    sources . clear () ;
+    for ( unsigned int k = i ; k < i + Phast :: nbr_lanes && k < r . nbr_vertices ; k ++ ) {
+      sources . push_back ( k ) ;
+    }
+    r_phast . many_to_all ( sources ) ;
+    for ( size_t lane = 0 ; lane < sources . size () ; lane ++ ) {
+      search . one_to_all ( sources [ lane ] ) ;
+      for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+        agree = agree && search . get_distance ( j ) == r_phast . get_distance ( lane , j ) ;
+      }
+    }
+  }
+  cout << "many to all agree with Dijkstra: " << agree << endl ;
+
+  return 0 ;
+}
@@ -0,0 +1,117 @@
+/*!
+ * \file
+ * \brief Test file: searches with profiles (modes and weights), checked
+ * against copies of the graph restricted to the modes.
+ */
+
+# include <iostream>
+
+# include <stdlib.h>
+
+# include "dijkstra.hpp"
+# include "profile.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Modes of the test. */
+  Graph :: Modes const car = 1 ;
+  Graph :: Modes const bike = 2 ;
+  Graph :: Modes const foot = 4 ;
+
+  /*! Print the path found by the last query of \c search.
+   * \param search workspace.
+   * \param to last vertex of the path.
+   */
+  void print_path ( Dijkstra const & search , unsigned int to ) {
+    vector < unsigned int > path ;
+    if ( ! search . get_path ( to , path ) ) {
+      cout << "no path to " << to << endl ;
+      return ;
+    }
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << path [ k ] << " " ;
+    }
+    cout << endl ;
+  }
+
+}
+
+
+int main () {
+
+  // a motorway (car), a cycle path (bike, foot), a footpath (foot) and
+  // streets (all)
+  Graph g ( 6 ) ;
+  g . add_edge ( 0 , 1 , 10.0 , car ) ;
+  g . add_edge ( 1 , 5 , 10.0 , car ) ;
+  g . add_edge ( 0 , 2 , 4.0 , bike | foot ) ;
+  g . add_edge ( 2 , 5 , 4.0 , bike | foot ) ;
+  g . add_edge ( 0 , 3 , 3.0 , foot ) ;
+  g . add_edge ( 3 , 5 , 3.0 , foot ) ;
+  g . add_edge ( 0 , 4 , 15.0 ) ;
+  g . add_edge ( 4 , 5 , 15.0 ) ;
+
+  Dijkstra search ( g ) ;
+  cout << "no profile: " << search . shortest_distance ( 0 , 5 ) << endl ;
+  print_path ( search , 5 ) ;
+
+  // weights as travel times, at the speed of the mode
+  Profile car_profile ( g , car ) ;
+  Profile bike_profile ( g , bike ) ;
+  Profile foot_profile ( g , foot ) ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    for ( size_t k = 0 ; k < g . get_edges ( i ) . size () ; k ++ ) {
+      float const len = g . get_edges ( i ) [ k ] . second ;
+      car_profile . set_weight ( i , k , len / 4 ) ;
+      bike_profile . set_weight ( i , k , len / 2 ) ;
+    }
+  }
+  Profile const * const profiles [] = { & car_profile , & bike_profile , & foot_profile } ;
+  char const * const names [] = { "car" , "bike" , "foot" } ;
+  for ( size_t p = 0 ; p < 3 ; p ++ ) {
+    search . set_profile ( profiles [ p ] ) ;
+    cout << names [ p ] << ": " << search . shortest_distance ( 0 , 5 ) << endl ;
+    print_path ( search , 5 ) ;
+  }
+  Profile none ( g , 0 ) ;
+  search . set_profile ( & none ) ;
+  cout << "no mode: " << search . shortest_distance ( 0 , 5 ) << endl ;
+
+  // random graph: compared to copies restricted to each mode
+  srand ( 2016 ) ;
+  Graph r ( 100 ) ;
+  for ( unsigned int k = 0 ; k < 400 ; k ++ ) {
+    r . add_edge ( rand () % 100 , rand () % 100 , 1 + rand () % 100 , 1 + rand () % 7 ) ;
+  }
+  Dijkstra r_search ( r ) ;
+  bool agree = true ;
+  for ( Graph :: Modes m = 1 ; m <= 4 ; m *= 2 ) {
+    Graph copy ( r . nbr_vertices ) ;
+    for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+      for ( size_t k = 0 ; k < r . get_edges ( i ) . size () ; k ++ ) {
+        unsigned int const j = r . get_edges ( i ) [ k ] . first ;
+        if ( i <= j && ( r . get_modes ( i ) [ k ] & m ) != 0 ) {
+          copy . add_edge ( i , j , r . get_edges ( i ) [ k ] . second ) ;
+        }
+      }
+    }
+    Profile profile ( r , m ) ;
+    r_search . set_profile ( & profile ) ;
+    Dijkstra c_search ( copy ) ;
+    for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+      r_search . one_to_all ( i ) ;
+      c_search . one_to_all ( i ) ;
+      for ( unsigned int j = 0 ; j < r . nbr_vertices ; j ++ ) {
+        agree = agree && r_search . get_distance ( j ) == c_search . get_distance ( j ) ;
+      }
+    }
+  }
+  r_search . set_profile ( NULL ) ;
+  cout << "profiles agree with restricted copies: " << agree << endl ;
+
+  return 0 ;
+}
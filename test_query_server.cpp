@@ -0,0 +1,205 @@
+/*!
+ * \file
+ * \brief Test file: runs ./query_server on a grid, drops a connection while
+ * its requests are queued, and checks that the next connection only gets
+ * the responses to its own requests and that a one-to-many request gets the
+ * distances of its targets; then checks that an oversized request closes
+ * its connection.
+ */
+
+# include <fstream>
+# include <iostream>
+# include <vector>
+
+# include <fcntl.h>
+# include <signal.h>
+# include <stdint.h>
+# include <stdio.h>
+# include <string.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <sys/wait.h>
+# include <unistd.h>
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Side of the grid served. */
+  unsigned int const side = 40 ;
+
+  /*! Connect to the server, waiting for it to listen.
+   * \param path socket path.
+   * \return the connection, or -1 if the server does not listen.
+   */
+  int connect_to ( char const * path ) {
+    sockaddr_un address ;
+    memset ( & address , 0 , sizeof ( address ) ) ;
+    address . sun_family = AF_UNIX ;
+    strcpy ( address . sun_path , path ) ;
+    for ( unsigned int k = 0 ; k < 500 ; k ++ ) {
+      int const fd = socket ( AF_UNIX , SOCK_STREAM , 0 ) ;
+      if ( connect ( fd , reinterpret_cast < sockaddr * > ( & address ) ,
+                     sizeof ( address ) ) == 0 ) {
+        return fd ;
+      }
+      close ( fd ) ;
+      usleep ( 10000 ) ;
+    }
+    return -1 ;
+  }
+
+  /*! Append a value to a message. */
+  template < class T > void put ( vector < char > & out , T const value ) {
+    char const * bytes = reinterpret_cast < char const * > ( & value ) ;
+    out . insert ( out . end () , bytes , bytes + sizeof ( T ) ) ;
+  }
+
+  /*! Append a point-to-point request. */
+  void add_request ( vector < char > & out , uint32_t tag , uint32_t from ,
+                     uint32_t to ) {
+    put ( out , static_cast < uint32_t > ( 13 ) ) ;
+    put ( out , tag ) ;
+    put ( out , static_cast < uint8_t > ( 0 ) ) ;
+    put ( out , from ) ;
+    put ( out , to ) ;
+  }
+
+  /*! Read exactly \c size bytes.
+   * \return false iff the connection ended before.
+   */
+  bool read_all ( int fd , char * data , size_t size ) {
+    while ( 0 < size ) {
+      ssize_t const n = read ( fd , data , size ) ;
+      if ( n <= 0 ) {
+        return false ;
+      }
+      data += n ;
+      size -= n ;
+    }
+    return true ;
+  }
+
+}
+
+
+int main () {
+
+  // GRID, unit lengths
+  char graph_path [ 64 ] ;
+  char socket_path [ 64 ] ;
+  sprintf ( graph_path , "/tmp/test_query_server_%d.txt" , getpid () ) ;
+  sprintf ( socket_path , "/tmp/test_query_server_%d.sock" , getpid () ) ;
+  {
+    ofstream file ( graph_path ) ;
+    file << side * side << endl ;
+    for ( unsigned int i = 0 ; i < side * side ; i ++ ) {
+      if ( ( i + 1 ) % side != 0 ) {
+        file << i << " " << i + 1 << " 1.0" << endl ;
+      }
+      if ( i + side < side * side ) {
+        file << i << " " << i + side << " 1.0" << endl ;
+      }
+    }
+  }
+
+  // SERVER, one worker: the connections are served one after the other
+  pid_t const server = fork () ;
+  if ( server == 0 ) {
+    int const null_fd = open ( "/dev/null" , O_WRONLY ) ;
+    dup2 ( null_fd , 2 ) ;
+    execl ( "./query_server" , "./query_server" , graph_path , socket_path ,
+            "1" , static_cast < char * > ( NULL ) ) ;
+    _exit ( 1 ) ;
+  }
+  signal ( SIGPIPE , SIG_IGN ) ;
+
+  // A client sends long requests then leaves without reading
+  int fd = connect_to ( socket_path ) ;
+  cout << "connected: " << ( 0 <= fd ) << endl ;
+  vector < char > out ;
+  for ( uint32_t k = 0 ; k < 200 ; k ++ ) {
+    add_request ( out , 1000 + k , 0 , side * side - 1 ) ;
+  }
+  cout << "sent: " << ( write ( fd , & out [ 0 ] , out . size () )
+                        == static_cast < ssize_t > ( out . size () ) ) << endl ;
+  close ( fd ) ;
+
+  // The next client only gets its own responses
+  fd = connect_to ( socket_path ) ;
+  out . clear () ;
+  for ( uint32_t k = 1 ; k <= 3 ; k ++ ) {
+    add_request ( out , k , 0 , k * ( side + 1 ) ) ;
+  }
+  write ( fd , & out [ 0 ] , out . size () ) ;
+  for ( unsigned int k = 0 ; k < 3 ; k ++ ) {
+    uint32_t length ;
+    vector < char > payload ;
+    if ( ! read_all ( fd , reinterpret_cast < char * > ( & length ) ,
+                      sizeof ( length ) ) ) {
+      cout << "connection closed" << endl ;
+      break ;
+    }
+    payload . resize ( length ) ;
+    read_all ( fd , & payload [ 0 ] , length ) ;
+    uint32_t tag ;
+    float distance ;
+    memcpy ( & tag , & payload [ 0 ] , sizeof ( tag ) ) ;
+    memcpy ( & distance , & payload [ 5 ] , sizeof ( distance ) ) ;
+    cout << "tag " << tag << ": status " << int ( payload [ 4 ] )
+         << ", distance " << distance << endl ;
+  }
+  close ( fd ) ;
+
+  // A one-to-many request answers once its targets are treated
+  fd = connect_to ( socket_path ) ;
+  out . clear () ;
+  uint32_t const targets [] = { 1 , side + 1 , 2 } ;
+  put ( out , static_cast < uint32_t > ( 13 + sizeof ( targets ) ) ) ;
+  put ( out , static_cast < uint32_t > ( 7 ) ) ;
+  put ( out , static_cast < uint8_t > ( 1 ) ) ;
+  put ( out , static_cast < uint32_t > ( 0 ) ) ;
+  put ( out , static_cast < uint32_t > ( 3 ) ) ;
+  for ( size_t k = 0 ; k < 3 ; k ++ ) {
+    put ( out , targets [ k ] ) ;
+  }
+  write ( fd , & out [ 0 ] , out . size () ) ;
+  {
+    uint32_t length ;
+    vector < char > payload ;
+    read_all ( fd , reinterpret_cast < char * > ( & length ) , sizeof ( length ) ) ;
+    payload . resize ( length ) ;
+    read_all ( fd , & payload [ 0 ] , length ) ;
+    uint32_t tag ;
+    memcpy ( & tag , & payload [ 0 ] , sizeof ( tag ) ) ;
+    cout << "tag " << tag << ": status " << int ( payload [ 4 ] )
+         << ", distances" ;
+    for ( size_t k = 0 ; 5 + ( k + 1 ) * sizeof ( float ) <= length ; k ++ ) {
+      float distance ;
+      memcpy ( & distance , & payload [ 5 + k * sizeof ( float ) ] , sizeof ( distance ) ) ;
+      cout << " " << distance ;
+    }
+    cout << endl ;
+  }
+  close ( fd ) ;
+
+  // A request announced too long closes the connection
+  fd = connect_to ( socket_path ) ;
+  out . clear () ;
+  put ( out , static_cast < uint32_t > ( 0xffffffff ) ) ;
+  put ( out , static_cast < uint32_t > ( 4 ) ) ;
+  write ( fd , & out [ 0 ] , out . size () ) ;
+  char byte ;
+  cout << "oversized request closes: " << ( read ( fd , & byte , 1 ) == 0 )
+       << endl ;
+  close ( fd ) ;
+
+  kill ( server , SIGTERM ) ;
+  int status ;
+  waitpid ( server , & status , 0 ) ;
+  cout << "server stopped: " << WIFEXITED ( status ) << endl ;
+  unlink ( graph_path ) ;
+  return 0 ;
+}
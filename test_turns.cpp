@@ -0,0 +1,127 @@
+/*!
+ * \file
+ * \brief Test file: edge-based shortest paths with turn restrictions and
+ * turn costs.
+ */
+
+# include <iostream>
+
+# include <limits>
+# include <stdlib.h>
+
+# include "turns.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Print the path found by the last query of \c search. */
+  void print_path ( Turn_Dijkstra const & search ) {
+    vector < unsigned int > path ;
+    if ( ! search . get_path ( path ) ) {
+      cout << "no path" << endl ;
+      return ;
+    }
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << path [ k ] << " " ;
+    }
+    cout << endl ;
+  }
+
+  /*! \return a turn. */
+  Turn_Table :: Turn turn ( unsigned int from , unsigned int via , unsigned int to , float penalty ) {
+    Turn_Table :: Turn t = { from , via , to , penalty } ;
+    return t ;
+  }
+
+}
+
+
+int main () {
+
+  float const forbidden = numeric_limits < float > :: infinity () ;
+
+  // 3 x 3 grid:
+  //  0 - 1 - 2
+  //  |   |   |
+  //  3 - 4 - 5
+  //  |   |   |
+  //  6 - 7 - 8
+  Graph g ( 9 ) ;
+  g . add_edge ( 0 , 1 , 1.0 ) ;
+  g . add_edge ( 1 , 2 , 1.0 ) ;
+  g . add_edge ( 3 , 4 , 1.5 ) ;
+  g . add_edge ( 4 , 5 , 1.5 ) ;
+  g . add_edge ( 6 , 7 , 2.0 ) ;
+  g . add_edge ( 7 , 8 , 2.0 ) ;
+  g . add_edge ( 0 , 3 , 1.0 ) ;
+  g . add_edge ( 3 , 6 , 1.0 ) ;
+  g . add_edge ( 1 , 4 , 1.0 ) ;
+  g . add_edge ( 4 , 7 , 1.0 ) ;
+  g . add_edge ( 2 , 5 , 1.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ;
+
+  // no turn costs
+  vector < Turn_Table :: Turn > turns ;
+  Turn_Table free_table ( g , turns ) ;
+  Turn_Dijkstra free_search ( free_table ) ;
+  cout << "0 -> 8: " << free_search . shortest_distance ( 0 , 8 ) << endl ;
+  print_path ( free_search ) ;
+  cout << "4 -> 4: " << free_search . shortest_distance ( 4 , 4 ) << endl ;
+  print_path ( free_search ) ;
+
+  // no right turn from 1 to 2 then 5, turning at 4 costs 3
+  turns . push_back ( turn ( 1 , 2 , 5 , forbidden ) ) ;
+  turns . push_back ( turn ( 3 , 4 , 1 , 3.0 ) ) ;
+  turns . push_back ( turn ( 3 , 4 , 7 , 3.0 ) ) ;
+  turns . push_back ( turn ( 1 , 4 , 3 , 3.0 ) ) ;
+  turns . push_back ( turn ( 1 , 4 , 5 , 3.0 ) ) ;
+  turns . push_back ( turn ( 5 , 4 , 1 , 3.0 ) ) ;
+  turns . push_back ( turn ( 5 , 4 , 7 , 3.0 ) ) ;
+  turns . push_back ( turn ( 7 , 4 , 3 , 3.0 ) ) ;
+  turns . push_back ( turn ( 7 , 4 , 5 , 3.0 ) ) ;
+  Turn_Table table ( g , turns , forbidden ) ;
+  Turn_Dijkstra search ( table ) ;
+  cout << "0 -> 8: " << search . shortest_distance ( 0 , 8 ) << endl ;
+  print_path ( search ) ;
+  cout << "0 -> 5: " << search . shortest_distance ( 0 , 5 ) << endl ;
+  print_path ( search ) ;
+
+  // a dead end reachable only through a forbidden turn, U-turns allowed
+  Graph d ( 4 ) ;
+  d . add_edge ( 0 , 1 , 1.0 ) ;
+  d . add_edge ( 1 , 2 , 1.0 ) ;
+  d . add_edge ( 1 , 3 , 1.0 ) ;
+  turns . clear () ;
+  turns . push_back ( turn ( 0 , 1 , 2 , forbidden ) ) ;
+  Turn_Table d_table ( d , turns , 4.0 ) ;
+  Turn_Dijkstra d_search ( d_table ) ;
+  cout << "0 -> 2 by a U-turn: " << d_search . shortest_distance ( 0 , 2 ) << endl ;
+  print_path ( d_search ) ;
+  Turn_Table d_strict ( d , turns , forbidden ) ;
+  Turn_Dijkstra d_strict_search ( d_strict ) ;
+  cout << "0 -> 2 without U-turn: " << d_strict_search . shortest_distance ( 0 , 2 ) << endl ;
+  print_path ( d_strict_search ) ;
+
+  // random graph without turn costs: compared to Dijkstra's algorithm
+  srand ( 2016 ) ;
+  Graph r ( 50 ) ;
+  for ( unsigned int k = 0 ; k < 120 ; k ++ ) {
+    r . add_edge ( rand () % 50 , rand () % 50 , 1 + rand () % 100 ) ;
+  }
+  turns . clear () ;
+  Turn_Table r_table ( r , turns ) ;
+  Turn_Dijkstra r_search ( r_table ) ;
+  Dijkstra dijkstra ( r ) ;
+  bool agree = true ;
+  for ( unsigned int i = 0 ; i < r . nbr_vertices ; i ++ ) {
+    for ( unsigned int j = 0 ; j < r . nbr_vertices ; j += 5 ) {
+      agree = agree && r_search . shortest_distance ( i , j ) == dijkstra . shortest_distance ( i , j ) ;
+    }
+  }
+  cout << "agree with Dijkstra: " << agree << endl ;
+
+  return 0 ;
+}
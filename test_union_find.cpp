@@ -0,0 +1,31 @@
+/*!
+ * \file
+ * \brief Test file: merges some sets and checks the partition.
+ */
+
+# include <iostream>
+
+# include "union_find.hpp"
+
+
+using namespace std ;
+
+
+int main () {
+
+  Union_Find uf ( 10 ) ;
+  cout << uf . get_nbr_sets () << " sets" << endl ;
+
+  cout << uf . unite ( 0 , 1 ) << uf . unite ( 2 , 3 ) << uf . unite ( 1 , 3 )
+       << uf . unite ( 0 , 2 ) << uf . unite ( 7 , 8 ) << uf . unite ( 9 , 8 )
+       << endl ;
+  cout << uf . get_nbr_sets () << " sets" << endl ;
+
+  for ( unsigned int i = 0 ; i < uf . size ; i ++ ) {
+    for ( unsigned int j = 0 ; j < uf . size ; j ++ ) {
+      cout << uf . is_same_set ( i , j ) ;
+    }
+    cout << endl ;
+  }
+  return 0 ;
+}
@@ -0,0 +1,201 @@
+/*!
+ * \file
+ * \brief Test file: updates a graph while readers pin its versions, and
+ * checks that the versions pinned stay readable and are deleted after, with
+ * the readers interleaved on one thread then running on threads of their own.
+ */
+
+# include <iostream>
+# include <vector>
+
+# include <pthread.h>
+# include <stdlib.h>
+
+# include "dijkstra.hpp"
+# include "versions.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! State of a reader thread. */
+  struct Reader_Thread {
+    Graph_Versions * versions ;
+    unsigned int reader ;
+    /*! Number of arcs of the version \c base_number. */
+    unsigned int base ;
+    unsigned long base_number ;
+    /*! Set by the writer when it is done. */
+    int volatile * is_done ;
+    bool consistent ;
+    unsigned int nbr_pins ;
+  } ;
+
+  /*! Pin the versions and search them till the writer is done. */
+  void * read_versions ( void * context ) {
+    Reader_Thread & t = * static_cast < Reader_Thread * > ( context ) ;
+    while ( ! __sync_fetch_and_add ( t . is_done , 0 ) ) {
+      Graph_Versions :: Version const & v = t . versions -> pin ( t . reader ) ;
+      Dijkstra search ( * v . graph ) ;
+      float const d = search . shortest_distance ( 0 , 10 ) ;
+      t . consistent = t . consistent
+        && v . graph -> get_nbr_arcs () == t . base + 2 * ( v . number - t . base_number )
+        && search . shortest_distance ( 0 , 10 ) == d ;
+      t . versions -> unpin ( t . reader ) ;
+      t . nbr_pins ++ ;
+    }
+    return NULL ;
+  }
+
+}
+
+
+int main () {
+
+  Graph * g = new Graph ( 11 ) ;
+  g -> add_edge ( 0 , 1 , 2.0 ) ; g -> add_edge ( 0 , 2 , 4.0 ) ;
+  g -> add_edge ( 0 , 3 , 7.0 ) ; g -> add_edge ( 1 , 2 , 3.0 ) ;
+  g -> add_edge ( 1 , 4 , 3.0 ) ; g -> add_edge ( 2 , 3 , 2.0 ) ;
+  g -> add_edge ( 2 , 4 , 9.0 ) ; g -> add_edge ( 2 , 5 , 7.0 ) ;
+  g -> add_edge ( 2 , 6 , 9.0 ) ; g -> add_edge ( 3 , 6 , 4.0 ) ;
+  g -> add_edge ( 4 , 5 , 4.0 ) ; g -> add_edge ( 4 , 7 , 9.0 ) ;
+  g -> add_edge ( 5 , 6 , 6.0 ) ; g -> add_edge ( 5 , 7 , 5.0 ) ;
+  g -> add_edge ( 5 , 8 , 1.0 ) ; g -> add_edge ( 5 , 9 , 6.0 ) ;
+  g -> add_edge ( 6 , 8 , 9.0 ) ; g -> add_edge ( 7 , 9 , 3.0 ) ;
+  g -> add_edge ( 8 , 9 , 4.0 ) ;
+
+  Graph_Versions versions ( g ) ;
+  unsigned int const r1 = versions . add_reader () ;
+  unsigned int const r2 = versions . add_reader () ;
+  cout << "readers: " << r1 << " " << r2 << endl ;
+
+  // r1 pins version 1
+  Graph_Versions :: Version const & v1 = versions . pin ( r1 ) ;
+  Dijkstra search1 ( * v1 . graph ) ;
+  cout << "version " << v1 . number << ": 0 -> 9 "
+       << search1 . shortest_distance ( 0 , 9 ) << ", 0 -> 10 "
+       << search1 . shortest_distance ( 0 , 10 ) << endl ;
+
+  // an update: a new edge and a shorter edge 5-8
+  Graph * u = versions . begin_update () ;
+  u -> add_edge ( 9 , 10 , 1.0 ) ;
+  for ( size_t k = 0 ; k < u -> get_edges ( 8 ) . size () ; k ++ ) {
+    if ( u -> get_edges ( 8 ) [ k ] . first == 5 ) {
+      u -> set_length ( 8 , k , 0.5 ) ;
+    }
+  }
+  cout << "published: " << versions . publish ( u )
+       << ", retired: " << versions . get_nbr_retired () << endl ;
+
+  // r1 still searches version 1
+  cout << "version " << v1 . number << ": 0 -> 9 "
+       << search1 . shortest_distance ( 0 , 9 ) << ", 0 -> 10 "
+       << search1 . shortest_distance ( 0 , 10 ) << endl ;
+
+  // r2 pins version 2
+  Graph_Versions :: Version const & v2 = versions . pin ( r2 ) ;
+  Dijkstra search2 ( * v2 . graph ) ;
+  cout << "version " << v2 . number << ": 0 -> 9 "
+       << search2 . shortest_distance ( 0 , 9 ) << ", 0 -> 10 "
+       << search2 . shortest_distance ( 0 , 10 ) << ", 10 -> 0 "
+       << search2 . shortest_distance ( 10 , 0 ) << endl ;
+
+  // an update given up
+  u = versions . begin_update () ;
+  u -> add_edge ( 0 , 10 , 1.0 ) ;
+  versions . abort_update ( u ) ;
+  cout << "version: " << versions . get_version_number () << endl ;
+
+  // version 1 is deleted once r1 unpins it
+  cout << "reclaimed while pinned: " << versions . reclaim () << endl ;
+  versions . unpin ( r1 ) ;
+  cout << "reclaimed: " << versions . reclaim ()
+       << ", retired: " << versions . get_nbr_retired () << endl ;
+  versions . unpin ( r2 ) ;
+
+  // readers and a writer interleaved at random: each version has one more
+  // edge than the previous one, and a version pinned is never deleted (the
+  // versions newer than the oldest pinned are kept too)
+  srand ( 2016 ) ;
+  vector < Graph_Versions :: Version const * > pinned ( 4 , NULL ) ;
+  vector < unsigned int > readers ;
+  for ( unsigned int k = 0 ; k < pinned . size () ; k ++ ) {
+    readers . push_back ( versions . add_reader () ) ;
+  }
+  unsigned int const base = versions . pin ( r1 ) . graph -> get_nbr_arcs () ;
+  unsigned long const base_number = versions . get_version_number () ;
+  versions . unpin ( r1 ) ;
+  bool consistent = true ;
+  unsigned int max_retired = 0 ;
+  for ( unsigned int step = 0 ; step < 2000 ; step ++ ) {
+    unsigned int const k = rand () % ( pinned . size () + 1 ) ;
+    if ( k == pinned . size () ) {
+      Graph * w = versions . begin_update () ;
+      w -> add_edge ( rand () % 11 , rand () % 11 , 1 + rand () % 10 ) ;
+      versions . publish ( w ) ;
+    } else if ( pinned [ k ] == NULL ) {
+      pinned [ k ] = & versions . pin ( readers [ k ] ) ;
+    } else {
+      Graph_Versions :: Version const & v = * pinned [ k ] ;
+      consistent = consistent && v . graph -> get_nbr_arcs ()
+        == base + 2 * ( v . number - base_number ) ;
+      versions . unpin ( readers [ k ] ) ;
+      pinned [ k ] = NULL ;
+    }
+    if ( max_retired < versions . get_nbr_retired () ) {
+      max_retired = versions . get_nbr_retired () ;
+    }
+  }
+  for ( unsigned int k = 0 ; k < pinned . size () ; k ++ ) {
+    if ( pinned [ k ] != NULL ) {
+      versions . unpin ( readers [ k ] ) ;
+    }
+    versions . remove_reader ( readers [ k ] ) ;
+  }
+  versions . reclaim () ;
+  cout << "consistent: " << consistent
+       << ", retired at most: " << max_retired
+       << ", retired at the end: " << versions . get_nbr_retired () << endl ;
+
+  // readers on threads of their own while the main thread writes: the
+  // pinned versions are searched (reading the components of the graph)
+  // while newer ones are published and the older ones deleted
+  unsigned int const nbr_threads = 4 ;
+  int volatile is_done = 0 ;
+  Reader_Thread threads [ nbr_threads ] ;
+  pthread_t ids [ nbr_threads ] ;
+  for ( unsigned int k = 0 ; k < nbr_threads ; k ++ ) {
+    threads [ k ] . versions = & versions ;
+    threads [ k ] . reader = versions . add_reader () ;
+    threads [ k ] . base = base + 2 * ( versions . get_version_number () - base_number ) ;
+    threads [ k ] . base_number = versions . get_version_number () ;
+    threads [ k ] . is_done = & is_done ;
+    threads [ k ] . consistent = true ;
+    threads [ k ] . nbr_pins = 0 ;
+    pthread_create ( & ids [ k ] , NULL , read_versions , & threads [ k ] ) ;
+  }
+  for ( unsigned int step = 0 ; step < 500 ; step ++ ) {
+    Graph * w = versions . begin_update () ;
+    w -> add_edge ( rand () % 11 , rand () % 11 , 1 + rand () % 10 ) ;
+    versions . publish ( w ) ;
+  }
+  __sync_fetch_and_add ( & is_done , 1 ) ;
+  bool threads_consistent = true ;
+  unsigned int nbr_pins = 0 ;
+  for ( unsigned int k = 0 ; k < nbr_threads ; k ++ ) {
+    pthread_join ( ids [ k ] , NULL ) ;
+    threads_consistent = threads_consistent && threads [ k ] . consistent ;
+    nbr_pins += threads [ k ] . nbr_pins ;
+    versions . remove_reader ( threads [ k ] . reader ) ;
+  }
+  versions . reclaim () ;
+  cout << "threads consistent: " << threads_consistent
+       << ", pinned: " << ( 0 < nbr_pins )
+       << ", retired at the end: " << versions . get_nbr_retired () << endl ;
+
+  versions . remove_reader ( r1 ) ;
+  versions . remove_reader ( r2 ) ;
+  return 0 ;
+}
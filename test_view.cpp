@@ -0,0 +1,297 @@
+/*!
+ * \file
+ * \brief Test file: searches restricted to views of a graph, checked against
+ * the subgraphs built with the vertices and edges of the views.
+ */
+
+# include <iostream>
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "betweenness.hpp"
+# include "bfs.hpp"
+# include "closeness.hpp"
+# include "constrained.hpp"
+# include "diameter.hpp"
+# include "dijkstra.hpp"
+# include "johnson.hpp"
+# include "multi_source.hpp"
+# include "pareto.hpp"
+# include "turns.hpp"
+# include "view.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Print the path found by the last query of \c search.
+   * \param search workspace.
+   * \param to last vertex of the path.
+   */
+  void print_path ( Dijkstra const & search , unsigned int to ) {
+    vector < unsigned int > path ;
+    if ( ! search . get_path ( to , path ) ) {
+      cout << "no path to " << to << endl ;
+      return ;
+    }
+    for ( size_t k = 0 ; k < path . size () ; k ++ ) {
+      cout << path [ k ] << " " ;
+    }
+    cout << endl ;
+  }
+
+  /*! Second cost (and resource) of an edge: the same in a subgraph. */
+  float second_cost ( unsigned int i , unsigned int j , float len ) {
+    return float ( ( i * 7 + j * 7 + int ( len ) ) % 11 ) ;
+  }
+
+  /*! Set the second costs of the edges of \c g in \c pareto and
+   * \c constrained. */
+  void set_second_costs ( Graph const & g , Pareto_Search & pareto ,
+                          Constrained_Search & constrained ) {
+    for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+      Graph :: VEdge const & edges = g . get_edges ( i ) ;
+      for ( size_t k = 0 ; k < edges . size () ; k ++ ) {
+        float const c = second_cost ( i , edges [ k ] . first , edges [ k ] . second ) ;
+        pareto . set_cost ( i , k , 1 , c ) ;
+        constrained . set_resource ( i , k , c ) ;
+      }
+    }
+  }
+
+  /*! Position of the first edge from \c i to \c j. */
+  size_t position ( Graph const & g , unsigned int i , unsigned int j ) {
+    size_t k = 0 ;
+    while ( g . get_edges ( i ) [ k ] . first != j ) {
+      k ++ ;
+    }
+    return k ;
+  }
+
+}
+
+
+int main () {
+
+  Graph g ( 11 ) ;
+  g . add_edge ( 0 , 1 , 2.0 ) ; g . add_edge ( 0 , 2 , 4.0 ) ;
+  g . add_edge ( 0 , 3 , 7.0 ) ; g . add_edge ( 1 , 2 , 3.0 ) ;
+  g . add_edge ( 1 , 4 , 3.0 ) ; g . add_edge ( 2 , 3 , 2.0 ) ;
+  g . add_edge ( 2 , 4 , 9.0 ) ; g . add_edge ( 2 , 5 , 7.0 ) ;
+  g . add_edge ( 2 , 6 , 9.0 ) ; g . add_edge ( 3 , 6 , 4.0 ) ;
+  g . add_edge ( 4 , 5 , 4.0 ) ; g . add_edge ( 4 , 7 , 9.0 ) ;
+  g . add_edge ( 5 , 6 , 6.0 ) ; g . add_edge ( 5 , 7 , 5.0 ) ;
+  g . add_edge ( 5 , 8 , 1.0 ) ; g . add_edge ( 5 , 9 , 6.0 ) ;
+  g . add_edge ( 6 , 8 , 9.0 ) ; g . add_edge ( 7 , 9 , 3.0 ) ;
+  g . add_edge ( 8 , 9 , 4.0 ) ;
+
+  Dijkstra search ( g ) ;
+  Bfs bfs ( g ) ;
+  cout << "0 -> 9: " << search . shortest_distance ( 0 , 9 ) << endl ;
+  print_path ( search , 9 ) ;
+
+  // without vertex 5
+  Graph_View view ( g ) ;
+  view . set_vertex ( 5 , false ) ;
+  search . set_view ( & view ) ;
+  bfs . set_view ( & view ) ;
+  cout << "without 5, 0 -> 9: " << search . shortest_distance ( 0 , 9 ) << endl ;
+  print_path ( search , 9 ) ;
+  bfs . run ( 0 , g . nbr_vertices ) ;
+  cout << "hops to 9: " << bfs . get_hops ( 9 ) << ", to 5: "
+       << ( bfs . get_hops ( 5 ) == Bfs :: unreached ) << endl ;
+
+  // and without edge 9-7 (given from 7)
+  view . set_edge ( 7 , position ( g , 7 , 9 ) , false ) ;
+  cout << "without 5 nor 7-9, 0 -> 9: " << search . shortest_distance ( 0 , 9 )
+       << ", 9 -> 0: " << search . shortest_distance ( 9 , 0 ) << endl ;
+  print_path ( search , 0 ) ;
+  cout << "edge 9-7 in view: " << view . has_edge ( 9 , position ( g , 9 , 7 ) )
+       << ", vertices in view: " << view . get_nbr_vertices () << endl ;
+
+  // a region: only vertices 0 to 4
+  Graph_View region ( g , false ) ;
+  for ( unsigned int i = 0 ; i <= 4 ; i ++ ) {
+    region . set_vertex ( i , true ) ;
+  }
+  search . set_view ( & region ) ;
+  search . one_to_all ( 0 ) ;
+  for ( unsigned int i = 0 ; i < g . nbr_vertices ; i ++ ) {
+    cout << search . get_distance ( i ) << " " ;
+  }
+  cout << endl ;
+  search . set_view ( NULL ) ;
+  cout << "no view, 0 -> 9: " << search . shortest_distance ( 0 , 9 ) << endl ;
+
+  // random views of a random graph (with hubs), compared to the subgraphs
+  srand ( 2016 ) ;
+  unsigned int const n = 80 ;
+  Graph r ( n ) ;
+  for ( unsigned int k = 0 ; k < 400 ; k ++ ) {
+    unsigned int const i = ( k % 2 == 0 ) ? rand () % 3 : rand () % n ;
+    r . add_edge ( i , rand () % n , float ( 1 + rand () % 20 ) ) ;
+  }
+  Dijkstra r_search ( r ) ;
+  Bfs r_bfs ( r ) ;
+  Lane_Dijkstra r_lanes ( r ) ;
+  Bit_Parallel_Bfs r_bit_bfs ( r ) ;
+  Turn_Table r_turns ( r , vector < Turn_Table :: Turn > () ) ;
+  Turn_Dijkstra r_turn_search ( r_turns ) ;
+  Pareto_Search r_pareto ( r ) ;
+  Constrained_Search r_constrained ( r ) ;
+  set_second_costs ( r , r_pareto , r_constrained ) ;
+  bool agree = true ;
+  bool others_agree = true ;
+  bool engines_agree = true ;
+  for ( unsigned int round = 0 ; round < 5 ; round ++ ) {
+    Graph_View v ( r ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      if ( rand () % 5 == 0 ) {
+        v . set_vertex ( i , false ) ;
+      }
+      for ( size_t k = 0 ; k < r . get_edges ( i ) . size () ; k ++ ) {
+        if ( rand () % 4 == 0 ) {
+          v . set_edge ( i , k , false ) ;
+        }
+      }
+    }
+    Graph sub ( n ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      Graph :: VEdge const & edges = r . get_edges ( i ) ;
+      for ( size_t k = 0 ; k < edges . size () ; k ++ ) {
+        // each edge once (a loop is twice at i)
+        if ( ( i < edges [ k ] . first || ( i == edges [ k ] . first && k % 2 == 0 ) )
+             && v . has_vertex ( i ) && v . has_arc ( i , k , edges [ k ] . first ) ) {
+          sub . add_edge ( i , edges [ k ] . first , edges [ k ] . second ) ;
+        }
+      }
+    }
+    r_search . set_view ( & v ) ;
+    r_bfs . set_view ( & v ) ;
+    r_lanes . set_view ( & v ) ;
+    r_bit_bfs . set_view ( & v ) ;
+    r_turn_search . set_view ( & v ) ;
+    r_pareto . set_view ( & v ) ;
+    r_constrained . set_view ( & v ) ;
+    Dijkstra sub_search ( sub ) ;
+    Bfs sub_bfs ( sub ) ;
+    Lane_Dijkstra sub_lanes ( sub ) ;
+    Bit_Parallel_Bfs sub_bit_bfs ( sub ) ;
+    Turn_Table sub_turns ( sub , vector < Turn_Table :: Turn > () ) ;
+    Turn_Dijkstra sub_turn_search ( sub_turns ) ;
+    Pareto_Search sub_pareto ( sub ) ;
+    Constrained_Search sub_constrained ( sub ) ;
+    set_second_costs ( sub , sub_pareto , sub_constrained ) ;
+    // the other searches, on the first views only (the debug heaps are
+    // slow)
+    if ( round < 2 ) {
+      // a batch of sources in the view
+      vector < unsigned int > sources ;
+      for ( unsigned int i = 0 ; i < n && sources . size () < Lane_Dijkstra :: nbr_lanes ; i ++ ) {
+        if ( v . has_vertex ( i ) ) {
+          sources . push_back ( i ) ;
+        }
+      }
+      r_lanes . run ( sources ) ;
+      sub_lanes . run ( sources ) ;
+      r_bit_bfs . run ( sources ) ;
+      sub_bit_bfs . run ( sources ) ;
+      for ( unsigned int lane = 0 ; lane < sources . size () ; lane ++ ) {
+        for ( unsigned int j = 0 ; j < n ; j ++ ) {
+          others_agree = others_agree
+            && r_lanes . get_distance ( lane , j ) == sub_lanes . get_distance ( lane , j )
+            && r_bit_bfs . get_hops ( lane , j ) == sub_bit_bfs . get_hops ( lane , j ) ;
+        }
+      }
+      // point-to-point queries between vertices of the view
+      for ( size_t a = 0 ; a + 1 < sources . size () && a < 3 ; a ++ ) {
+        unsigned int const from = sources [ a ] ;
+        unsigned int const to = sources [ a + 1 ] ;
+        others_agree = others_agree
+          && r_turn_search . shortest_distance ( from , to )
+             == sub_turn_search . shortest_distance ( from , to )
+          && r_constrained . run ( from , to , 15 ) == sub_constrained . run ( from , to , 15 ) ;
+        unsigned int const nbr_solutions = r_pareto . run ( from , to ) ;
+        others_agree = others_agree && nbr_solutions == sub_pareto . run ( from , to ) ;
+        for ( unsigned int s = 0 ; s < nbr_solutions && others_agree ; s ++ ) {
+          for ( unsigned int c = 0 ; c < Pareto_Search :: nbr_criteria ; c ++ ) {
+            others_agree = others_agree
+              && r_pareto . get_solution ( s ) . values [ c ] == sub_pareto . get_solution ( s ) . values [ c ] ;
+          }
+        }
+      }
+    }
+    // the engines built on the searches, on the first view only
+    if ( round == 0 ) {
+      Johnson r_johnson ( r ) ;
+      Johnson sub_johnson ( sub ) ;
+      r_johnson . set_view ( & v ) ;
+      Betweenness r_betweenness ( r ) ;
+      Betweenness sub_betweenness ( sub ) ;
+      r_betweenness . set_view ( & v ) ;
+      r_betweenness . add_all_sources ( 2 ) ;
+      sub_betweenness . add_all_sources ( 2 ) ;
+      Closeness r_closeness ( r ) ;
+      Closeness sub_closeness ( sub ) ;
+      r_closeness . set_nbr_workers ( 2 ) ;
+      sub_closeness . set_nbr_workers ( 2 ) ;
+      r_closeness . set_view ( & v ) ;
+      r_closeness . run_all () ;
+      sub_closeness . run_all () ;
+      Diameter r_diameter ( r ) ;
+      Diameter sub_diameter ( sub ) ;
+      r_diameter . set_view ( & v ) ;
+      engines_agree = engines_agree
+        && r_diameter . run_all () == sub_diameter . run_all ()
+        && r_diameter . is_exact () && sub_diameter . is_exact () ;
+      for ( unsigned int i = 0 ; i < n ; i ++ ) {
+        double const c = sub_betweenness . get_vertex_centrality ( i ) ;
+        engines_agree = engines_agree
+          && fabs ( r_betweenness . get_vertex_centrality ( i ) - c ) <= 1e-9 * ( 1 + c )
+          && r_closeness . get_closeness () [ i ] == sub_closeness . get_closeness () [ i ]
+          && r_closeness . get_harmonic () [ i ] == sub_closeness . get_harmonic () [ i ] ;
+        if ( v . has_vertex ( i ) ) {
+          r_johnson . one_to_all ( i ) ;
+          sub_johnson . one_to_all ( i ) ;
+          for ( unsigned int j = 0 ; j < n ; j ++ ) {
+            engines_agree = engines_agree
+              && r_johnson . get_distance ( j ) == sub_johnson . get_distance ( j ) ;
+          }
+        }
+      }
+    }
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      if ( ! v . has_vertex ( i ) ) {
+        continue ;
+      }
+      r_search . one_to_all ( i ) ;
+      sub_search . one_to_all ( i ) ;
+      r_bfs . run ( i , n ) ;
+      sub_bfs . run ( i , n ) ;
+      for ( unsigned int j = 0 ; j < n ; j ++ ) {
+        agree = agree && r_search . get_distance ( j ) == sub_search . get_distance ( j )
+          && r_bfs . get_hops ( j ) == sub_bfs . get_hops ( j ) ;
+      }
+    }
+  }
+  cout << "views agree with subgraphs: " << agree << endl ;
+  cout << "multi-source, turn, Pareto and constrained searches agree: "
+       << others_agree << endl ;
+  cout << "Johnson, betweenness, closeness and diameter agree: "
+       << engines_agree << endl ;
+
+  // two parallel edges of the same length: leaving the second one out of
+  // the view leaves its own edge back, not the one of the first edge
+  Graph p ( 2 ) ;
+  p . add_edge ( 0 , 1 , 1.0 ) ;
+  p . add_edge ( 0 , 1 , 1.0 ) ;
+  Graph_View pv ( p ) ;
+  pv . set_edge ( 0 , 1 , false ) ;
+  cout << "parallel edges in the view: " << pv . has_edge ( 0 , 0 ) << " "
+       << pv . has_edge ( 1 , 0 ) << ", " << pv . has_edge ( 0 , 1 ) << " "
+       << pv . has_edge ( 1 , 1 ) << endl ;
+  return 0 ;
+}
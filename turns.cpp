@@ -0,0 +1,235 @@
+/*!
+ * \file
+ * \brief This module provides edge-based shortest paths on Graph, with turn
+ * restrictions and turn costs.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <algorithm> // sort, lower_bound
+#include <limits>
+
+#include "turns.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+namespace {
+
+/*! Constant to indicate that the arc is not reachable yet. */
+int const id_undefined = -1;
+
+/*! Constant to indicate that the arc was treated. */
+int const id_treated = -2;
+
+/*! Distance of the arcs not reached yet. */
+float const infinity = numeric_limits<float>::infinity();
+
+/*! A turn between two arcs. */
+struct Arc_Turn {
+  unsigned int in;
+  unsigned int out;
+  float penalty;
+
+  bool operator<(Arc_Turn const &t) const {
+    return (in != t.in) ? in < t.in : out < t.out;
+  }
+};
+
+/*! To search an out arc among the turns of an in arc. */
+bool is_before(pair<unsigned int, float> const &turn, unsigned int out) {
+  return turn.first < out;
+}
+}
+
+//
+//  TURN TABLE
+//
+
+Turn_Table::Turn_Table(Graph const &_graph, vector<Turn> const &_turns,
+                       float _u_turn_penalty)
+    : graph(_graph), u_turn_penalty(_u_turn_penalty),
+      arc_offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      tails(new unsigned int[_graph.get_nbr_arcs()]),
+      turn_offsets(new unsigned int[_graph.get_nbr_arcs() + 1]) {
+  assert(0 <= u_turn_penalty);
+  unsigned int nbr_arcs = 0;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    arc_offsets[i] = nbr_arcs;
+    for (size_t k = 0; k < graph.get_edges(i).size(); k++) {
+      tails[nbr_arcs++] = i;
+    }
+  }
+  arc_offsets[graph.nbr_vertices] = nbr_arcs;
+
+  // Turns between arcs, for all the parallel edges
+  vector<Arc_Turn> arc_turns;
+  for (size_t t = 0; t < _turns.size(); t++) {
+    Turn const &turn = _turns[t];
+    assert(turn.from < graph.nbr_vertices);
+    assert(turn.via < graph.nbr_vertices);
+    assert(turn.to < graph.nbr_vertices);
+    assert(0 <= turn.penalty);
+    Graph::VEdge const &in_edges = graph.get_edges(turn.from);
+    Graph::VEdge const &out_edges = graph.get_edges(turn.via);
+    bool is_found = false;
+    for (size_t k = 0; k < in_edges.size(); k++) {
+      for (size_t l = 0; l < out_edges.size(); l++) {
+        if (in_edges[k].first == turn.via && out_edges[l].first == turn.to) {
+          Arc_Turn const at = {get_arc(turn.from, k), get_arc(turn.via, l),
+                               turn.penalty};
+          arc_turns.push_back(at);
+          is_found = true;
+        }
+      }
+    }
+    assert(is_found);
+  }
+  sort(arc_turns.begin(), arc_turns.end());
+
+  // By in arc
+  size_t t = 0;
+  for (unsigned int a = 0; a < nbr_arcs; a++) {
+    turn_offsets[a] = turns.size();
+    for (; t < arc_turns.size() && arc_turns[t].in == a; t++) {
+      turns.push_back(make_pair(arc_turns[t].out, arc_turns[t].penalty));
+    }
+  }
+  turn_offsets[nbr_arcs] = turns.size();
+}
+
+Turn_Table::~Turn_Table() {
+  delete[] arc_offsets;
+  delete[] tails;
+  delete[] turn_offsets;
+}
+
+float Turn_Table::get_penalty(unsigned int in, unsigned int out) const {
+  assert(get_edge(in).first == get_tail(out));
+  if (turn_offsets[in] != turn_offsets[in + 1]) {
+    vector<pair<unsigned int, float> >::const_iterator const begin =
+        turns.begin() + turn_offsets[in];
+    vector<pair<unsigned int, float> >::const_iterator const end =
+        turns.begin() + turn_offsets[in + 1];
+    vector<pair<unsigned int, float> >::const_iterator const it =
+        lower_bound(begin, end, out, is_before);
+    if (it != end && it->first == out) {
+      return it->second;
+    }
+  }
+  return (get_edge(out).first == tails[in]) ? u_turn_penalty : 0;
+}
+
+//
+//  TURN DIJKSTRA
+//
+
+Turn_Dijkstra::Turn_Dijkstra(Turn_Table const &_table)
+    : table(_table), heap(_table.get_nbr_arcs()),
+      keys(new Dijkstra::Vertex_Key[_table.get_nbr_arcs()]),
+      parents(new unsigned int[_table.get_nbr_arcs()]),
+      heap_ids(new int[_table.get_nbr_arcs()]), source(0), is_found(false),
+      last_arc(_table.get_nbr_arcs()), nbr_treated(0), view(NULL) {
+  for (unsigned int a = 0; a < table.get_nbr_arcs(); a++) {
+    keys[a].distance = infinity;
+    keys[a].i = a;
+    parents[a] = a;
+    heap_ids[a] = id_undefined;
+  }
+}
+
+Turn_Dijkstra::~Turn_Dijkstra() {
+  delete[] keys;
+  delete[] parents;
+  delete[] heap_ids;
+}
+
+void Turn_Dijkstra::relax(unsigned int a, unsigned int b, float db) {
+  if (heap_ids[b] == id_undefined) {
+    keys[b].distance = db;
+    parents[b] = a;
+    heap_ids[b] = heap.push(keys[b]);
+    touched.push_back(b);
+  } else if (heap_ids[b] != id_treated && db < keys[b].distance) {
+    keys[b].distance = db;
+    parents[b] = a;
+    heap.reposition(heap_ids[b]);
+  }
+}
+
+float Turn_Dijkstra::shortest_distance(unsigned int from, unsigned int to) {
+  Graph const &graph = table.graph;
+  assert(from < graph.nbr_vertices);
+  assert(to < graph.nbr_vertices);
+  assert(view == NULL || (&view->graph == &graph && view->has_vertex(from)));
+  assert(!graph.has_negative_length());
+  for (size_t k = 0; k < touched.size(); k++) {
+    unsigned int const a = touched[k];
+    keys[a].distance = infinity;
+    parents[a] = a;
+    heap_ids[a] = id_undefined;
+  }
+  touched.clear();
+  heap.clear();
+  source = from;
+  is_found = (from == to);
+  last_arc = table.get_nbr_arcs();
+  nbr_treated = 0;
+  if (is_found) {
+    return 0;
+  }
+  if (!graph.is_connected(from, to)) {
+    return infinity;
+  }
+
+  // The arcs leaving the source come from nowhere: their own parents
+  Graph::VEdge const &edges = graph.get_edges(from);
+  for (size_t k = 0; k < edges.size(); k++) {
+    unsigned int const a = table.get_arc(from, k);
+    if (!Graph::is_removed(edges[k]) &&
+        (view == NULL || view->has_arc(from, k, edges[k].first))) {
+      relax(a, a, edges[k].second);
+    }
+  }
+  while (!heap.is_empty()) {
+    unsigned int const a = heap.pop().i;
+    heap_ids[a] = id_treated;
+    nbr_treated++;
+    float const da = keys[a].distance;
+    unsigned int const v = table.get_edge(a).first;
+    if (v == to) {
+      is_found = true;
+      last_arc = a;
+      return da;
+    }
+    Graph::VEdge const &out_edges = graph.get_edges(v);
+    for (size_t k = 0; k < out_edges.size(); k++) {
+      unsigned int const b = table.get_arc(v, k);
+      float const penalty = table.get_penalty(a, b);
+      if (penalty < infinity && !Graph::is_removed(out_edges[k]) &&
+          (view == NULL || view->has_arc(v, k, out_edges[k].first))) {
+        relax(a, b, da + penalty + out_edges[k].second);
+      }
+    }
+  }
+  return infinity;
+}
+
+bool Turn_Dijkstra::get_path(vector<unsigned int> &path) const {
+  path.clear();
+  if (!is_found) {
+    return false;
+  }
+  if (last_arc < table.get_nbr_arcs()) {
+    unsigned int a = last_arc;
+    path.push_back(table.get_edge(a).first);
+    while (parents[a] != a) {
+      a = parents[a];
+      path.push_back(table.get_edge(a).first);
+    }
+  }
+  path.push_back(source);
+  reverse(path.begin(), path.end());
+  return true;
+}
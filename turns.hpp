@@ -0,0 +1,236 @@
+#ifndef __TURNS_HPP_
+#define __TURNS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides edge-based shortest paths on Graph, with turn
+ * restrictions and turn costs.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <vector>
+
+#include "dijkstra.hpp"
+#include "graph.hpp"
+#include "heap_id.hpp"
+
+class Graph_View;
+
+/*!
+ * \brief Turn costs of a Graph: a penalty for going from an arc (in) to a
+ * following arc (out), infinity for a forbidden turn.
+ *
+ * The arcs are the edges of the graph in one direction: the arc number \c k
+ * of vertex \c i is its edge \c k in Graph::get_edges(i). Turns not in the
+ * table cost nothing, except U-turns (going back to the tail of the in arc)
+ * which cost u_turn_penalty.
+ *
+ * Implementation: the turns are sorted by in arc then out arc, with the
+ * position of the turns of each in arc, so that a penalty is found by a
+ * binary search among the few turns of its in arc.
+ */
+class Turn_Table {
+
+public:
+  /*! A turn from \c from to \c to through \c via, as given by the user. */
+  class Turn {
+  public:
+    /*! Tail of the in arc. */
+    unsigned int from;
+    /*! Head of the in arc and tail of the out arc. */
+    unsigned int via;
+    /*! Head of the out arc. */
+    unsigned int to;
+    /*! Cost of the turn, infinity if forbidden. */
+    float penalty;
+  };
+
+  /*! The graph of the turns. */
+  Graph const &graph;
+
+  /*! Cost of the U-turns, infinity if forbidden. */
+  float const u_turn_penalty;
+
+private:
+  /*! Array of the first arc of each vertex, plus the end. */
+  unsigned int *const arc_offsets;
+
+  /*! Array of the tail of each arc. */
+  unsigned int *const tails;
+
+  /*! Array of the position of the turns of each in arc, plus the end. */
+  unsigned int *const turn_offsets;
+
+  /*! Out arcs and penalties of the turns, by in arc then out arc. */
+  std::vector<std::pair<unsigned int, float> > turns;
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build the table of a graph.
+   * \param _graph graph, it must not be destroyed before the table, nor get
+   * new edges.
+   * \param _turns turns with a cost. A turn applies to every parallel edge
+   * of its arcs.
+   * \param _u_turn_penalty cost of the U-turns.
+   * \pre the vertices of the turns are legal and are the ends of edges.
+   */
+  Turn_Table(Graph const &_graph, std::vector<Turn> const &_turns,
+             float _u_turn_penalty = 0);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Turn_Table();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*! \return the number of arcs. */
+  unsigned int get_nbr_arcs() const {
+    return arc_offsets[graph.nbr_vertices];
+  }
+
+  /*!
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \return the number of the arc.
+   */
+  unsigned int get_arc(unsigned int i, size_t k) const {
+    assert(i < graph.nbr_vertices);
+    assert(arc_offsets[i] + k < arc_offsets[i + 1]);
+    return arc_offsets[i] + k;
+  }
+
+  /*! \return the tail of arc \c a. */
+  unsigned int get_tail(unsigned int a) const {
+    assert(a < get_nbr_arcs());
+    return tails[a];
+  }
+
+  /*! \return the edge of arc \c a (head and length). */
+  Graph::Edge const &get_edge(unsigned int a) const {
+    assert(a < get_nbr_arcs());
+    return graph.get_edges(tails[a])[a - arc_offsets[tails[a]]];
+  }
+
+  /*!
+   * Cost of a turn.
+   * \param in,out arcs, the head of \c in being the tail of \c out.
+   * \return the cost of going from \c in to \c out, infinity if forbidden.
+   */
+  float get_penalty(unsigned int in, unsigned int out) const;
+};
+
+/*!
+ * \brief Search workspace for edge-based Dijkstra's algorithm on a Graph
+ * with a Turn_Table.
+ *
+ * The states of the search are the arcs (the last one followed), so that
+ * each step knows the turn it takes. They are not materialised as a line
+ * graph: the successors of an arc are read from the edges of its head.
+ */
+class Turn_Dijkstra {
+
+public:
+  /*! The turns (and graph) searched. */
+  Turn_Table const &table;
+
+private:
+  /*! Heap of the reached but not treated arcs. */
+  Heap_Id<Dijkstra::Vertex_Key> heap;
+
+  /*! Array of the keys (distance at the head), indexed by arc number. */
+  Dijkstra::Vertex_Key *const keys;
+
+  /*! Array of the arcs to come from, indexed by arc number (itself for the
+   * arcs leaving the source). */
+  unsigned int *const parents;
+
+  /*! Array of the heap ids of the arcs, or id_undefined / id_treated. */
+  int *const heap_ids;
+
+  /*! Arcs modified by the last query (to reset them). */
+  std::vector<unsigned int> touched;
+
+  /*! Source of the last query. */
+  unsigned int source;
+
+  /*! Whether the target of the last query was reached. */
+  bool is_found;
+
+  /*! Arc reaching the target of the last query, the number of arcs if none
+   * (or if the target is the source). */
+  unsigned int last_arc;
+
+  /*! Number of arcs treated by the last query. */
+  unsigned int nbr_treated;
+
+  /*! View of the queries (NULL if none). */
+  Graph_View const *view;
+
+  /*! Reach arc \c b at distance \c db from arc \c a. */
+  void relax(unsigned int a, unsigned int b, float db);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a workspace to search \c _table.
+   * \param _table turns to search, they must not be destroyed before the
+   * workspace.
+   */
+  Turn_Dijkstra(Turn_Table const &_table);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Turn_Dijkstra();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Point-to-point query, with the costs of the turns.
+   * \param from,to endpoints of the path to search.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \pre the graph has no negative length.
+   * \return the distance from \c from to \c to (infinity if unreachable).
+   */
+  float shortest_distance(unsigned int from, unsigned int to);
+
+  /*!
+   * Path found by the last query.
+   * \param path filled with the vertices of the path, from the source to
+   * the target (a vertex may appear twice, e.g. around a forbidden turn).
+   * \return false (and leave \c path empty) iff the target was not reached.
+   */
+  bool get_path(std::vector<unsigned int> &path) const;
+
+  /*!
+   * Set the view used by the next queries: only the edges of the view whose
+   * head is in the view are followed (see Graph_View).
+   * \param _view view of the graph searched, which must outlive its use, or
+   * \c NULL for none.
+   * \pre the sources of the queries are in the view.
+   */
+  void set_view(Graph_View const *_view) { view = _view; }
+
+  /*! \return the number of arcs treated by the last query. */
+  unsigned int get_nbr_treated() const { return nbr_treated; }
+};
+
+#endif
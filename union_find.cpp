@@ -0,0 +1,77 @@
+/*!
+ * \file
+ * \brief This module provides a union-find (disjoint sets) structure over
+ * integers.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "union_find.hpp"
+
+Union_Find::Union_Find(unsigned int _size)
+    : size(_size), fathers(new unsigned int[_size]),
+      sizes(new unsigned int[_size]), nbr_sets(_size) {
+  for (unsigned int i = 0; i < size; i++) {
+    fathers[i] = i;
+    sizes[i] = 1;
+  }
+}
+
+Union_Find::Union_Find(Union_Find const &uf)
+    : size(uf.size), fathers(new unsigned int[uf.size]),
+      sizes(new unsigned int[uf.size]), nbr_sets(uf.nbr_sets) {
+  for (unsigned int i = 0; i < size; i++) {
+    fathers[i] = uf.fathers[i];
+    sizes[i] = uf.sizes[i];
+  }
+}
+
+Union_Find::~Union_Find() {
+  delete[] fathers;
+  delete[] sizes;
+}
+
+void Union_Find::clear() {
+  for (unsigned int i = 0; i < size; i++) {
+    fathers[i] = i;
+    sizes[i] = 1;
+  }
+  nbr_sets = size;
+}
+
+unsigned int Union_Find::find(unsigned int i) const {
+  assert(i < size);
+  while (fathers[i] != i) {
+    i = fathers[i];
+  }
+  return i;
+}
+
+unsigned int Union_Find::find_and_halve(unsigned int i) {
+  assert(i < size);
+  // Path halving: every other node is hooked to its grand father
+  while (fathers[i] != i) {
+    fathers[i] = fathers[fathers[i]];
+    i = fathers[i];
+  }
+  return i;
+}
+
+bool Union_Find::unite(unsigned int i, unsigned int j) {
+  unsigned int root_i = find_and_halve(i);
+  unsigned int root_j = find_and_halve(j);
+  if (root_i == root_j) {
+    return false;
+  }
+  // Hook the smaller tree under the larger one
+  if (sizes[root_i] < sizes[root_j]) {
+    unsigned int const buffer = root_i;
+    root_i = root_j;
+    root_j = buffer;
+  }
+  fathers[root_j] = root_i;
+  sizes[root_i] += sizes[root_j];
+  nbr_sets--;
+  return true;
+}
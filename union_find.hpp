@@ -0,0 +1,113 @@
+#ifndef __UNION_FIND_HPP_
+#define __UNION_FIND_HPP_
+
+/*!
+ * \file
+ * \brief This module provides a union-find (disjoint sets) structure over
+ * integers.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#undef NDEBUG
+#include <assert.h>
+
+/*!
+ * \brief Partition of the integers 0 to \c size -1 into disjoint sets.
+ *
+ * Each set is identified by one of its elements: its representative.
+ *
+ * Implementation:
+ * \li a forest, the roots being the representatives,
+ * \li union by size (trees of logarithmic height), and path halving in
+ * unite only: the const methods never write, so that they may be called
+ * concurrently (e.g. on a published Graph_Versions snapshot).
+ */
+class Union_Find {
+
+public:
+  /*! Number of elements. */
+  unsigned int const size;
+
+private:
+  /*! Array of the fathers in the forest (roots are their own father). */
+  unsigned int *const fathers;
+
+  /*! Array of the sizes of the trees (only meaningful for roots). */
+  unsigned int *const sizes;
+
+  /*! Number of sets. */
+  unsigned int nbr_sets;
+
+  /*!
+   * Find the representative of the set of an element, hooking every other
+   * node of the path to its grand father (path halving).
+   * \param i element.
+   * \pre \c i is a legal element.
+   * \return the representative of the set of \c i.
+   */
+  unsigned int find_and_halve(unsigned int i);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build the partition into singletons.
+   * \param _size number of elements.
+   */
+  Union_Find(unsigned int _size);
+
+  /*!
+   * Build a copy of a partition.
+   * \param uf partition to copy.
+   */
+  Union_Find(Union_Find const &uf);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Union_Find();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To find the representative of the set of an element, without changing
+   * the forest.
+   * \param i element.
+   * \pre \c i is a legal element.
+   * \return the representative of the set of \c i.
+   */
+  unsigned int find(unsigned int i) const;
+
+  /*!
+   * Merge the sets of two elements.
+   * \param i,j elements.
+   * \pre \c i and \c j are legal elements.
+   * \return true iff the sets were different.
+   */
+  bool unite(unsigned int i, unsigned int j);
+
+  /*!
+   * To test if two elements are in the same set.
+   * \param i,j elements.
+   * \pre \c i and \c j are legal elements.
+   */
+  bool is_same_set(unsigned int i, unsigned int j) const {
+    return find(i) == find(j);
+  }
+
+  /*! Split the partition back into singletons. */
+  void clear();
+
+  /*! \return the number of sets. */
+  unsigned int get_nbr_sets() const { return nbr_sets; }
+};
+
+#endif
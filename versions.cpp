@@ -0,0 +1,172 @@
+/*!
+ * \file
+ * \brief This module provides versions of a Graph that can be updated while
+ * queries run on them.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include <limits>
+
+#include "versions.hpp"
+
+using namespace std;
+
+//
+//  CONSTRUCTOR
+//
+
+Graph_Versions::Graph_Versions(Graph *graph)
+    : current(new Version(graph, 1)), epoch(1), writer_lock(0),
+      retired(NULL), nbr_retired(0), update(NULL) {
+  assert(graph != NULL);
+  for (unsigned int k = 0; k < max_readers; k++) {
+    reader_epochs[k] = 0;
+    is_reader[k] = 0;
+  }
+  __sync_synchronize();
+}
+
+//
+//  DESTRUCTOR
+//
+
+Graph_Versions::~Graph_Versions() {
+  assert(update == NULL);
+  for (unsigned int k = 0; k < max_readers; k++) {
+    assert(reader_epochs[k] == 0);
+  }
+  while (retired != NULL) {
+    Version *const next = retired->next_retired;
+    delete retired;
+    retired = next;
+  }
+  delete current;
+}
+
+//
+//  PRIVATE METHODS
+//
+
+void Graph_Versions::lock() {
+  while (__sync_lock_test_and_set(&writer_lock, 1) != 0) {
+    // Updates are rare and short: spin
+  }
+}
+
+void Graph_Versions::unlock() { __sync_lock_release(&writer_lock); }
+
+unsigned int Graph_Versions::reclaim_locked() {
+  // The epoch was raised before the announcements are read (all the accesses
+  // shared with the readers are sequentially consistent)
+  unsigned long oldest = numeric_limits<unsigned long>::max();
+  for (unsigned int k = 0; k < max_readers; k++) {
+    unsigned long const e =
+        __atomic_load_n(&reader_epochs[k], __ATOMIC_SEQ_CST);
+    if (e != 0 && e < oldest) {
+      oldest = e;
+    }
+  }
+  unsigned int nbr_deleted = 0;
+  Version **link = &retired;
+  while (*link != NULL) {
+    Version *const v = *link;
+    if (v->number < oldest) {
+      *link = v->next_retired;
+      delete v;
+      nbr_deleted++;
+    } else {
+      link = &v->next_retired;
+    }
+  }
+  __atomic_fetch_sub(&nbr_retired, nbr_deleted, __ATOMIC_SEQ_CST);
+  return nbr_deleted;
+}
+
+//
+//  READERS
+//
+
+unsigned int Graph_Versions::add_reader() {
+  for (unsigned int k = 0; k < max_readers; k++) {
+    if (__sync_bool_compare_and_swap(&is_reader[k], 0, 1)) {
+      return k;
+    }
+  }
+  assert(false);
+  return max_readers;
+}
+
+void Graph_Versions::remove_reader(unsigned int reader) {
+  assert(reader < max_readers);
+  assert(__atomic_load_n(&is_reader[reader], __ATOMIC_SEQ_CST) != 0);
+  assert(__atomic_load_n(&reader_epochs[reader], __ATOMIC_SEQ_CST) == 0);
+  __atomic_store_n(&is_reader[reader], 0, __ATOMIC_SEQ_CST);
+}
+
+Graph_Versions::Version const &Graph_Versions::pin(unsigned int reader) {
+  assert(reader < max_readers);
+  assert(__atomic_load_n(&is_reader[reader], __ATOMIC_SEQ_CST) != 0);
+  assert(__atomic_load_n(&reader_epochs[reader], __ATOMIC_SEQ_CST) == 0);
+  // Announce before reading the current version: either a writer reclaiming
+  // sees the announcement, or this reader sees the version it published
+  unsigned long const e = __atomic_load_n(&epoch, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&reader_epochs[reader], e, __ATOMIC_SEQ_CST);
+  Version const *const v = __atomic_load_n(&current, __ATOMIC_SEQ_CST);
+  assert(e <= v->number);
+  return *v;
+}
+
+void Graph_Versions::unpin(unsigned int reader) {
+  assert(reader < max_readers);
+  assert(__atomic_load_n(&reader_epochs[reader], __ATOMIC_SEQ_CST) != 0);
+  // The reads of the version are over before the announcement is withdrawn
+  __atomic_store_n(&reader_epochs[reader], 0, __ATOMIC_SEQ_CST);
+}
+
+//
+//  WRITER
+//
+
+Graph *Graph_Versions::begin_update() {
+  lock();
+  assert(update == NULL);
+  update = new Graph(*current->graph);
+  return update;
+}
+
+unsigned long Graph_Versions::publish(Graph *graph) {
+  assert(graph != NULL);
+  assert(graph == update);
+  Version *const old = current;
+  Version *const v = new Version(graph, old->number + 1);
+  update = NULL;
+  // The new graph is complete before it is made current, and it is current
+  // before the epoch is raised
+  __atomic_store_n(&current, v, __ATOMIC_SEQ_CST);
+  __atomic_fetch_add(&epoch, 1, __ATOMIC_SEQ_CST);
+  old->next_retired = retired;
+  retired = old;
+  __atomic_fetch_add(&nbr_retired, 1, __ATOMIC_SEQ_CST);
+  reclaim_locked();
+  // Once the lock is released, another writer may replace and delete v
+  unsigned long const number = v->number;
+  unlock();
+  return number;
+}
+
+void Graph_Versions::abort_update(Graph *graph) {
+  assert(graph != NULL);
+  assert(graph == update);
+  delete update;
+  update = NULL;
+  unlock();
+}
+
+unsigned int Graph_Versions::reclaim() {
+  lock();
+  unsigned int const nbr_deleted = reclaim_locked();
+  unlock();
+  return nbr_deleted;
+}
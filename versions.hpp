@@ -0,0 +1,218 @@
+#ifndef __VERSIONS_HPP_
+#define __VERSIONS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides versions of a Graph that can be updated while
+ * queries run on them: readers search immutable snapshots, without locks.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "graph.hpp"
+
+/*!
+ * \brief Successive immutable versions of a Graph (read-copy-update).
+ *
+ * A reader (one per thread, numbered by a slot) pins the current version,
+ * searches it as long as it likes, then unpins it. Pinning and unpinning
+ * cost a few atomic accesses and never wait. The versions are only read:
+ * the const methods of Graph (and of its Union_Find) never write, so any
+ * number of readers may search the same version.
+ *
+ * A writer copies the current version (begin_update), changes the copy (add
+ * edges, change lengths) then publishes it: new pins get the new version at
+ * once, while the readers already pinned carry on with the old one. Writers
+ * are serialized by a spin lock held from begin_update to publish.
+ *
+ * Each update copies the whole graph: its cost is linear in the size of
+ * the graph, whatever the number of edges changed, and each version still
+ * pinned keeps its own copy alive. Readers never wait for it, so their
+ * throughput only suffers from the CPU time the writer takes; batch the
+ * changes into few updates on large graphs (bench_versions measures both).
+ *
+ * Each pin announces the global epoch, which is the number of the current
+ * version. Version \c n is replaced at epoch \c n, and only deleted once
+ * every reader pinned has announced a later epoch: as the epoch is raised
+ * after the new version is made current, such readers cannot hold it.
+ *
+ * The search workspaces (Dijkstra…) are built on a Graph: a reader builds
+ * new ones when the number of the version it pins changes.
+ *
+ * Only GCC atomic builtins are used (sequentially consistent accesses to the
+ * words shared with the readers); the type is thread agnostic.
+ */
+class Graph_Versions {
+
+public:
+  /*! Maximal number of readers registered at once. */
+  static unsigned int const max_readers = 64;
+
+  /*!
+   * \brief A published version: its graph must not be changed.
+   */
+  class Version {
+    friend class Graph_Versions;
+
+  public:
+    /*! The graph. */
+    Graph const *const graph;
+
+    /*! Number of the version, from 1, increasing with each publication. */
+    unsigned long const number;
+
+  private:
+    /*! Next version in the list of the replaced ones. */
+    Version *next_retired;
+
+    /*! Build a current version (taking \c _graph over). */
+    Version(Graph const *_graph, unsigned long _number)
+        : graph(_graph), number(_number), next_retired(NULL) {}
+
+    /*! Release the graph. */
+    ~Version() { delete graph; }
+  };
+
+private:
+  /*! Current version. */
+  Version *volatile current;
+
+  /*! Global epoch: the number of the current version, once published. */
+  volatile unsigned long epoch;
+
+  /*! Epoch announced by each reader while it pins a version, 0 if none. */
+  volatile unsigned long reader_epochs[max_readers];
+
+  /*! Whether each reader slot is taken. */
+  volatile int is_reader[max_readers];
+
+  /*! Writer lock, 1 when taken. */
+  volatile int writer_lock;
+
+  /*! Versions replaced but maybe still pinned (protected by the lock). */
+  Version *retired;
+
+  /*! Number of versions in \c retired (changed under the lock, read by any). */
+  volatile unsigned int nbr_retired;
+
+  /*! Copy of the current version being changed by the writer, if any. */
+  Graph *update;
+
+  /*! Take the writer lock (spinning). */
+  void lock();
+
+  /*! Release the writer lock. */
+  void unlock();
+
+  /*!
+   * Delete the replaced versions that no reader can hold any more.
+   * \pre the writer lock is taken.
+   * \return the number of versions deleted.
+   */
+  unsigned int reclaim_locked();
+
+  /*! Not copyable. */
+  Graph_Versions(Graph_Versions const &);
+
+  /*! Not assignable. */
+  Graph_Versions &operator=(Graph_Versions const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Publish a first version.
+   * \param graph graph of version 1, newly allocated: it is taken over.
+   */
+  Graph_Versions(Graph *graph);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*!
+   * Release all the versions.
+   * \pre no reader pins a version and no update is running.
+   */
+  ~Graph_Versions();
+
+  //
+  //  READERS
+  //
+
+  /*!
+   * Register a reader.
+   * \pre less than \c max_readers readers are registered.
+   * \return the slot of the reader.
+   */
+  unsigned int add_reader();
+
+  /*!
+   * Unregister a reader.
+   * \param reader slot of the reader.
+   * \pre the reader does not pin a version.
+   */
+  void remove_reader(unsigned int reader);
+
+  /*!
+   * Pin the current version: it is not deleted till unpin.
+   * \param reader slot of the reader.
+   * \pre the reader is registered and does not pin a version.
+   * \return the version pinned.
+   */
+  Version const &pin(unsigned int reader);
+
+  /*!
+   * Unpin the version pinned by a reader.
+   * \param reader slot of the reader.
+   * \pre the reader pins a version.
+   */
+  void unpin(unsigned int reader);
+
+  //
+  //  WRITER
+  //
+
+  /*!
+   * Start an update: take the writer lock and copy the current version.
+   * \return the copy, to be changed then given to publish or abort_update.
+   */
+  Graph *begin_update();
+
+  /*!
+   * Publish the update as the current version, release the writer lock, and
+   * delete the replaced versions no reader holds.
+   * \param graph the graph returned by begin_update.
+   * \return the number of the new version.
+   */
+  unsigned long publish(Graph *graph);
+
+  /*!
+   * Give up the update (it is deleted) and release the writer lock.
+   * \param graph the graph returned by begin_update.
+   */
+  void abort_update(Graph *graph);
+
+  /*!
+   * Delete the replaced versions that no reader can hold any more (publish
+   * already does it, this is for readers who unpinned since). It waits for
+   * the running update, if any.
+   * \return the number of versions deleted.
+   */
+  unsigned int reclaim();
+
+  /*! \return the number of the current version. */
+  unsigned long get_version_number() const {
+    return __atomic_load_n(&epoch, __ATOMIC_SEQ_CST);
+  }
+
+  /*! \return the number of replaced versions not deleted yet. */
+  unsigned int get_nbr_retired() const {
+    return __atomic_load_n(&nbr_retired, __ATOMIC_SEQ_CST);
+  }
+};
+
+#endif
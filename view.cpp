@@ -0,0 +1,54 @@
+/*!
+ * \file
+ * \brief This module provides views of a Graph restricted to some vertices
+ * and edges.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "view.hpp"
+
+Graph_View::Graph_View(Graph const &_graph, bool is_all_in)
+    : graph(_graph), offsets(new unsigned int[_graph.nbr_vertices + 1]),
+      vertex_bits(new unsigned int[_graph.nbr_vertices / word_bits + 1]),
+      edge_bits(new unsigned int[_graph.get_nbr_arcs() / word_bits + 1]),
+      nbr_vertices_in(is_all_in ? _graph.nbr_vertices : 0) {
+  unsigned int position = 0;
+  for (unsigned int i = 0; i < graph.nbr_vertices; i++) {
+    offsets[i] = position;
+    position += graph.get_edges(i).size();
+  }
+  offsets[graph.nbr_vertices] = position;
+  unsigned int const all = ~0u;
+  for (unsigned int w = 0; w <= graph.nbr_vertices / word_bits; w++) {
+    vertex_bits[w] = is_all_in ? all : 0;
+  }
+  for (unsigned int w = 0; w <= position / word_bits; w++) {
+    edge_bits[w] = all;
+  }
+}
+
+Graph_View::~Graph_View() {
+  delete[] offsets;
+  delete[] vertex_bits;
+  delete[] edge_bits;
+}
+
+void Graph_View::set_vertex(unsigned int i, bool is_in) {
+  assert(i < graph.nbr_vertices);
+  if (has_vertex(i) != is_in) {
+    nbr_vertices_in += is_in ? 1 : -1;
+    set_bit(vertex_bits, i, is_in);
+  }
+}
+
+void Graph_View::set_edge(unsigned int i, size_t k, bool is_in) {
+  assert(i < graph.nbr_vertices);
+  assert(offsets[i] + k < offsets[i + 1]);
+  if (!graph.is_directed) {
+    unsigned int const j = graph.get_edges(i)[k].first;
+    set_bit(edge_bits, offsets[j] + graph.get_back(i, k), is_in);
+  }
+  set_bit(edge_bits, offsets[i] + k, is_in);
+}
@@ -0,0 +1,152 @@
+#ifndef __VIEW_HPP_
+#define __VIEW_HPP_
+
+/*!
+ * \file
+ * \brief This module provides views of a Graph restricted to some vertices
+ * and edges, to search a region without copying the subgraph.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+#include "graph.hpp"
+
+/*!
+ * \brief Subgraph of a Graph given by a bitmap of its vertices and a bitmap
+ * of its edges.
+ *
+ * A search with a view (set_view of Dijkstra, Bfs, Lane_Dijkstra,
+ * Bit_Parallel_Bfs, Turn_Dijkstra, Pareto_Search, Constrained_Search and
+ * Johnson) only follows the edges of the view whose head is in the view,
+ * testing both bits as it scans the edges: no subgraph is built. Betweenness,
+ * Closeness and Diameter pass their view to the searches of every worker.
+ *
+ * Implementation: the edge bits are a column along the edges of the graph,
+ * vertex by vertex in the order of Graph::get_edges (as the weights of a
+ * Profile).
+ */
+class Graph_View {
+
+public:
+  /*! The graph of the view. */
+  Graph const &graph;
+
+private:
+  /*! Array of the position of the edge bits of each vertex, plus the end. */
+  unsigned int *const offsets;
+
+  /*! Bitmap of the vertices in the view. */
+  unsigned int *const vertex_bits;
+
+  /*! Bitmap of the edges in the view, vertex by vertex. */
+  unsigned int *const edge_bits;
+
+  /*! Number of vertices in the view. */
+  unsigned int nbr_vertices_in;
+
+  /*! Number of bits in a word of the bitmaps. */
+  static unsigned int const word_bits = 32;
+
+  /*! \return bit \c b of \c bits. */
+  static bool get_bit(unsigned int const *bits, unsigned int b) {
+    return (bits[b / word_bits] >> (b % word_bits)) & 1u;
+  }
+
+  /*! Set bit \c b of \c bits to \c value. */
+  static void set_bit(unsigned int *bits, unsigned int b, bool value) {
+    if (value) {
+      bits[b / word_bits] |= 1u << (b % word_bits);
+    } else {
+      bits[b / word_bits] &= ~(1u << (b % word_bits));
+    }
+  }
+
+  /*! Not copyable. */
+  Graph_View(Graph_View const &);
+
+  /*! Not assignable. */
+  Graph_View &operator=(Graph_View const &);
+
+public:
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build a view with all or none of the graph.
+   * \param _graph graph, it must not be destroyed before the view, nor get
+   * new edges (nor be compacted).
+   * \param is_all_in whether the vertices and edges are all in the view
+   * (otherwise, the edges are in but the vertices are not).
+   */
+  Graph_View(Graph const &_graph, bool is_all_in = true);
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Graph_View();
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * Put a vertex in the view, or out of it.
+   * \param i vertex number.
+   * \param is_in whether \c i is in the view.
+   * \pre \c i is a legal vertex number.
+   */
+  void set_vertex(unsigned int i, bool is_in);
+
+  /*!
+   * Put an edge in the view, or out of it. For an undirected graph, the edge
+   * back is set too.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param is_in whether the edge is in the view.
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   */
+  void set_edge(unsigned int i, size_t k, bool is_in);
+
+  /*!
+   * To know if a vertex is in the view.
+   * \param i vertex number.
+   * \pre \c i is a legal vertex number.
+   */
+  bool has_vertex(unsigned int i) const {
+    assert(i < graph.nbr_vertices);
+    return get_bit(vertex_bits, i);
+  }
+
+  /*!
+   * To know if an edge is in the view (whatever its endpoints).
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   */
+  bool has_edge(unsigned int i, size_t k) const {
+    assert(i < graph.nbr_vertices);
+    assert(offsets[i] + k < offsets[i + 1]);
+    return get_bit(edge_bits, offsets[i] + k);
+  }
+
+  /*!
+   * To know if a search may follow an edge: the edge and its head are in
+   * the view.
+   * \param i vertex number.
+   * \param k position of the edge in get_edges(i).
+   * \param j head of the edge.
+   * \pre \c i is a legal vertex number, \c k a legal position.
+   */
+  bool has_arc(unsigned int i, size_t k, unsigned int j) const {
+    return get_bit(edge_bits, offsets[i] + k) && get_bit(vertex_bits, j);
+  }
+
+  /*! \return the number of vertices in the view. */
+  unsigned int get_nbr_vertices() const { return nbr_vertices_in; }
+};
+
+#endif